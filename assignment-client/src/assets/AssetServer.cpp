@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -109,6 +110,12 @@ BakeVersion currentBakeVersionForAssetType(BakedAssetType type) {
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+// bakes of the assets clients are waiting for go ahead of the others in the baking task pool
+static const int DEFAULT_BAKE_PRIORITY = 0;
+static const int REQUESTED_BAKE_PRIORITY = 1;
+
+static const int RECORD_REQUESTED_BAKES_DELAY_MS = 1000;
+
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
@@ -121,12 +128,61 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        // assets that were requested before a restart still go first
+        bool loaded;
+        AssetMeta meta;
+        std::tie(loaded, meta) = readMetaFile(assetHash);
+
+        int priority = DEFAULT_BAKE_PRIORITY;
+        if (loaded && meta.wasRequested) {
+            _requestedBakes.insert(assetHash);
+            priority = REQUESTED_BAKE_PRIORITY;
+        }
+
+        _bakingTaskPool.start(task.get(), priority);
     } else {
         qDebug() << "Already in queue";
     }
 }
 
+void AssetServer::prioritizeBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end() || _requestedBakes.contains(assetHash)) {
+        return;
+    }
+
+    qDebug() << "Prioritizing bake for requested asset:" << assetHash;
+    _requestedBakes.insert(assetHash);
+
+    // queue the bake again with a higher priority, unless it already started
+    if (_bakingTaskPool.tryTake(it->get())) {
+        _bakingTaskPool.start(it->get(), REQUESTED_BAKE_PRIORITY);
+    }
+
+    // remember it in the meta file so that it is still baked first after a restart, but not from the packet
+    // handler: the meta files of the bakes requested meanwhile are written together a little later
+    if (_requestedBakesToRecord.isEmpty()) {
+        QTimer::singleShot(RECORD_REQUESTED_BAKES_DELAY_MS, this, &AssetServer::recordRequestedBakes);
+    }
+    _requestedBakesToRecord.insert(assetHash);
+}
+
+void AssetServer::recordRequestedBakes() {
+    for (const auto& assetHash : _requestedBakesToRecord) {
+        // a bake done meanwhile already updated its meta file
+        if (!_requestedBakes.contains(assetHash)) {
+            continue;
+        }
+
+        bool loaded;
+        AssetMeta meta;
+        std::tie(loaded, meta) = readMetaFile(assetHash);
+        meta.wasRequested = true;
+        writeMetaFile(assetHash, meta);
+    }
+    _requestedBakesToRecord.clear();
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -255,6 +311,28 @@ bool AssetServer::needsToBeBaked(const AssetUtils::AssetPath& path, const AssetU
     return !bakedMappingExists || (meta.bakeVersion < currentVersion);
 }
 
+bool interfaceRunning();
+
+// Each bake runs an oven process, so allow as many at once as the cores and the available memory can take
+static int maxConcurrentBakes() {
+    static const int MIN_CONCURRENT_BAKES = 1;
+    static const uint64_t MEMORY_PER_BAKE_BYTES = 1024 * 1024 * 1024;
+
+    if (interfaceRunning()) {
+        // leave the machine to the user
+        return MIN_CONCURRENT_BAKES;
+    }
+
+    int concurrentBakes = std::max((int)std::thread::hardware_concurrency() / 2, MIN_CONCURRENT_BAKES);
+
+    MemoryInfo memoryInfo;
+    if (getMemoryInfo(memoryInfo)) {
+        int bakesInMemory = (int)(memoryInfo.availMemoryBytes / MEMORY_PER_BAKE_BYTES);
+        concurrentBakes = std::max(std::min(concurrentBakes, bakesInMemory), MIN_CONCURRENT_BAKES);
+    }
+    return concurrentBakes;
+}
+
 bool interfaceRunning() {
     bool result = false;
 
@@ -299,7 +377,8 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+    _bakingTaskPool.setMaxThreadCount(maxConcurrentBakes());
+    qCDebug(asset_server) << "Baking up to" << _bakingTaskPool.maxThreadCount() << "assets at once";
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -308,8 +387,15 @@ AssetServer::AssetServer(ReceivedMessage& message) :
 #ifdef Q_OS_WIN
     updateConsumedCores();
     QTimer* timer = new QTimer(this);
-    auto timerConnection = connect(timer, &QTimer::timeout, [] {
+    auto timerConnection = connect(timer, &QTimer::timeout, [this] {
         updateConsumedCores();
+
+        // bake less while interface is running, and more again once it quits
+        int concurrentBakes = maxConcurrentBakes();
+        if (concurrentBakes != _bakingTaskPool.maxThreadCount()) {
+            _bakingTaskPool.setMaxThreadCount(concurrentBakes);
+            qCDebug(asset_server) << "Baking up to" << concurrentBakes << "assets at once";
+        }
     });
     connect(qApp, &QCoreApplication::aboutToQuit, [this, timerConnection] {
         disconnect(timerConnection);
@@ -325,6 +411,9 @@ void AssetServer::aboutToFinish() {
     // remove pending transfer tasks
     _transferTaskPool.clear();
 
+    // the bakes clients asked for still go first after a restart
+    recordRequestedBakes();
+
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
     auto it = _pendingBakes.begin();
     while (it != _pendingBakes.end()) {
@@ -418,6 +507,7 @@ void AssetServer::completeSetup() {
         setFinished(true);
         return;
     }
+    _fileCache.setFilesDirectory(_filesDirectory);
 
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
@@ -453,6 +543,13 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the cache of recently requested assets
+    static const QString ASSETS_CACHE_SIZE_OPTION = "assets_cache_size";
+    static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    static const int DEFAULT_ASSETS_CACHE_SIZE_MB = AssetFileCache::DEFAULT_MAX_SIZE / BYTES_PER_MEGABYTE;
+    auto assetsCacheSizeMB = assetServerObject[ASSETS_CACHE_SIZE_OPTION].toInt(DEFAULT_ASSETS_CACHE_SIZE_MB);
+    _fileCache.setMaxSize(std::max(assetsCacheSizeMB, 0) * BYTES_PER_MEGABYTE);
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -531,6 +628,7 @@ void AssetServer::cleanupUnmappedFiles() {
             }
             if (!matched) {
                 // remove the unmapped file
+                _fileCache.removeFile(filename);
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -663,6 +761,7 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
                 }
             } else {
                 qDebug() << "Did not find baked version for: " << originalAssetHash << assetPath;
+                prioritizeBake(originalAssetHash);
             }
         }
 
@@ -871,8 +970,14 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
         return;
     }
 
+    // a client is getting the original of an asset still waiting to be baked, hurry it up
+    if (!_pendingBakes.isEmpty()) {
+        auto assetHash = message->getMessage().mid(sizeof(MessageID), AssetUtils::SHA256_HASH_LENGTH).toHex();
+        prioritizeBake(assetHash);
+    }
+
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _fileCache);
     _transferTaskPool.start(task);
 }
 
@@ -931,7 +1036,7 @@ void AssetServer::sendStatsPacket() {
         QJsonObject connectionStats;
         connectionStats["1. Last Heard"] = date.toString();
         connectionStats["2. Est. Max (P/s)"] = stats.estimatedBandwith;
-        connectionStats["3. RTT (ms)"] = stats.rtt;
+        connectionStats["3. RTT (ms)"] = (float)stats.rtt / USECS_PER_MSEC;
         connectionStats["4. CW (P)"] = stats.congestionWindowSize;
         connectionStats["5. Period (us)"] = stats.packetSendPeriod;
         connectionStats["6. Up (Mb/s)"] = stats.sentBytes * megabitsPerSecPerByte;
@@ -1175,6 +1280,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
+            _fileCache.removeFile(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
@@ -1319,10 +1425,12 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
     meta.failedLastBake = true;
     meta.lastBakeErrors = errors;
     meta.bakeVersion = currentTypeVersion;
+    meta.wasRequested = false;
 
     writeMetaFile(originalAssetHash, meta);
 
     _pendingBakes.remove(originalAssetHash);
+    _requestedBakes.remove(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1423,18 +1531,22 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
     writeMetaFile(originalAssetHash, meta);
 
     _pendingBakes.remove(originalAssetHash);
+    _requestedBakes.remove(originalAssetHash);
 }
 
 void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath) {
     qDebug() << "Aborted bake:" << originalAssetHash;
 
-    // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
+    // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes,
+    // the meta file keeps whether it was requested for when the bake starts over
     _pendingBakes.remove(originalAssetHash);
+    _requestedBakes.remove(originalAssetHash);
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
 static const QString FAILED_LAST_BAKE_KEY = "failed_last_bake";
 static const QString LAST_BAKE_ERRORS_KEY = "last_bake_errors";
+static const QString WAS_REQUESTED_KEY = "was_requested";
 
 std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash) {
     auto metaFilePath = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + hash + "/" + "meta.json";
@@ -1470,6 +1582,7 @@ std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash)
                 meta.bakeVersion = bakeVersion.toInt();
                 meta.failedLastBake = failedLastBake.toBool();
                 meta.lastBakeErrors = lastBakeErrors.toString();
+                meta.wasRequested = root[WAS_REQUESTED_KEY].toBool(false);
 
                 return { true, meta };
             } else {
@@ -1488,6 +1601,9 @@ bool AssetServer::writeMetaFile(AssetUtils::AssetHash originalAssetHash, const A
     metaFileObject[BAKE_VERSION_KEY] = (int)meta.bakeVersion;
     metaFileObject[FAILED_LAST_BAKE_KEY] = meta.failedLastBake;
     metaFileObject[LAST_BAKE_ERRORS_KEY] = meta.lastBakeErrors;
+    if (meta.wasRequested) {
+        metaFileObject[WAS_REQUESTED_KEY] = true;
+    }
 
     QJsonDocument metaFileDoc;
     metaFileDoc.setObject(metaFileObject);
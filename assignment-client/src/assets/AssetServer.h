@@ -13,11 +13,13 @@
 #define hifi_AssetServer_h
 
 #include <QtCore/QDir>
+#include <QtCore/QSet>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
 #include <ThreadedAssignment.h>
 
+#include "AssetFileCache.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -68,6 +70,7 @@ struct AssetMeta {
     BakeVersion bakeVersion { INITIAL_BAKE_VERSION };
     bool failedLastBake { false };
     QString lastBakeErrors;
+    bool wasRequested { false }; // clients asked for the asset before it was baked, bake it first
 };
 
 class BakeAssetTask;
@@ -138,6 +141,11 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Move the pending bake of an asset clients are asking for ahead of the others
+    void prioritizeBake(const AssetUtils::AssetHash& assetHash);
+    /// Mark the bakes prioritized since the last call as requested in their meta files
+    void recordRequestedBakes();
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir,
                              QVector<QString> bakedFilePaths);
@@ -156,10 +164,15 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Recently requested asset files, shared by the transfer tasks
+    AssetFileCache _fileCache;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
+    QSet<AssetUtils::AssetHash> _requestedBakes;
+    QSet<AssetUtils::AssetHash> _requestedBakesToRecord;
     QThreadPool _bakingTaskPool;
 
     QMutex _queuedRequestsMutex;
@@ -11,7 +11,9 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
 
 #include <AssetUtils.h>
@@ -30,17 +32,28 @@ UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage
     
 }
 
+// The parts of the message's segments from its current position, up to size bytes
+static std::vector<QByteArray> getSegmentsToRead(const ReceivedMessage& message, qint64 size) {
+    std::vector<QByteArray> segmentsToRead;
+    qint64 segmentPosition = 0;
+    for (const auto& segment : message.getSegments()) {
+        qint64 segmentEnd = segmentPosition + segment.size();
+        qint64 from = std::max(message.getPosition(), segmentPosition);
+        qint64 to = std::min(message.getPosition() + size, segmentEnd);
+        if (from < to) {
+            segmentsToRead.push_back(QByteArray::fromRawData(segment.constData() + (from - segmentPosition), to - from));
+        }
+        segmentPosition = segmentEnd;
+    }
+    return segmentsToRead;
+}
+
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
     MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
+    _receivedMessage->readPrimitive(&messageID);
     
     uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    _receivedMessage->readPrimitive(&fileSize);
 
     if (_senderNode) {
         qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
@@ -54,9 +67,14 @@ void UploadAssetTask::run() {
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = AssetUtils::hashData(fileData);
+        // the file is hashed and written from the packets it came in, the message is never copied into one buffer
+        auto fileData = getSegmentsToRead(*_receivedMessage, fileSize);
+
+        QCryptographicHash hashing { QCryptographicHash::Sha256 };
+        for (const auto& segment : fileData) {
+            hashing.addData(segment);
+        }
+        auto hash = hashing.result();
         auto hexHash = hash.toHex();
 
         if (_senderNode) {
@@ -85,7 +103,14 @@ void UploadAssetTask::run() {
         }
 
         if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            bool wroteFile = file.open(QIODevice::WriteOnly);
+            qint64 bytesWritten = 0;
+            for (auto it = fileData.begin(); wroteFile && it != fileData.end(); ++it) {
+                wroteFile = file.write(*it) == it->size();
+                bytesWritten += it->size();
+            }
+
+            if (wroteFile && bytesWritten == qint64(fileSize)) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
                 file.close();
 
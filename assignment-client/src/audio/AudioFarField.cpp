@@ -0,0 +1,78 @@
+//
+//  AudioFarField.cpp
+//  assignment-client/src/audio
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioFarField.h"
+
+#include <algorithm>
+
+const AudioFarField::Contribution* AudioFarField::Submix::findContribution(const PositionalAudioStream* stream) const {
+    auto it = std::lower_bound(contributions.begin(), contributions.end(), stream, [](const Contribution& a, const PositionalAudioStream* b) {
+        return a.stream < b;
+    });
+    return (it != contributions.end() && it->stream == stream) ? &(*it) : nullptr;
+}
+
+void AudioFarField::reset(unsigned int frame, float distance) {
+    _frame = frame;
+
+    if (distance != _distance) {
+        // cells change size, drop them all
+        _distance = distance;
+        _submixes.clear();
+    }
+
+    // drop the cells no listener used last frame
+    for (auto it = _submixes.begin(); it != _submixes.end();) {
+        if (it->second->frame + 1 < _frame) {
+            it = _submixes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    _sources.clear();
+}
+
+void AudioFarField::addSource(const PositionalAudioStream* stream, const QUuid& nodeID, Node::LocalID nodeLocalID) {
+    _sources.push_back({ stream, nodeID, nodeLocalID });
+}
+
+void AudioFarField::addListener(const glm::vec3& position) {
+    auto key = SpatialGridBase::cellKey(SpatialGridBase::cellCoordinates(position, cellSize()));
+    auto& submix = _submixes[key];
+    if (!submix) {
+        submix.reset(new Submix());
+        submix->frame = _frame - 1;     // not mixed yet, but kept for this frame
+    }
+}
+
+glm::vec3 AudioFarField::getCellCenter(const glm::vec3& listenerPosition) const {
+    glm::vec3 cell = glm::vec3(SpatialGridBase::cellCoordinates(listenerPosition, cellSize()));
+    return (cell + glm::vec3(0.5f)) * cellSize();
+}
+
+void AudioFarField::encode(const int16_t* input, float* output, float gain, const glm::vec3& direction) {
+    const float scale = gain * (1 / 32768.0f);   // int16_t to float
+
+    // ambiX (ACN/SN3D) first-order encoding
+    const float w = scale;
+    const float y = scale * direction.y;
+    const float z = scale * direction.z;
+    const float x = scale * direction.x;
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        float sample = (float)input[i];
+        output[4*i+0] += w * sample;
+        output[4*i+1] += y * sample;
+        output[4*i+2] += z * sample;
+        output[4*i+3] += x * sample;
+    }
+}
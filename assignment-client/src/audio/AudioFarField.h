@@ -0,0 +1,119 @@
+//
+//  AudioFarField.h
+//  assignment-client/src/audio
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioFarField_h
+#define hifi_AudioFarField_h
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AudioConstants.h>
+#include <Node.h>
+#include <SpatialGrid.h>
+
+class PositionalAudioStream;
+
+// Shared "far field" of the audio mixer.
+//
+// Listeners are clustered in cells, and the sources far from a cell center are mixed once per frame into a
+// first-order ambisonic submix of that cell. Every listener of the cell decodes the submix with its own AudioFOA
+// instead of rendering each far source through its own HRTF.
+class AudioFarField {
+public:
+    static const int NUM_FOA_CHANNELS = 4;
+    static const int SUBMIX_SAMPLES = NUM_FOA_CHANNELS * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    struct Source {
+        const PositionalAudioStream* stream;
+        QUuid nodeID;
+        Node::LocalID nodeLocalID;
+    };
+
+    // contribution of a source to a submix, kept to take it back out for a single listener
+    struct Contribution {
+        const PositionalAudioStream* stream;
+        int sourceIndex;
+        float gain;
+        glm::vec3 direction;    // ambisonic (Z-up) coordinates
+    };
+
+    struct Submix {
+        std::mutex mutex;
+        unsigned int frame { 0 };
+        glm::vec3 center;
+        float samples[SUBMIX_SAMPLES];          // interleaved ambiX (W, Y, Z, X)
+        std::vector<Contribution> contributions;  // sorted by stream
+
+        const Contribution* findContribution(const PositionalAudioStream* stream) const;
+    };
+
+    // start a new frame, sources farther than distance from a cell center are in the far field (0 disables)
+    void reset(unsigned int frame, float distance);
+
+    bool isEnabled() const { return _distance > 0.0f; }
+    float getDistance() const { return _distance; }
+
+    // only called while building the frame, before mixing
+    void addSource(const PositionalAudioStream* stream, const QUuid& nodeID, Node::LocalID nodeLocalID);
+    void addListener(const glm::vec3& position);
+
+    const std::vector<Source>& getSources() const { return _sources; }
+
+    glm::vec3 getCellCenter(const glm::vec3& listenerPosition) const;
+    bool isFar(const glm::vec3& cellCenter, const glm::vec3& sourcePosition) const {
+        return isEnabled() && glm::distance(cellCenter, sourcePosition) > _distance;
+    }
+
+    // thread-safe, returns the submix of the cell of the listener, mixing it with mixFunctor on first use in the frame
+    template <typename F>
+    const Submix* getSubmix(const glm::vec3& listenerPosition, F mixFunctor);
+
+    // add the encoded samples of a mono block to an interleaved ambiX buffer
+    static void encode(const int16_t* input, float* output, float gain, const glm::vec3& direction);
+
+    // world (Y-up) to ambisonic (Z-up) coordinates
+    static glm::vec3 toAmbisonic(const glm::vec3& direction) { return glm::vec3(-direction.z, -direction.x, direction.y); }
+
+private:
+    float cellSize() const { return 0.5f * _distance; }
+
+    unsigned int _frame { 0 };
+    float _distance { 0.0f };
+
+    std::vector<Source> _sources;
+
+    // cells are only added between frames, so they can be looked up concurrently while mixing
+    std::unordered_map<SpatialGridBase::CellKey, std::unique_ptr<Submix>> _submixes;
+};
+
+template <typename F>
+const AudioFarField::Submix* AudioFarField::getSubmix(const glm::vec3& listenerPosition, F mixFunctor) {
+    auto it = _submixes.find(SpatialGridBase::cellKey(SpatialGridBase::cellCoordinates(listenerPosition, cellSize())));
+    if (it == _submixes.end()) {
+        return nullptr;
+    }
+
+    // the first listener of the cell mixes it, the others wait for it
+    Submix& submix = *it->second;
+    std::lock_guard<std::mutex> lock(submix.mutex);
+    if (submix.frame != _frame) {
+        submix.frame = _frame;
+        submix.center = getCellCenter(listenerPosition);
+        mixFunctor(submix);
+    }
+    return &submix;
+}
+
+#endif // hifi_AudioFarField_h
@@ -43,6 +43,9 @@ using namespace std;
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const float DEFAULT_AUDIBLE_RANGE = 0.0f;           // no culling
+static const int DEFAULT_NUM_LOUDEST_STREAMS = 8;
+static const float DEFAULT_FAR_FIELD_DISTANCE = 0.0f;     // no far field
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -56,6 +59,9 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
 vector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 vector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+AudioMixer::AudibilitySettings AudioMixer::_audibilitySettings { -1, DEFAULT_AUDIBLE_RANGE, DEFAULT_NUM_LOUDEST_STREAMS };
+vector<AudioMixer::AudibilitySettings> AudioMixer::_zoneAudibilitySettings;
+float AudioMixer::_farFieldDistance { DEFAULT_FAR_FIELD_DISTANCE };
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -295,6 +301,7 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_sleepTiming, "sleep");
     addTiming(_frameTiming, "frame");
     addTiming(_packetsTiming, "packets");
+    addTiming(_gridTiming, "grid");
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
@@ -305,20 +312,36 @@ void AudioMixer::sendStatsPacket() {
     // call it "avg_..." to keep it higher in the display, sorted alphabetically
     statsObject["avg_timing_stats"] = timingStats;
 
+    // per slave thread stats, to check how evenly the mix is spread
+    QJsonObject slaveStats;
+    for (int i = 0; i < (int)_slaveStats.size(); ++i) {
+        QJsonObject threadStats;
+        threadStats["us_per_frame"] = (qint64)(_slaveStats[i].workTime / _numStatFrames);
+        threadStats["nodes_per_frame"] = (float)_slaveStats[i].workItems / (float)_numStatFrames;
+        threadStats["stolen_nodes_per_frame"] = (float)_slaveStats[i].stolenItems / (float)_numStatFrames;
+        slaveStats[QString("thread_%1").arg(i)] = threadStats;
+        _slaveStats[i].reset();
+    }
+    statsObject["slave_thread_stats"] = slaveStats;
+
     // mix stats
     QJsonObject mixStats;
 
     mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
     mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
     mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
+    mixStats["%_far_field_mixes"] = percentageForMixStats(_stats.farFieldMixes);
 
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_far_field_submixes"] = (int)(_stats.farFieldSubmixes / (float)_numStatFrames);
+    mixStats["1_far_field_renders"] = (int)(_stats.farFieldRenders / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
+    mixStats["2_culled_streams"] = (int)(_stats.culled / (float)_numStatFrames);
 
     mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
     mixStats["3_skippped_to_inactive"] = (int)(_stats.skippedToInactive / (float)_numStatFrames);
@@ -326,6 +349,8 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_inactive_to_active"] = (int)(_stats.inactiveToActive / (float)_numStatFrames);
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
+    mixStats["3_culled_to_skipped"] = (int)(_stats.culledToSkipped / (float)_numStatFrames);
+    mixStats["3_to_culled"] = (int)(_stats.toCulled / (float)_numStatFrames);
 
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
@@ -346,6 +371,7 @@ void AudioMixer::sendStatsPacket() {
             QString uuidString = uuidStringWithoutCurlyBraces(node->getUUID());
 
             nodeStats["outbound_kbps"] = node->getOutboundKbps();
+            nodeStats["dropped_packets"] = (double)clientData->getNumDroppedPackets();
             nodeStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidString;
 
             nodeStats["jitter"] = clientData->getAudioStreamStats();
@@ -442,6 +468,15 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        // index the stream positions once, for every listener to find its audible streams
+        {
+            auto gridTimer = _gridTiming.timer();
+            nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                buildSpatialGrid(cbegin, cend);
+                buildFarField(cbegin, cend, frame);
+            });
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
@@ -454,8 +489,11 @@ void AudioMixer::start() {
         });
 
         // gather stats
+        _slaveStats.resize(_slavePool.numThreads());
+        int slaveIndex = 0;
         _slavePool.each([&](AudioMixerSlave& slave) {
             _stats.accumulate(slave.stats);
+            _slaveStats[slaveIndex++].accumulate(slave.stats);
             slave.stats.reset();
         });
 
@@ -471,6 +509,74 @@ void AudioMixer::start() {
     }
 }
 
+void AudioMixer::buildSpatialGrid(const NodeList::const_iterator& cbegin, const NodeList::const_iterator& cend) {
+    auto& grid = _workerSharedData.spatialGrid;
+
+    // cells as large as the largest audible range, so a listener only looks at its neighbouring cells
+    float cellSize = _audibilitySettings.audibleRange;
+    int maxLoudestStreams = _audibilitySettings.numLoudestStreams;
+    for (const auto& settings : _zoneAudibilitySettings) {
+        cellSize = max(cellSize, settings.audibleRange);
+        maxLoudestStreams = max(maxLoudestStreams, settings.numLoudestStreams);
+    }
+
+    if (cellSize <= 0.0f) {
+        // culling is disabled
+        grid.reset(0.0f, 0);
+        return;
+    }
+
+    grid.reset(cellSize, maxLoudestStreams);
+    std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (nodeData) {
+            for (auto& stream : nodeData->getAudioStreams()) {
+                grid.insert(stream.get());
+            }
+        }
+    });
+    grid.finalize();
+}
+
+void AudioMixer::buildFarField(const NodeList::const_iterator& cbegin, const NodeList::const_iterator& cend,
+                               unsigned int frame) {
+    auto& farField = _workerSharedData.farField;
+
+    farField.reset(frame, _farFieldDistance);
+    if (!farField.isEnabled()) {
+        return;
+    }
+
+    std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        // mono streams with audio this frame are sources, stereo streams are not spatialized
+        for (auto& stream : nodeData->getAudioStreams()) {
+            if (!stream->isStereo() && stream->lastPopSucceeded() && stream->getLastPopOutputLoudness() != 0.0f) {
+                farField.addSource(stream.get(), node->getUUID(), node->getLocalID());
+            }
+        }
+
+        // a cell for each listener
+        auto avatarStream = nodeData->getAvatarAudioStream();
+        if (avatarStream && node->getType() == NodeType::Agent) {
+            farField.addListener(avatarStream->getPosition());
+        }
+    });
+}
+
+const AudioMixer::AudibilitySettings& AudioMixer::getAudibilitySettings(const glm::vec3& listenerPosition) {
+    for (const auto& settings : _zoneAudibilitySettings) {
+        if (_audioZones[settings.zone].area.contains(listenerPosition)) {
+            return settings;
+        }
+    }
+    return _audibilitySettings;
+}
+
 chrono::microseconds AudioMixer::timeFrame() {
     // advance the next frame
     auto now = p_high_resolution_clock::now();
@@ -542,6 +648,9 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _audibilitySettings = { -1, DEFAULT_AUDIBLE_RANGE, DEFAULT_NUM_LOUDEST_STREAMS };
+    _zoneAudibilitySettings.clear();
+    _farFieldDistance = DEFAULT_FAR_FIELD_DISTANCE;
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -560,6 +669,9 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString PIN_THREADS = "pin_threads";
+        _slavePool.setPinThreads(audioThreadingGroupObject[PIN_THREADS].toBool());
+
         const QString THROTTLE_START_KEY = "throttle_start";
         const QString THROTTLE_BACKOFF_KEY = "throttle_backoff";
 
@@ -673,6 +785,36 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString AUDIBLE_RANGE = "audible_range";
+        if (audioEnvGroupObject[AUDIBLE_RANGE].isString()) {
+            bool ok = false;
+            float audibleRange = audioEnvGroupObject[AUDIBLE_RANGE].toString().toFloat(&ok);
+            if (ok && audibleRange >= 0.0f) {
+                _audibilitySettings.audibleRange = audibleRange;
+                qCDebug(audio) << "Audible range changed to" << _audibilitySettings.audibleRange;
+            }
+        }
+
+        const QString LOUDEST_STREAMS = "loudest_streams";
+        if (audioEnvGroupObject[LOUDEST_STREAMS].isString()) {
+            bool ok = false;
+            int numLoudestStreams = audioEnvGroupObject[LOUDEST_STREAMS].toString().toInt(&ok);
+            if (ok && numLoudestStreams >= 0) {
+                _audibilitySettings.numLoudestStreams = numLoudestStreams;
+                qCDebug(audio) << "Loudest streams changed to" << _audibilitySettings.numLoudestStreams;
+            }
+        }
+
+        const QString FAR_FIELD_DISTANCE = "far_field_distance";
+        if (audioEnvGroupObject[FAR_FIELD_DISTANCE].isString()) {
+            bool ok = false;
+            float farFieldDistance = audioEnvGroupObject[FAR_FIELD_DISTANCE].toString().toFloat(&ok);
+            if (ok && farFieldDistance >= 0.0f) {
+                _farFieldDistance = farFieldDistance;
+                qCDebug(audio) << "Far field distance changed to" << _farFieldDistance;
+            }
+        }
+
         const QString AUDIO_ZONES = "zones";
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
@@ -793,6 +935,40 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
                 }
             }
         }
+
+        const QString AUDIBILITY = "audibility";
+        if (audioEnvGroupObject[AUDIBILITY].isArray()) {
+            const QJsonArray& audibility = audioEnvGroupObject[AUDIBILITY].toArray();
+
+            const QString ZONE = "zone";
+            for (int i = 0; i < audibility.count(); ++i) {
+                QJsonObject audibilityObject = audibility[i].toObject();
+
+                if (audibilityObject.contains(ZONE) &&
+                    audibilityObject.contains(AUDIBLE_RANGE) &&
+                    audibilityObject.contains(LOUDEST_STREAMS)) {
+
+                    bool okAudibleRange, okLoudestStreams;
+                    auto itZone = find_if(begin(_audioZones), end(_audioZones), [&](const ZoneDescription& description) {
+                        return description.name == audibilityObject.value(ZONE).toString();
+                    });
+                    float audibleRange = audibilityObject.value(AUDIBLE_RANGE).toString().toFloat(&okAudibleRange);
+                    int numLoudestStreams = audibilityObject.value(LOUDEST_STREAMS).toString().toInt(&okLoudestStreams);
+
+                    if (okAudibleRange && okLoudestStreams && audibleRange >= 0.0f && numLoudestStreams >= 0 &&
+                        itZone != end(_audioZones)) {
+                        AudibilitySettings settings;
+                        settings.zone = itZone - begin(_audioZones);
+                        settings.audibleRange = audibleRange;
+                        settings.numLoudestStreams = numLoudestStreams;
+
+                        _zoneAudibilitySettings.push_back(settings);
+
+                        qCDebug(audio) << "Added Audibility:" << itZone->name << audibleRange << numLoudestStreams;
+                    }
+                }
+            }
+        }
     }
 }
 
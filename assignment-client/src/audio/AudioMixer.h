@@ -49,6 +49,11 @@ public:
         float reverbTime;
         float wetLevel;
     };
+    struct AudibilitySettings {
+        int zone;
+        float audibleRange;     // 0 disables culling
+        int numLoudestStreams;  // heard beyond the audible range
+    };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
@@ -56,6 +61,7 @@ public:
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static const AudibilitySettings& getAudibilitySettings(const glm::vec3& listenerPosition);
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -94,6 +100,9 @@ private:
     void parseSettingsObject(const QJsonObject& settingsObject);
     void clearDomainSettings();
 
+    void buildSpatialGrid(const NodeList::const_iterator& cbegin, const NodeList::const_iterator& cend);
+    void buildFarField(const NodeList::const_iterator& cbegin, const NodeList::const_iterator& cend, unsigned int frame);
+
     p_high_resolution_clock::time_point _idealFrameTimestamp;
     p_high_resolution_clock::time_point _startFrameTimestamp;
 
@@ -104,6 +113,7 @@ private:
 
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
+    std::vector<AudioMixerStats> _slaveStats; // per slave thread, for load balancing stats
 
     AudioMixerSlavePool _slavePool { _workerSharedData };
 
@@ -137,6 +147,7 @@ private:
     Timer _mixTiming;
     Timer _eventsTiming;
     Timer _packetsTiming;
+    Timer _gridTiming;
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
@@ -147,6 +158,9 @@ private:
     static std::vector<ZoneDescription> _audioZones;
     static std::vector<ZoneSettings> _zoneSettings;
     static std::vector<ReverbSettings> _zoneReverbSettings;
+    static AudibilitySettings _audibilitySettings;
+    static std::vector<AudibilitySettings> _zoneAudibilitySettings;
+    static float _farFieldDistance;
 
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
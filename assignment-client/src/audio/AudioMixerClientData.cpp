@@ -50,20 +50,27 @@ AudioMixerClientData::~AudioMixerClientData() {
     }
 }
 
+static bool isDroppablePacket(PacketType type) {
+    return type == PacketType::MicrophoneAudioNoEcho || type == PacketType::MicrophoneAudioWithEcho ||
+           type == PacketType::InjectAudio || type == PacketType::SilentAudioFrame;
+}
+
 void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (!_packetQueue.node) {
-        _packetQueue.node = node;
+    // the slave is behind, audio frames can be lost, the jitter buffer covers for them
+    bool isDroppable = isDroppablePacket(message->getType());
+    if (!_packetQueue.push({ message, node }, isDroppable)) {
+        ++_numDroppedPackets;
     }
-    _packetQueue.push(message);
 }
 
 int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
-
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    QueuedPacket queuedPacket;
+    while (_packetQueue.pop(queuedPacket)) {
+        auto& packet = queuedPacket.message;
+        SharedNodePointer node = queuedPacket.node;
+        if (!node) {
+            continue;
+        }
 
         switch (packet->getType()) {
             case PacketType::MicrophoneAudioNoEcho:
@@ -104,10 +111,7 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
             default:
                 Q_UNREACHABLE();
         }
-
-        _packetQueue.pop();
     }
-    assert(_packetQueue.empty());
 
     // now that we have processed all packets for this frame
     // we can prepare the sources from this client to be ready for mixing
@@ -344,6 +348,7 @@ void AudioMixerClientData::removeAgentAvatarAudioStream() {
         _streams.skipped.clear();
         _streams.inactive.clear();
         _streams.active.clear();
+        _streams.culled.clear();
     }
 }
 
@@ -12,15 +12,18 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
-#include <queue>
+#include <mutex>
+#include <unordered_map>
 
 #include <tbb/concurrent_vector.h>
 
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
+#include <SPSCQueue.h>
 #include <UUIDHasher.h>
 
 #include <plugins/Forward.h>
@@ -51,6 +54,7 @@ public:
 
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
     int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
+    uint64_t getNumDroppedPackets() const { return _numDroppedPackets; }
 
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
     AvatarAudioStream* getAvatarAudioStream();
@@ -118,6 +122,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool isFarField { false };
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -130,6 +135,9 @@ public:
         MixableStreamsVector active;
         MixableStreamsVector inactive;
         MixableStreamsVector skipped;
+
+        // out of the audible range of the listener, only looked up when the listener gets in range
+        std::unordered_map<const PositionalAudioStream*, MixableStream> culled;
     };
 
     Streams& getStreams() { return _streams; }
@@ -147,7 +155,14 @@ public:
     const ConcurrentIgnoreNodeIDs& getNewIgnoringNodeIDs() const { return _newIgnoringNodeIDs; }
     const ConcurrentIgnoreNodeIDs& getNewUnignoringNodeIDs() const { return _newUnignoringNodeIDs; }
 
+    // decoder of the far field submix heard by this listener
+    AudioFOA& getFarFieldFOA() { return _farFieldFOA; }
+
     void clearStagedIgnoreChanges();
+    bool hasStagedIgnoreChanges() const {
+        return !_newIgnoredNodeIDs.empty() || !_newUnignoredNodeIDs.empty() ||
+               !_newIgnoringNodeIDs.empty() || !_newUnignoringNodeIDs.empty();
+    }
 
     const Node::IgnoredNodeIDs& getIgnoringNodeIDs() const { return _ignoringNodeIDs; }
 
@@ -167,10 +182,15 @@ public slots:
     void sendSelectAudioFormat(SharedNodePointer node, const QString& selectedCodecName);
 
 private:
-    struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
+    struct QueuedPacket {
+        QSharedPointer<ReceivedMessage> message;
         QWeakPointer<Node> node;
     };
-    PacketQueue _packetQueue;
+
+    // filled by the network thread and drained by a slave, neither waits on the other
+    static const size_t PACKET_QUEUE_CAPACITY = 256;
+    OverflowingSPSCQueue<QueuedPacket> _packetQueue { PACKET_QUEUE_CAPACITY };
+    std::atomic<uint64_t> _numDroppedPackets { 0 };
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
@@ -208,6 +228,8 @@ private:
     tbb::concurrent_vector<QUuid> _newIgnoringNodeIDs;
     tbb::concurrent_vector<QUuid> _newUnignoringNodeIDs;
 
+    AudioFOA _farFieldFOA;
+
     std::mutex _ignoringNodeIDsMutex;
     Node::IgnoredNodeIDs _ignoringNodeIDs;
 
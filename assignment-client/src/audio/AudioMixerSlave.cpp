@@ -50,7 +50,7 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
 
 // mix helpers
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
-inline float computeGain(float masterListenerGain, const AvatarAudioStream& listeningNodeStream,
+inline float computeGain(float masterListenerGain, const glm::vec3& listenerPosition,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance, bool isEcho);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
@@ -320,12 +320,73 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     addStreams(*listener, *listenerData);
 
+    // far sources are heard through the shared submix of the listener cell, unless the listener is soloing
+    auto& farField = _sharedData.farField;
+    _useFarField = farField.isEnabled() && !isSoloing;
+    if (_useFarField) {
+        _farFieldCenter = farField.getCellCenter(listenerAudioStream->getPosition());
+    }
+    _farFieldCorrections.clear();
+
+    // streams out of the audible range are culled, soloed streams are heard at any distance
+    const auto& grid = _sharedData.spatialGrid;
+    const auto& audibility = AudioMixer::getAudibilitySettings(listenerAudioStream->getPosition());
+    bool isCulling = grid.isEnabled() && audibility.audibleRange > 0.0f && !isSoloing;
+
+    // removals and ignore changes are only processed for the streams below, so stop culling for this frame
+    bool hasChanges = !_sharedData.removedNodes.empty() || !_sharedData.removedStreams.empty() ||
+                      listenerData->hasStagedIgnoreChanges();
+    bool canCull = isCulling && !hasChanges;
+
+    float audibleRangeSquared = audibility.audibleRange * audibility.audibleRange;
+    auto isAudible = [&](const PositionalAudioStream* stream) {
+        return stream == listenerAudioStream ||
+               glm::distance2(stream->getPosition(), listenerAudioStream->getPosition()) <= audibleRangeSquared ||
+               grid.isAmongLoudest(stream, audibility.numLoudestStreams);
+    };
+    auto cull = [&](MixableStream& stream) {
+        resetHRTFState(stream);
+        auto positionalStream = stream.positionalStream;
+        streams.culled.emplace(positionalStream, move(stream));
+        ++stats.toCulled;
+    };
+
+    // Process culled streams, only looking at the ones that may have come in range
+    if (!streams.culled.empty()) {
+        if (!canCull) {
+            for (auto& culled : streams.culled) {
+                streams.skipped.push_back(move(culled.second));
+            }
+            stats.culledToSkipped += (int)streams.culled.size();
+            streams.culled.clear();
+        } else {
+            auto uncull = [&](const PositionalAudioStream* stream) {
+                auto it = streams.culled.find(stream);
+                if (it != streams.culled.end() && isAudible(stream)) {
+                    streams.skipped.push_back(move(it->second));
+                    streams.culled.erase(it);
+                    ++stats.culledToSkipped;
+                }
+            };
+            grid.forEachCandidate(listenerAudioStream->getPosition(), audibility.audibleRange, uncull);
+
+            const auto& loudestStreams = grid.getLoudestStreams();
+            int numLoudestStreams = min(audibility.numLoudestStreams, (int)loudestStreams.size());
+            std::for_each(loudestStreams.begin(), loudestStreams.begin() + numLoudestStreams, uncull);
+        }
+    }
+
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
             return true;
         }
 
+        if (canCull && !isAudible(stream.positionalStream)) {
+            cull(stream);
+            return true;
+        }
+
         if (!shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
             if (shouldBeInactive(stream)) {
                 streams.inactive.push_back(move(stream));
@@ -350,6 +411,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (canCull && !isAudible(stream.positionalStream)) {
+            cull(stream);
+            return true;
+        }
+
         if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
             streams.skipped.push_back(move(stream));
             ++stats.inactiveToSkipped;
@@ -375,6 +441,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (canCull && !isAudible(stream.positionalStream)) {
+            cull(stream);
+            return true;
+        }
+
         if (isThrottling) {
             // we're throttling, so we need to update the approximate volume for any un-skipped streams
             // unless this is simply for an echo (in which case the approx volume is 1.0)
@@ -460,9 +531,17 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         });
     }
 
+    // render the HRTF of every queued source into the mix
+    flushHRTFRenders();
+
+    if (_useFarField) {
+        addFarField(*listener, *listenerData, *listenerAudioStream);
+    }
+
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
+    stats.culled += (int)streams.culled.size();
 
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
@@ -499,6 +578,27 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     // check if this is a server echo of a source back to itself
     bool isEcho = (streamToAdd == &listeningNodeStream);
 
+    // far sources are already in the far field submix, only their per listener gain is left to apply
+    bool isFarField = _useFarField && !isEcho && !streamToAdd->isStereo() &&
+                      _sharedData.farField.isFar(_farFieldCenter, streamToAdd->getPosition());
+    if (isFarField != mixableStream.isFarField) {
+        mixableStream.isFarField = isFarField;
+        if (isFarField) {
+            resetHRTFState(mixableStream);
+        }
+    }
+    if (isFarField) {
+        float gainAdjustment = mixableStream.hrtf->getGainAdjustment();
+        if (streamToAdd->getType() == PositionalAudioStream::Microphone) {
+            gainAdjustment *= masterListenerGain;
+        }
+        if (gainAdjustment != 1.0f) {
+            _farFieldCorrections.push_back({ streamToAdd, gainAdjustment - 1.0f });
+        }
+        ++stats.farFieldMixes;
+        return;
+    }
+
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
@@ -506,11 +606,9 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
     float gain = masterListenerGain;
     if (!isSoloing) {
-        gain = computeGain(masterListenerGain, listeningNodeStream, *streamToAdd, relativePosition, distance, isEcho);
+        gain = computeGain(masterListenerGain, listeningNodeStream.getPosition(), *streamToAdd, relativePosition, distance, isEcho);
     }
 
-    const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
@@ -534,9 +632,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
             // call renderSilent with a forced silent block to reduce artifacts
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                queueHRTFRender(mixableStream.hrtf.get(), AudioRingBuffer::ConstIterator(), azimuth, distance, gain);
 
                 ++stats.hrtfRenders;
             }
@@ -575,15 +671,184 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
         ++stats.manualEchoMixes;
     } else {
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        queueHRTFRender(mixableStream.hrtf.get(), streamPopOutput, azimuth, distance, gain);
 
         ++stats.hrtfRenders;
     }
 }
 
+void AudioMixerSlave::queueHRTFRender(AudioHRTF* hrtf, AudioRingBuffer::ConstIterator input,
+                                      float azimuth, float distance, float gain) {
+    static const int16_t SILENT_BLOCK[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+    const int numSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    const int16_t* samples = SILENT_BLOCK;  // forced silent block
+    if (!input.isNull()) {
+        // the streams are only written to between mixes, their last frame is rendered from their ring buffer
+        samples = input.contiguousSamples(numSamples);
+        if (!samples) {
+            // unless it wraps around the end of the ring buffer
+            size_t offset = _hrtfInputSamples.size();
+            _hrtfInputSamples.resize(offset + numSamples);
+            input.readSamples(&_hrtfInputSamples[offset], numSamples);
+            _hrtfCopiedInputs.emplace_back(_hrtfInputs.size(), offset);
+        }
+    }
+
+    _hrtfs.push_back(hrtf);
+    _hrtfInputs.push_back(samples);
+    _hrtfAzimuths.push_back(azimuth);
+    _hrtfDistances.push_back(distance);
+    _hrtfGains.push_back(gain);
+}
+
+void AudioMixerSlave::flushHRTFRenders() {
+    const int HRTF_DATASET_INDEX = 1;
+    const int numSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    int numSources = (int)_hrtfs.size();
+
+    if (numSources > 0) {
+        // the copied inputs are stable now that queueing is done
+        for (const auto& copiedInput : _hrtfCopiedInputs) {
+            _hrtfInputs[copiedInput.first] = &_hrtfInputSamples[copiedInput.second];
+        }
+
+        AudioHRTF::renderBatch(_hrtfs.data(), _hrtfInputs.data(), _mixSamples, HRTF_DATASET_INDEX,
+                               _hrtfAzimuths.data(), _hrtfDistances.data(), _hrtfGains.data(),
+                               numSources, numSamples);
+    }
+
+    _hrtfs.clear();
+    _hrtfInputs.clear();
+    _hrtfInputSamples.clear();
+    _hrtfCopiedInputs.clear();
+    _hrtfAzimuths.clear();
+    _hrtfDistances.clear();
+    _hrtfGains.clear();
+}
+
+void AudioMixerSlave::mixFarFieldSubmix(AudioFarField::Submix& submix) {
+    const auto& farField = _sharedData.farField;
+    const auto& grid = _sharedData.spatialGrid;
+    const auto& sources = farField.getSources();
+
+    memset(submix.samples, 0, sizeof(submix.samples));
+    submix.contributions.clear();
+
+    // the audible range applies to the far field as heard from the center of the cell
+    const auto& audibility = AudioMixer::getAudibilitySettings(submix.center);
+    bool isCulling = grid.isEnabled() && audibility.audibleRange > 0.0f;
+
+    int16_t input[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    for (int i = 0; i < (int)sources.size(); ++i) {
+        auto stream = sources[i].stream;
+
+        glm::vec3 relativePosition = stream->getPosition() - submix.center;
+        float distance = glm::length(relativePosition);
+        if (distance <= farField.getDistance()) {
+            continue;
+        }
+        if (isCulling && distance > audibility.audibleRange &&
+            !grid.isAmongLoudest(stream, audibility.numLoudestStreams)) {
+            continue;
+        }
+
+        float gain = computeGain(1.0f, submix.center, *stream, relativePosition, distance, false);
+        glm::vec3 direction = AudioFarField::toAmbisonic(relativePosition / distance);
+
+        AudioRingBuffer::ConstIterator streamPopOutput = stream->getLastPopOutput();
+        streamPopOutput.readSamples(input, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        AudioFarField::encode(input, submix.samples, gain, direction);
+
+        submix.contributions.push_back({ stream, i, gain, direction });
+    }
+
+    std::sort(submix.contributions.begin(), submix.contributions.end(), [](const auto& a, const auto& b) {
+        return a.stream < b.stream;
+    });
+
+    ++stats.farFieldSubmixes;
+}
+
+void AudioMixerSlave::addFarField(const Node& listener, AudioMixerClientData& listenerData,
+                                  const AvatarAudioStream& listenerAudioStream) {
+    auto& farField = _sharedData.farField;
+    auto submix = farField.getSubmix(listenerAudioStream.getPosition(), [this](AudioFarField::Submix& submix) {
+        mixFarFieldSubmix(submix);
+    });
+    if (!submix || submix->contributions.empty()) {
+        return;
+    }
+
+    float samples[AudioFarField::SUBMIX_SAMPLES];
+    memcpy(samples, submix->samples, sizeof(samples));
+
+    int16_t input[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    auto correct = [&](const AudioFarField::Contribution& contribution, float gain) {
+        AudioRingBuffer::ConstIterator streamPopOutput = contribution.stream->getLastPopOutput();
+        streamPopOutput.readSamples(input, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        AudioFarField::encode(input, samples, gain * contribution.gain, contribution.direction);
+    };
+
+    // take out the sources this listener does not hear, with the same rules as shouldBeSkipped
+    auto& ignoredNodeIDs = listener.getIgnoredNodeIDs();
+    auto& ignoringNodeIDs = listenerData.getIgnoringNodeIDs();
+    bool listenerIsAdmin = listenerData.getRequestsDomainListData() && listener.getCanKick();
+    const auto& sources = farField.getSources();
+    for (const auto& contribution : submix->contributions) {
+        const auto& source = sources[contribution.sourceIndex];
+        bool isHeard;
+        if (source.nodeLocalID == listener.getLocalID()) {
+            isHeard = source.stream->shouldLoopbackForNode();
+        } else {
+            isHeard = !contains(ignoredNodeIDs, source.nodeID) &&
+                      (listenerIsAdmin || !contains(ignoringNodeIDs, source.nodeID));
+
+            bool shouldCheckIgnoreBox = (listenerAudioStream.isIgnoreBoxEnabled() ||
+                                         source.stream->isIgnoreBoxEnabled());
+            if (isHeard && shouldCheckIgnoreBox &&
+                listenerAudioStream.getIgnoreBox().touches(source.stream->getIgnoreBox())) {
+                isHeard = false;
+            }
+        }
+        if (!isHeard) {
+            correct(contribution, -1.0f);
+        }
+    }
+
+    // per listener gain adjustments
+    for (const auto& correction : _farFieldCorrections) {
+        auto contribution = submix->findContribution(correction.stream);
+        if (contribution) {
+            correct(*contribution, correction.gain);
+        }
+    }
+
+    // convert to int16_t for the ambisonic renderer, scaled to the peak so that nothing clips
+    float peak = 1.0f;
+    for (int i = 0; i < AudioFarField::SUBMIX_SAMPLES; ++i) {
+        peak = std::max(peak, std::abs(samples[i]));
+    }
+    const float scale = 32767.0f / peak;
+    int16_t foaSamples[AudioFarField::SUBMIX_SAMPLES];
+    for (int i = 0; i < AudioFarField::SUBMIX_SAMPLES; ++i) {
+        foaSamples[i] = (int16_t)(samples[i] * scale);
+    }
+
+    // the submix is in world coordinates, rotate it to the listener, converted from Y-up to Z-up
+    glm::quat relativeOrientation = glm::inverse(listenerAudioStream.getOrientation());
+    float qw = relativeOrientation.w;
+    float qx = -relativeOrientation.z;
+    float qy = -relativeOrientation.x;
+    float qz = relativeOrientation.y;
+
+    const int HRTF_DATASET_INDEX = 1;
+    listenerData.getFarFieldFOA().render(foaSamples, _mixSamples, HRTF_DATASET_INDEX, qw, qx, qy, qz, peak * (32768.0f / 32767.0f),
+                                         AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    ++stats.farFieldRenders;
+}
+
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                                       AvatarAudioStream& listeningNodeStream,
                                       float masterListenerGain) {
@@ -595,7 +860,7 @@ void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream&
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
-    float gain = computeGain(masterListenerGain, listeningNodeStream, *streamToAdd, relativePosition, distance, isEcho);
+    float gain = computeGain(masterListenerGain, listeningNodeStream.getPosition(), *streamToAdd, relativePosition, distance, isEcho);
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
     mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
@@ -732,7 +997,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
     // avatar: skip master gain - it is constant for all streams
 }
 
-float computeGain(float masterListenerGain, const AvatarAudioStream& listeningNodeStream,
+float computeGain(float masterListenerGain, const glm::vec3& listenerPosition,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance, bool isEcho) {
     float gain = 1.0f;
 
@@ -765,7 +1030,7 @@ float computeGain(float masterListenerGain, const AvatarAudioStream& listeningNo
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
         if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+            audioZones[settings.listener].area.contains(listenerPosition)) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
         }
@@ -22,8 +22,10 @@
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
+#include "AudioFarField.h"
 #include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
+#include "AudioSpatialGrid.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
@@ -36,6 +38,8 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioSpatialGrid spatialGrid;
+        AudioFarField farField;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -63,12 +67,39 @@ private:
                               float masterListenerGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
 
+    // HRTF renders are queued while walking the streams and rendered together by flushHRTFRenders
+    // The input is rendered from the stream's ring buffer, a null input renders a silent block
+    void queueHRTFRender(AudioHRTF* hrtf, AudioRingBuffer::ConstIterator input, float azimuth, float distance, float gain);
+    void flushHRTFRenders();
+
+    // far sources are mixed once per listener cell, then decoded by each listener
+    void mixFarFieldSubmix(AudioFarField::Submix& submix);
+    void addFarField(const Node& listener, AudioMixerClientData& listenerData, const AvatarAudioStream& listenerAudioStream);
+
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // queued HRTF renders for the current listener
+    std::vector<AudioHRTF*> _hrtfs;
+    std::vector<const int16_t*> _hrtfInputs;
+    std::vector<int16_t> _hrtfInputSamples; // the inputs that had to be copied
+    std::vector<std::pair<size_t, size_t>> _hrtfCopiedInputs; // index of the render, offset in _hrtfInputSamples
+    std::vector<float> _hrtfAzimuths;
+    std::vector<float> _hrtfDistances;
+    std::vector<float> _hrtfGains;
+
+    // far field state for the current listener
+    struct FarFieldCorrection {
+        const PositionalAudioStream* stream;
+        float gain;     // relative to the gain of the stream in the submix
+    };
+    bool _useFarField { false };
+    glm::vec3 _farFieldCenter;
+    std::vector<FarFieldCorrection> _farFieldCorrections;
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -13,17 +13,50 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <chrono>
+
+#include <PortableHighResolutionClock.h>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static inline uint64_t packWorkRange(uint32_t front, uint32_t back) {
+    return ((uint64_t)front << 32) | back;
+}
+
+static inline uint32_t workRangeFront(uint64_t range) {
+    return (uint32_t)(range >> 32);
+}
+
+static inline uint32_t workRangeBack(uint64_t range) {
+    return (uint32_t)range;
+}
 
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
+        auto start = p_high_resolution_clock::now();
+
+        // iterate over the nodes assigned to this slave...
         SharedNodePointer node;
         while (try_pop(node)) {
             (this->*_function)(node);
+            ++stats.workItems;
         }
 
+        // ...then help out the other slaves
+        while (try_steal(node)) {
+            (this->*_function)(node);
+            ++stats.workItems;
+            ++stats.stolenItems;
+        }
+        node.reset();
+
+        stats.workTime += std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - start).count();
+
         bool stopping = _stop;
         notify(stopping);
         if (stopping) {
@@ -34,12 +67,15 @@ void AudioMixerSlaveThread::run() {
 
 void AudioMixerSlaveThread::wait() {
     {
-        Lock lock(_pool._mutex);
-        _pool._slaveCondition.wait(lock, [&] {
-            assert(_pool._numStarted <= _pool._numThreads);
-            return _pool._numStarted != _pool._numThreads;
+        Lock lock(_mutex);
+        _condition.wait(lock, [&] {
+            return _runCount != _lastRunCount;
         });
-        ++_pool._numStarted;
+        _lastRunCount = _runCount;
+    }
+
+    if (_pool._pinThreads != _isPinned) {
+        updateAffinity();
     }
 
     if (_pool._configure) {
@@ -49,25 +85,77 @@ void AudioMixerSlaveThread::wait() {
 }
 
 void AudioMixerSlaveThread::notify(bool stopping) {
-    {
+    if (stopping) {
+        ++_pool._numStopped;
+    }
+
+    if (++_pool._numFinished == _pool._numThreads) {
+        // last one out wakes the pool, take the lock so the wake cannot slip in before the pool waits
         Lock lock(_pool._mutex);
-        assert(_pool._numFinished < _pool._numThreads);
-        ++_pool._numFinished;
-        if (stopping) {
-            ++_pool._numStopped;
-        }
+        _pool._poolCondition.notify_one();
     }
-    _pool._poolCondition.notify_one();
 }
 
 bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    uint64_t range = _workRange.load(std::memory_order_acquire);
+    while (workRangeFront(range) < workRangeBack(range)) {
+        uint32_t front = workRangeFront(range);
+        if (_workRange.compare_exchange_weak(range, packWorkRange(front + 1, workRangeBack(range)))) {
+            node = _pool._nodes[front];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node) {
+    // visit the other slaves, starting with our neighbour so that thieves spread out
+    int numSlaves = (int)_pool._slaves.size();
+    for (int i = 1; i < numSlaves; ++i) {
+        auto& victim = _pool._slaves[(_index + i) % numSlaves];
+
+        uint64_t range = victim->_workRange.load(std::memory_order_acquire);
+        while (workRangeFront(range) < workRangeBack(range)) {
+            uint32_t back = workRangeBack(range);
+            if (victim->_workRange.compare_exchange_weak(range, packWorkRange(workRangeFront(range), back - 1))) {
+                node = _pool._nodes[back - 1];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void AudioMixerSlaveThread::updateAffinity() {
+    _isPinned = _pool._pinThreads;
+
+#ifdef Q_OS_LINUX
+    int numCores = QThread::idealThreadCount();
+    if (numCores <= 0) {
+        return;
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (_isPinned) {
+        // leave the first core for the mixer and network threads
+        CPU_SET((_index + 1) % numCores, &cpuSet);
+    } else {
+        for (int i = 0; i < numCores; ++i) {
+            CPU_SET(i, &cpuSet);
+        }
+    }
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+        qWarning("%s: could not set affinity for audio mixer slave %d", __FUNCTION__, _index);
+    }
+#endif
 }
 
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    run(begin, end, nullptr);
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
@@ -76,35 +164,96 @@ void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame
         slave.configureMix(_begin, _end, frame, numToRetain);
     };
 
-    run(begin, end);
+    // a listener costs roughly as much as the number of streams it has to consider
+    auto cost = [](const SharedNodePointer& node) {
+        auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!data) {
+            return 1;
+        }
+        auto& streams = data->getStreams();
+        return 1 + (int)(streams.active.size() + streams.inactive.size() + streams.skipped.size());
+    };
+
+    run(begin, end, cost);
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, CostFunction cost) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
+    _nodes.assign(_begin, _end);
+    partition(cost);
+
+    runSlaves();
+
+    _nodes.clear();
+}
+
+void AudioMixerSlavePool::partition(CostFunction cost) {
+    int numNodes = (int)_nodes.size();
+
+    if (!cost || _numThreads == 1) {
+        // uniform cost, hand out contiguous ranges of equal size
+        for (int i = 0; i < _numThreads; ++i) {
+            uint32_t front = (uint32_t)((int64_t)numNodes * i / _numThreads);
+            uint32_t back = (uint32_t)((int64_t)numNodes * (i + 1) / _numThreads);
+            _slaves[i]->_workRange.store(packWorkRange(front, back), std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    // assign the most expensive nodes first, each to the least loaded slave (longest processing time first)
+    _costs.clear();
+    for (int i = 0; i < numNodes; ++i) {
+        _costs.emplace_back(cost(_nodes[i]), i);
+    }
+    std::sort(_costs.begin(), _costs.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first > b.first;
     });
 
-    {
-        Lock lock(_mutex);
+    std::vector<int64_t> loads(_numThreads, 0);
+    std::vector<std::vector<int>> assignments(_numThreads);
+    for (auto& nodeCost : _costs) {
+        auto lightest = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        loads[lightest] += nodeCost.first;
+        assignments[lightest].push_back(nodeCost.second);
+    }
+
+    // lay the nodes out so that each slave owns a contiguous range, heaviest at the front
+    _partitioned.clear();
+    _partitioned.reserve(numNodes);
+    for (int i = 0; i < _numThreads; ++i) {
+        uint32_t front = (uint32_t)_partitioned.size();
+        for (int index : assignments[i]) {
+            _partitioned.push_back(std::move(_nodes[index]));
+        }
+        uint32_t back = (uint32_t)_partitioned.size();
+        _slaves[i]->_workRange.store(packWorkRange(front, back), std::memory_order_relaxed);
+    }
+    _nodes.swap(_partitioned);
+    _partitioned.clear();
+}
+
+void AudioMixerSlavePool::runSlaves() {
+    _numFinished = 0;
 
-        // run
-        _numStarted = _numFinished = 0;
-        _slaveCondition.notify_all();
+    // run
+    for (auto& slave : _slaves) {
+        {
+            Lock lock(slave->_mutex);
+            ++slave->_runCount;
+        }
+        slave->_condition.notify_one();
+    }
 
-        // wait
+    // wait
+    {
+        Lock lock(_mutex);
         _poolCondition.wait(lock, [&] {
             assert(_numFinished <= _numThreads);
             return _numFinished == _numThreads;
         });
-
-        assert(_numStarted == _numThreads);
     }
-
-    assert(_queue.empty());
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -138,12 +287,10 @@ void AudioMixerSlavePool::resize(int numThreads) {
 
     qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
 
-    Lock lock(_mutex);
-
     if (numThreads > _numThreads) {
         // start new slaves
-        for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
+        for (int i = _numThreads; i < numThreads; ++i) {
+            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData, i);
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -157,16 +304,16 @@ void AudioMixerSlavePool::resize(int numThreads) {
             ++slave;
         }
 
-        // ...cycle them until they do stop...
-        _numStopped = 0;
-        while (_numStopped != (_numThreads - numThreads)) {
-            _numStarted = _numFinished = _numStopped;
-            _slaveCondition.notify_all();
-            _poolCondition.wait(lock, [&] {
-                assert(_numFinished <= _numThreads);
-                return _numFinished == _numThreads;
-            });
+        // ...cycle them through an empty run so they do stop...
+        _function = nullptr;
+        _configure = nullptr;
+        _nodes.clear();
+        for (auto& slave : _slaves) {
+            slave->_workRange.store(0);
         }
+        _numStopped = 0;
+        runSlaves();
+        assert(_numStopped == (_numThreads - numThreads));
 
         // ...wait for threads to finish...
         slave = extraBegin;
@@ -181,6 +328,6 @@ void AudioMixerSlavePool::resize(int numThreads) {
         _slaves.erase(extraBegin, _slaves.end());
     }
 
-    _numThreads = _numStarted = _numFinished = numThreads;
+    _numThreads = numThreads;
     assert(_numThreads == (int)_slaves.size());
 }
@@ -12,14 +12,14 @@
 #ifndef hifi_AudioMixerSlavePool_h
 #define hifi_AudioMixerSlavePool_h
 
+#include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <vector>
 
 #include <QThread>
 
-#include <TBBHelpers.h>
-
 #include "AudioMixerSlave.h"
 
 class AudioMixerSlavePool;
@@ -29,10 +29,11 @@ class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     using ConstIter = NodeList::const_iterator;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
 
 public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData)
-        : AudioMixerSlave(sharedData), _pool(pool) {}
+    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData, int index)
+        : AudioMixerSlave(sharedData), _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -41,23 +42,42 @@ private:
 
     void wait();
     void notify(bool stopping);
+
+    // pop from the front of this thread's own work range
     bool try_pop(SharedNodePointer& node);
+    // steal from the back of another thread's work range
+    bool try_steal(SharedNodePointer& node);
+
+    void updateAffinity();
 
     AudioMixerSlavePool& _pool;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
+    const int _index;
+    bool _isPinned { false };
+
+    // [front, back) into the pool's node list, packed as (front << 32 | back) so that
+    // the owner and thieves can both claim work with a single compare-and-swap
+    std::atomic<uint64_t> _workRange { 0 };
+
+    // wake state, signalled once per run by the pool
+    Mutex _mutex;
+    ConditionVariable _condition;
+    unsigned int _runCount { 0 }; // guarded by _mutex
+    unsigned int _lastRunCount { 0 };
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
+//   Each run partitions the nodes across the slaves by estimated cost, slaves that run out of work steal from the others.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
 
 public:
     using ConstIter = NodeList::const_iterator;
+    using CostFunction = std::function<int(const SharedNodePointer& node)>;
 
     AudioMixerSlavePool(AudioMixerSlave::SharedData& sharedData, int numThreads = QThread::idealThreadCount())
         : _workerSharedData(sharedData) { setNumThreads(numThreads); }
@@ -75,29 +95,38 @@ public:
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
+    // pin each slave to its own core (Linux only)
+    void setPinThreads(bool pinThreads) { _pinThreads = pinThreads; }
+    bool getPinThreads() const { return _pinThreads; }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, CostFunction cost);
+    void partition(CostFunction cost);
+    void runSlaves();
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
 
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
+    friend bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node);
     friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend void AudioMixerSlaveThread::updateAffinity();
 
     // synchronization state
     Mutex _mutex;
-    ConditionVariable _slaveCondition;
     ConditionVariable _poolCondition;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node);
     std::function<void(AudioMixerSlave&)> _configure;
     int _numThreads { 0 };
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
+    std::atomic<int> _numFinished { 0 };
+    std::atomic<int> _numStopped { 0 };
+    bool _pinThreads { false };
 
     // frame state
-    Queue _queue;
+    std::vector<SharedNodePointer> _nodes; // grouped by slave, see AudioMixerSlaveThread::_workRange
+    std::vector<std::pair<int, int>> _costs; // scratch for partition, (cost, index into _nodes)
+    std::vector<SharedNodePointer> _partitioned; // scratch for partition
     ConstIter _begin;
     ConstIter _end;
 
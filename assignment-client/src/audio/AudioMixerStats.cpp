@@ -25,16 +25,27 @@ void AudioMixerStats::reset() {
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
+    farFieldMixes = 0;
+    farFieldSubmixes = 0;
+    farFieldRenders = 0;
+
     skippedToActive = 0;
     skippedToInactive = 0;
     inactiveToSkipped = 0;
     inactiveToActive = 0;
     activeToSkipped = 0;
     activeToInactive = 0;
+    culledToSkipped = 0;
+    toCulled = 0;
 
     skipped = 0;
     inactive = 0;
     active = 0;
+    culled = 0;
+
+    workTime = 0;
+    workItems = 0;
+    stolenItems = 0;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
@@ -55,16 +66,27 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
+    farFieldMixes += otherStats.farFieldMixes;
+    farFieldSubmixes += otherStats.farFieldSubmixes;
+    farFieldRenders += otherStats.farFieldRenders;
+
     skippedToActive += otherStats.skippedToActive;
     skippedToInactive += otherStats.skippedToInactive;
     inactiveToSkipped += otherStats.inactiveToSkipped;
     inactiveToActive += otherStats.inactiveToActive;
     activeToSkipped += otherStats.activeToSkipped;
     activeToInactive += otherStats.activeToInactive;
+    culledToSkipped += otherStats.culledToSkipped;
+    toCulled += otherStats.toCulled;
 
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
     active += otherStats.active;
+    culled += otherStats.culled;
+
+    workTime += otherStats.workTime;
+    workItems += otherStats.workItems;
+    stolenItems += otherStats.stolenItems;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
@@ -12,9 +12,7 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -30,16 +28,28 @@ struct AudioMixerStats {
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    int farFieldMixes { 0 };
+    int farFieldSubmixes { 0 };
+    int farFieldRenders { 0 };
+
     int skippedToActive { 0 };
     int skippedToInactive { 0 };
     int inactiveToSkipped { 0 };
     int inactiveToActive { 0 };
     int activeToSkipped { 0 };
     int activeToInactive { 0 };
+    int culledToSkipped { 0 };
+    int toCulled { 0 };
 
     int skipped { 0 };
     int inactive { 0 };
     int active { 0 };
+    int culled { 0 };
+
+    // slave thread load, kept per slave as well as accumulated
+    uint64_t workTime { 0 }; // usecs
+    int workItems { 0 };
+    int stolenItems { 0 };
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
@@ -0,0 +1,51 @@
+//
+//  AudioSpatialGrid.cpp
+//  assignment-client/src/audio
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSpatialGrid.h"
+
+#include <algorithm>
+
+#include <PositionalAudioStream.h>
+
+void AudioSpatialGrid::reset(float cellSize, int maxLoudestStreams) {
+    _grid.reset(cellSize);
+    _maxLoudestStreams = maxLoudestStreams;
+
+    _loudness.clear();
+    _loudestStreams.clear();
+}
+
+void AudioSpatialGrid::insert(const PositionalAudioStream* stream) {
+    if (isEnabled()) {
+        _grid.insert(stream->getPosition(), stream);
+    }
+
+    float loudness = stream->getLastPopOutputTrailingLoudness();
+    if (_maxLoudestStreams > 0 && loudness > 0.0f) {
+        _loudness.emplace_back(loudness, stream);
+    }
+}
+
+void AudioSpatialGrid::finalize() {
+    auto loudestEnd = _loudness.begin() + std::min((int)_loudness.size(), _maxLoudestStreams);
+    std::partial_sort(_loudness.begin(), loudestEnd, _loudness.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    for (auto it = _loudness.begin(); it != loudestEnd; ++it) {
+        _loudestStreams.push_back(it->second);
+    }
+}
+
+bool AudioSpatialGrid::isAmongLoudest(const PositionalAudioStream* stream, int numLoudest) const {
+    auto end = _loudestStreams.begin() + std::min((int)_loudestStreams.size(), numLoudest);
+    return std::find(_loudestStreams.begin(), end, stream) != end;
+}
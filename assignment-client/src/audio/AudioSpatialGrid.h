@@ -0,0 +1,58 @@
+//
+//  AudioSpatialGrid.h
+//  assignment-client/src/audio
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSpatialGrid_h
+#define hifi_AudioSpatialGrid_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <SpatialGrid.h>
+
+class PositionalAudioStream;
+
+// Uniform grid of the positional streams, built once per frame by the AudioMixer
+// and read concurrently by the slaves to find the streams audible from a listener.
+// The loudest streams are also kept, so they can be heard beyond the audible range.
+class AudioSpatialGrid {
+public:
+    // drop all streams, and start a new frame with the given cell size (in meters)
+    void reset(float cellSize, int maxLoudestStreams);
+
+    void insert(const PositionalAudioStream* stream);
+
+    // sort the loudest streams, must be called once all the streams are inserted
+    void finalize();
+
+    bool isEnabled() const { return _grid.isEnabled(); }
+
+    // calls functor for every stream in the cells touching the sphere, candidates may be out of range
+    template <typename F>
+    void forEachCandidate(const glm::vec3& center, float range, F functor) const {
+        _grid.forEachCandidate(center, range, functor);
+    }
+
+    // loudest streams of the frame, in decreasing order of loudness
+    const std::vector<const PositionalAudioStream*>& getLoudestStreams() const { return _loudestStreams; }
+
+    // true if stream is among the numLoudest loudest streams of the frame
+    bool isAmongLoudest(const PositionalAudioStream* stream, int numLoudest) const;
+
+private:
+    SpatialGrid<const PositionalAudioStream*> _grid;
+
+    int _maxLoudestStreams { 0 };
+    std::vector<std::pair<float, const PositionalAudioStream*>> _loudness;
+    std::vector<const PositionalAudioStream*> _loudestStreams;
+};
+
+#endif // hifi_AudioSpatialGrid_h
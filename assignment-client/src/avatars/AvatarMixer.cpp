@@ -11,6 +11,7 @@
 
 #include "AvatarMixer.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <chrono>
 #include <memory>
@@ -300,9 +301,15 @@ void AvatarMixer::start() {
         {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                // index the avatar positions once, for every slave to find the avatars around its nodes
                 auto start = usecTimestampNow();
-                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
+                buildAvatarGrid(cbegin, cend, frame);
                 auto end = usecTimestampNow();
+                _buildAvatarGridElapsedTime += (end - start);
+
+                start = end;
+                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
+                end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
@@ -336,6 +343,25 @@ void AvatarMixer::start() {
     }
 }
 
+void AvatarMixer::buildAvatarGrid(const NodeList::const_iterator& cbegin, const NodeList::const_iterator& cend,
+                                  unsigned int frame) {
+    // sweep every avatar to every destination about five times a second, however far it is
+    const int SWEEP_PERIOD_FRAMES = 9;
+
+    auto& avatarGrid = _slaveSharedData.avatarGrid;
+    avatarGrid.reset(_avatarCandidateRange, SWEEP_PERIOD_FRAMES, frame);
+    if (!avatarGrid.isEnabled()) {
+        return;
+    }
+
+    std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+        const AvatarMixerClientData* nodeData = reinterpret_cast<const AvatarMixerClientData*>(node->getLinkedData());
+        if (node->getType() == NodeType::Agent && nodeData) {
+            const MixerAvatar* avatar = nodeData->getConstAvatarData();
+            avatarGrid.insert(node.data(), avatar->getClientGlobalPosition(), avatar->getHasPriority());
+        }
+    });
+}
 
 // NOTE: nodeData->getAvatar() might be side effected, must be called when access to node/nodeData
 // is guaranteed to not be accessed by other thread
@@ -740,6 +766,7 @@ void AvatarMixer::sendStatsPacket() {
     QJsonObject singleCoreTasks;
     singleCoreTasks["processEvents"] = TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime);
     singleCoreTasks["queueIncomingPacket"] = TIGHT_LOOP_STAT_UINT64(_queueIncomingPacketElapsedTime);
+    singleCoreTasks["buildAvatarGrid"] = TIGHT_LOOP_STAT_UINT64(_buildAvatarGridElapsedTime);
 
     QJsonObject incomingPacketStats;
     incomingPacketStats["handleAvatarIdentityPacket"] = TIGHT_LOOP_STAT_UINT64(_handleAvatarIdentityPacketElapsedTime);
@@ -805,6 +832,12 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
 
+    float averageOthersCulled = averageNodes ? aggregateStats.numOthersCulled / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageOthersCulled"] = TIGHT_LOOP_STAT(averageOthersCulled);
+
+    float averageSharedEncodings = averageNodes ? aggregateStats.numSharedEncodings / averageNodes : 0.0f;
+    slavesAggregatObject["sent_9_averageSharedEncodings"] = TIGHT_LOOP_STAT(averageSharedEncodings);
+
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
     slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
@@ -869,6 +902,7 @@ void AvatarMixer::sendStatsPacket() {
     _broadcastAvatarDataLockWait = 0;
     _broadcastAvatarDataNodeTransform = 0;
     _broadcastAvatarDataNodeFunctor = 0;
+    _buildAvatarGridElapsedTime = 0;
 
     _displayNameManagementElapsedTime = 0;
     _ignoreCalculationElapsedTime = 0;
@@ -954,6 +988,12 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
     _maxKbpsPerNode = nodeBandwidthValue.toDouble(DEFAULT_NODE_SEND_BANDWIDTH) * KILO_PER_MEGA;
     qCDebug(avatars) << "The maximum send bandwidth per node is" << _maxKbpsPerNode << "kbps.";
 
+    const QString AVATAR_CANDIDATE_RANGE = "avatar_candidate_range";
+    _avatarCandidateRange = std::max((float)avatarMixerGroupObject[AVATAR_CANDIDATE_RANGE].toString().toDouble(), 0.0f);
+    if (_avatarCandidateRange > 0.0f) {
+        qCDebug(avatars) << "Avatars further than" << _avatarCandidateRange << "m from a node will be sent to it at a reduced rate.";
+    }
+
     const QString AUTO_THREADS = "auto_threads";
     bool autoThreads = avatarMixerGroupObject[AUTO_THREADS].toBool();
     if (!autoThreads) {
@@ -76,6 +76,8 @@ private:
 
     void setupEntityQuery();
 
+    void buildAvatarGrid(const NodeList::const_iterator& cbegin, const NodeList::const_iterator& cend, unsigned int frame);
+
     p_high_resolution_clock::time_point _lastFrameTimestamp;
 
     // Attach to entity tree for avatar-priority zone info.
@@ -91,6 +93,7 @@ private:
     int _sumIdentityPackets { 0 };
 
     float _maxKbpsPerNode = 0.0f;
+    float _avatarCandidateRange { 0.0f };
 
     float _domainMinimumHeight { MIN_AVATAR_HEIGHT };
     float _domainMaximumHeight { MAX_AVATAR_HEIGHT };
@@ -137,6 +140,7 @@ private:
     quint64 _processQueuedAvatarDataPacketsElapsedTime { 0 };
     quint64 _processQueuedAvatarDataPacketsLockWaitElapsedTime { 0 };
 
+    quint64 _buildAvatarGridElapsedTime { 0 };
     quint64 _processEventsElapsedTime { 0 };
     quint64 _sendStatsElapsedTime { 0 };
     quint64 _queueIncomingPacketElapsedTime { 0 };
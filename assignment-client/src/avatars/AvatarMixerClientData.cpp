@@ -46,21 +46,32 @@ void AvatarMixerClientData::setLastOtherAvatarEncodeTime(NLPacket::LocalID other
     }
 }
 
+uint64_t AvatarMixerClientData::getLastOtherAvatarEncodeToken(NLPacket::LocalID otherAvatar) const {
+    const auto itr = _lastOtherAvatarEncodeTokens.find(otherAvatar);
+    if (itr != _lastOtherAvatarEncodeTokens.end()) {
+        return itr->second;
+    }
+    return MixerAvatar::UNSHARED_TOKEN;
+}
+
 void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (!_packetQueue.node) {
-        _packetQueue.node = node;
+    // the slave is behind, avatar data is superseded by the next packet anyway
+    bool isDroppable = message->getType() == PacketType::AvatarData;
+    if (!_packetQueue.push({ message, node }, isDroppable)) {
+        ++_numDroppedPackets;
     }
-    _packetQueue.push(message);
 }
 
 int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData) {
     int packetsProcessed = 0;
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
 
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    QueuedPacket queuedPacket;
+    while (_packetQueue.pop(queuedPacket)) {
+        auto& packet = queuedPacket.message;
+        SharedNodePointer node = queuedPacket.node;
+        if (!node) {
+            continue;
+        }
 
         packetsProcessed++;
 
@@ -77,9 +88,7 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
             default:
                 Q_UNREACHABLE();
         }
-        _packetQueue.pop();
     }
-    assert(_packetQueue.empty());
 
     return packetsProcessed;
 }
@@ -446,6 +455,7 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
     jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
     jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
+    jsonObject["total_num_dropped_packets"] = (double)_numDroppedPackets;
 
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
     jsonObject[OUTBOUND_AVATAR_TRAITS_STATS_KEY] = getOutboundAvatarTraitsKbps();
@@ -471,4 +481,5 @@ void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLo
     removeLastBroadcastTime(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
+    _lastOtherAvatarEncodeTokens.erase(nodeLocalID);
 }
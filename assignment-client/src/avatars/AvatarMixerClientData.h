@@ -16,7 +16,6 @@
 #include <cfloat>
 #include <unordered_map>
 #include <vector>
-#include <queue>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QUrl>
@@ -28,6 +27,7 @@
 #include <udt/PacketHeaders.h>
 #include <PortableHighResolutionClock.h>
 #include <SimpleMovingAverage.h>
+#include <SPSCQueue.h>
 #include <UUIDHasher.h>
 #include <shared/ConicalViewFrustum.h>
 
@@ -128,8 +128,13 @@ public:
 
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
+    // token of the shared encoding that left the sent joints of the other avatar in their current state
+    uint64_t getLastOtherAvatarEncodeToken(NLPacket::LocalID otherAvatar) const;
+    void setLastOtherAvatarEncodeToken(NLPacket::LocalID otherAvatar, uint64_t token) { _lastOtherAvatarEncodeTokens[otherAvatar] = token; }
+
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
+    uint64_t getNumDroppedPackets() const { return _numDroppedPackets; }
 
     void processSetTraitsMessage(ReceivedMessage& message, const SlaveSharedData& slaveSharedData, Node& sendingNode);
     void processBulkAvatarTraitsAckMessage(ReceivedMessage& message);
@@ -159,10 +164,15 @@ public:
     void resetSentTraitData(Node::LocalID nodeID);
 
 private:
-    struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
+    struct QueuedPacket {
+        QSharedPointer<ReceivedMessage> message;
         QWeakPointer<Node> node;
     };
-    PacketQueue _packetQueue;
+
+    // filled by the network thread and drained by a slave, neither waits on the other
+    static const size_t PACKET_QUEUE_CAPACITY = 1024;
+    OverflowingSPSCQueue<QueuedPacket> _packetQueue { PACKET_QUEUE_CAPACITY };
+    std::atomic<uint64_t> _numDroppedPackets { 0 };
 
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
 
@@ -174,6 +184,7 @@ private:
     // sending to "this" node
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTokens;
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
@@ -281,31 +281,46 @@ AABox computeBubbleBox(const AvatarData& avatar, float bubbleExpansionFactor) {
     return box;
 }
 
-namespace {
-    class SortableAvatar : public PrioritySortUtil::Sortable {
-    public:
-        SortableAvatar() = delete;
-        SortableAvatar(const MixerAvatar* avatar, const Node* avatarNode, uint64_t lastEncodeTime)
-            : _avatar(avatar), _node(avatarNode), _lastEncodeTime(lastEncodeTime) {
-        }
-        glm::vec3 getPosition() const override { return _avatar->getClientGlobalPosition(); }
-        float getRadius() const override {
-            glm::vec3 nodeBoxScale = _avatar->getGlobalBoundingBox().getScale();
-            return 0.5f * glm::max(nodeBoxScale.x, glm::max(nodeBoxScale.y, nodeBoxScale.z));
-        }
-        uint64_t getTimestamp() const override {
-            return _lastEncodeTime;
-        }
-        const Node* getNode() const { return _node; }
-        const MixerAvatar* getAvatar() const { return _avatar; }
+glm::vec3 AvatarMixerSlave::SortableAvatar::getPosition() const {
+    return _avatar->getClientGlobalPosition();
+}
 
-    private:
-        const MixerAvatar* _avatar;
-        const Node* _node;
-        uint64_t _lastEncodeTime;
+float AvatarMixerSlave::SortableAvatar::getRadius() const {
+    glm::vec3 nodeBoxScale = _avatar->getGlobalBoundingBox().getScale();
+    return 0.5f * glm::max(nodeBoxScale.x, glm::max(nodeBoxScale.y, nodeBoxScale.z));
+}
+
+void AvatarMixerSlave::gatherCandidates(const AvatarMixerClientData* destinationNodeData) {
+    const auto& avatarGrid = _sharedData->avatarGrid;
+    const float range = avatarGrid.getRange();
+
+    _candidates.clear();
+    _candidates.insert(_candidates.end(), avatarGrid.getHeroes().begin(), avatarGrid.getHeroes().end());
+    _candidates.insert(_candidates.end(), avatarGrid.getSweptAvatars().begin(), avatarGrid.getSweptAvatars().end());
+
+    auto addCandidate = [&](Node* node) {
+        _candidates.push_back(node);
     };
 
-}  // Close anonymous namespace.
+    // search around the avatar, and around any camera that has wandered away from it
+    glm::vec3 destinationPosition = destinationNodeData->getAvatar().getClientGlobalPosition();
+    avatarGrid.forEachInRange(destinationPosition, range, addCandidate);
+
+    bool hasDetachedView = false;
+    for (const auto& view : destinationNodeData->getViewFrustums()) {
+        if (glm::distance(view.getPosition(), destinationPosition) > range) {
+            avatarGrid.forEachInRange(view.getPosition(), range, addCandidate);
+            hasDetachedView = true;
+        }
+    }
+
+    // gridded avatars within range of several search centers were added more than once
+    if (hasDetachedView) {
+        auto griddedBegin = _candidates.begin() + avatarGrid.getHeroes().size() + avatarGrid.getSweptAvatars().size();
+        std::sort(griddedBegin, _candidates.end());
+        _candidates.erase(std::unique(griddedBegin, _candidates.end()), _candidates.end());
+    }
+}
 
 void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node) {
     const float AVATAR_HERO_FRACTION { 0.4f };
@@ -370,25 +385,32 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     // prepare to sort
     const auto& cameraViews = destinationNodeData->getViewFrustums();
 
-    using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar>;
     // Keep two independent queues, one for heroes and one for the riff-raff.
-    enum PriorityVariants { kHero, kNonhero };
-    AvatarPriorityQueue avatarPriorityQueues[2] =
-    {
-        {cameraViews, AvatarData::_avatarSortCoefficientSize, 
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge},
-        {cameraViews, AvatarData::_avatarSortCoefficientSize,
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
-    };
+    // They are reused from one destination to the next, so only clear them.
+    for (auto& avatarPriorityQueue : _avatarPriorityQueues) {
+        avatarPriorityQueue.clear();
+        avatarPriorityQueue.setViews(cameraViews);
+        avatarPriorityQueue.setWeights(AvatarData::_avatarSortCoefficientSize,
+            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge);
+    }
 
-    avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+    // Only look at the avatars around the destination (plus the heroes and this frame's sweep)
+    // unless the PAL needs to hear about everyone.
+    const auto& avatarGrid = _sharedData->avatarGrid;
+    bool isCulling = avatarGrid.isEnabled() && !PALIsOpen && !PALWasOpen;
+    if (isCulling) {
+        gatherCandidates(destinationNodeData);
+        _stats.numOthersCulled += std::max(avatarGrid.getNumAvatars() - 1 - (int)_candidates.size(), 0);
+        _avatarPriorityQueues[kNonhero].reserve(_candidates.size());
+    } else {
+        _avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+    }
 
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
+    auto considerOtherNode = [&](Node* otherNodeRaw) {
         if (otherNodeRaw->getType() != NodeType::Agent
             || !otherNodeRaw->getLinkedData()
             || otherNodeRaw == destinationNode) {
-            continue;
+            return;
         }
 
         auto sourceAvatarNode = otherNodeRaw;
@@ -465,7 +487,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             const MixerAvatar* avatarNodeData = sourceAvatarNodeData->getConstAvatarData();
             auto lastEncodeTime = destinationNodeData->getLastOtherAvatarEncodeTime(sourceAvatarNode->getLocalID());
 
-            avatarPriorityQueues[avatarNodeData->getHasPriority() ? kHero : kNonhero].push(
+            _avatarPriorityQueues[avatarNodeData->getHasPriority() ? kHero : kNonhero].push(
                 SortableAvatar(avatarNodeData, sourceAvatarNode, lastEncodeTime));
         }
         
@@ -488,11 +510,19 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         }
 
         destinationNodeData->setPrevRequestsDomainListData(PALIsOpen);
+    };
+
+    if (isCulling) {
+        std::for_each(_candidates.begin(), _candidates.end(), considerOtherNode);
+    } else {
+        for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
+            considerOtherNode((*listedNode).data());
+        }
     }
 
     // loop through our sorted avatars and allocate our bandwidth to them accordingly
 
-    int remainingAvatars = (int)avatarPriorityQueues[kHero].size() + (int)avatarPriorityQueues[kNonhero].size();
+    int remainingAvatars = (int)_avatarPriorityQueues[kHero].size() + (int)_avatarPriorityQueues[kNonhero].size();
     auto traitsPacketList = NLPacketList::create(PacketType::BulkAvatarTraits, QByteArray(), true, true);
 
     auto avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
@@ -504,7 +534,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
     // Loop over two priorities - hero avatars then everyone else:
     for (PriorityVariants currentVariant = kHero; currentVariant <= kNonhero; ++((int&)currentVariant)) {
-        const auto& sortedAvatarVector = avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
+        const auto& sortedAvatarVector = _avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
         for (const auto& sortedAvatar : sortedAvatarVector) {
             const Node* sourceNode = sortedAvatar.getNode();
             auto lastEncodeForOther = sortedAvatar.getTimestamp();
@@ -563,29 +593,90 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
             const bool distanceAdjust = true;
             const bool dropFaceTracking = false;
-            AvatarDataPacket::SendStatus sendStatus;
-            sendStatus.sendUUID = true;
 
-            do {
+            // Destinations left in the same state by the same shared encoding last time (or never sent this
+            // source) get the same bytes for the same detail, as the source doesn't change while we broadcast.
+            uint64_t lastEncodeToken = destinationNodeData->getLastOtherAvatarEncodeToken(sourceNode->getLocalID());
+            if (lastEncodeToken == MixerAvatar::UNSHARED_TOKEN && lastEncodeForOther == 0 && lastSentJointsForOther.isEmpty()) {
+                lastEncodeToken = MixerAvatar::INITIAL_TOKEN;
+            }
+
+            bool didEncode = false;
+            auto encode = [&](MixerAvatar::EncodedData& encodedData) {
                 auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
+                AvatarDataPacket::SendStatus encodedStatus;
+                encodedStatus.sendUUID = true;
+                encodedData.sentJoints = lastSentJointsForOther;
+                encodedData.bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, encodedData.sentJoints,
+                    encodedStatus, dropFaceTracking, distanceAdjust, destinationPosition, &encodedData.sentJoints);
+                // PAL minimum data leaves the sent joints of each destination as they were, not shared
+                encodedData.token = detail == AvatarData::PALMinimum ?
+                    MixerAvatar::UNSHARED_TOKEN : MixerAvatar::nextEncodedDataToken();
                 auto endSerialize = chrono::high_resolution_clock::now();
                 _stats.toByteArrayElapsedTime +=
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+                didEncode = true;
+            };
+
+            // full updates and PAL minimum data don't depend on what the destination was sent before
+            const MixerAvatar::EncodedData* encodedData = nullptr;
+            if (detail == AvatarData::SendAllData || detail == AvatarData::PALMinimum) {
+                encodedData = &sourceAvatar->getEncodedData(_lastFrameTimestamp, detail, 0.0f,
+                                                            MixerAvatar::UNSHARED_TOKEN, encode);
+            } else if (detail == AvatarData::MinimumData && lastEncodeToken != MixerAvatar::UNSHARED_TOKEN) {
+                encodedData = &sourceAvatar->getEncodedData(_lastFrameTimestamp, detail, 0.0f, lastEncodeToken, encode);
+            } else if (detail == AvatarData::CullSmallData && lastEncodeToken != MixerAvatar::UNSHARED_TOKEN) {
+                float minRotationDOT = sourceAvatar->getDistanceBasedMinRotationDOT(destinationPosition);
+                encodedData = &sourceAvatar->getEncodedData(_lastFrameTimestamp, detail, minRotationDOT, lastEncodeToken, encode);
+            }
 
-                avatarPacket->write(bytes);
-                avatarSpaceAvailable -= bytes.size();
-                numAvatarDataBytes += bytes.size();
-                if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
-                    // Weren't able to fit everything.
+            if (encodedData && encodedData->bytes.size() <= avatarSpaceAvailable) {
+                if (!didEncode) {
+                    _stats.numSharedEncodings++;
+                }
+
+                avatarPacket->write(encodedData->bytes);
+                avatarSpaceAvailable -= encodedData->bytes.size();
+                numAvatarDataBytes += encodedData->bytes.size();
+                if (detail != AvatarData::PALMinimum) {
+                    lastSentJointsForOther = encodedData->sentJoints;
+                }
+                lastEncodeToken = encodedData->token;
+
+                if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
                     nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
                     ++numPacketsSent;
                     avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
                     avatarSpaceAvailable = avatarPacketCapacity;
                 }
-            } while (!sendStatus);
+            } else {
+                // encode for this destination alone, splitting the data over several packets if needed
+                AvatarDataPacket::SendStatus sendStatus;
+                sendStatus.sendUUID = true;
+
+                do {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        // Weren't able to fit everything.
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                } while (!sendStatus);
+
+                lastEncodeToken = MixerAvatar::UNSHARED_TOKEN;
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
@@ -600,6 +691,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 destinationNodeData->setLastBroadcastSequenceNumber(sourceNode->getLocalID(),
                     sourceNodeData->getLastReceivedSequenceNumber());
                 destinationNodeData->setLastOtherAvatarEncodeTime(sourceNode->getLocalID(), usecTimestampNow());
+                destinationNodeData->setLastOtherAvatarEncodeToken(sourceNode->getLocalID(), lastEncodeToken);
             }
 
             auto endAvatarDataPacking = chrono::high_resolution_clock::now();
@@ -616,7 +708,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
         if (currentVariant == kHero) {  // Dump any remaining heroes into the commoners.
             for (auto avIter = sortedAvatarVector.begin() + numAvatarsSent; avIter < sortedAvatarVector.end(); ++avIter) {
-                avatarPriorityQueues[kNonhero].push(*avIter);
+                _avatarPriorityQueues[kNonhero].push(*avIter);
             }
         }
     }
@@ -13,8 +13,12 @@
 #define hifi_AvatarMixerSlave_h
 
 #include <NodeList.h>
+#include <PrioritySortUtil.h>
+
+#include "AvatarSpatialGrid.h"
 
 class AvatarMixerClientData;
+class MixerAvatar;
 
 class AvatarMixerSlaveStats {
 public:
@@ -33,6 +37,8 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numOthersCulled { 0 };
+    int numSharedEncodings { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +65,8 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numOthersCulled = 0;
+        numSharedEncodings = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +91,8 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numOthersCulled += rhs.numOthersCulled;
+        numSharedEncodings += rhs.numSharedEncodings;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -100,6 +110,7 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    AvatarSpatialGrid avatarGrid;
 };
 
 class AvatarMixerSlave {
@@ -133,6 +144,30 @@ private:
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
 
+    // appends the avatars worth sorting for the destination to _candidates
+    void gatherCandidates(const AvatarMixerClientData* destinationNodeData);
+
+    class SortableAvatar : public PrioritySortUtil::Sortable {
+    public:
+        SortableAvatar() = delete;
+        SortableAvatar(const MixerAvatar* avatar, const Node* avatarNode, uint64_t lastEncodeTime)
+            : _avatar(avatar), _node(avatarNode), _lastEncodeTime(lastEncodeTime) {
+        }
+        glm::vec3 getPosition() const override;
+        float getRadius() const override;
+        uint64_t getTimestamp() const override {
+            return _lastEncodeTime;
+        }
+        const Node* getNode() const { return _node; }
+        const MixerAvatar* getAvatar() const { return _avatar; }
+
+    private:
+        const MixerAvatar* _avatar;
+        const Node* _node;
+        uint64_t _lastEncodeTime;
+    };
+    enum PriorityVariants { kHero, kNonhero };
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -143,6 +178,9 @@ private:
 
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
+
+    std::vector<Node*> _candidates;
+    PrioritySortUtil::PriorityQueue<SortableAvatar> _avatarPriorityQueues[2];
 };
 
 #endif // hifi_AvatarMixerSlave_h
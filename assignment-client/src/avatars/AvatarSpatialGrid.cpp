@@ -0,0 +1,39 @@
+//
+//  AvatarSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarSpatialGrid.h"
+
+#include <algorithm>
+
+#include <Node.h>
+
+void AvatarSpatialGrid::reset(float range, int sweepPeriod, unsigned int frame) {
+    _grid.reset(range);
+    _sweepPeriod = std::max(sweepPeriod, 1);
+    _frame = frame;
+    _numAvatars = 0;
+
+    _heroes.clear();
+    _swept.clear();
+}
+
+void AvatarSpatialGrid::insert(Node* node, const glm::vec3& position, bool isHero) {
+    ++_numAvatars;
+
+    if (isHero) {
+        _heroes.push_back(node);
+    } else if ((node->getLocalID() + _frame) % _sweepPeriod == 0) {
+        // spread the avatars over the sweep period by local ID
+        _swept.push_back(node);
+    } else {
+        _grid.insert(position, { node, position });
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  AvatarSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarSpatialGrid_h
+#define hifi_AvatarSpatialGrid_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <SpatialGrid.h>
+
+class Node;
+
+// Uniform grid of the agent avatars, built once per frame by the AvatarMixer and read
+// concurrently by the slaves to find the avatars worth sorting for a destination.
+//
+// Every avatar lands in exactly one of three sets: the heroes, which everyone considers,
+// the avatars swept this frame, which everyone considers too so that distant avatars
+// keep refreshing at a low rate, and the grid cells, which are only searched around
+// the destination.
+class AvatarSpatialGrid {
+public:
+    // drop all avatars, and start a new frame with the given range (in meters, 0 disables the grid)
+    void reset(float range, int sweepPeriod, unsigned int frame);
+
+    void insert(Node* node, const glm::vec3& position, bool isHero);
+
+    bool isEnabled() const { return _grid.isEnabled(); }
+    float getRange() const { return _grid.getCellSize(); }
+    int getNumAvatars() const { return _numAvatars; }
+
+    // calls functor for every gridded avatar within range of center
+    template <typename F>
+    void forEachInRange(const glm::vec3& center, float range, F functor) const;
+
+    const std::vector<Node*>& getHeroes() const { return _heroes; }
+    const std::vector<Node*>& getSweptAvatars() const { return _swept; }
+
+private:
+    struct Entry {
+        Node* node;
+        glm::vec3 position;
+    };
+
+    int _sweepPeriod { 1 };
+    unsigned int _frame { 0 };
+    int _numAvatars { 0 };
+
+    SpatialGrid<Entry> _grid;
+    std::vector<Node*> _heroes;
+    std::vector<Node*> _swept;
+};
+
+template <typename F>
+void AvatarSpatialGrid::forEachInRange(const glm::vec3& center, float range, F functor) const {
+    float range2 = range * range;
+    _grid.forEachCandidate(center, range, [&](const Entry& entry) {
+        if (glm::distance2(entry.position, center) <= range2) {
+            functor(entry.node);
+        }
+    });
+}
+
+#endif // hifi_AvatarSpatialGrid_h
@@ -15,14 +15,77 @@
 #ifndef hifi_MixerAvatar_h
 #define hifi_MixerAvatar_h
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+
 #include <AvatarData.h>
+#include <PortableHighResolutionClock.h>
 
 class MixerAvatar : public AvatarData {
 public:
+    // Avatar data encoded by toByteArray, shared by the destinations that start from the same state:
+    // the state they were left in by the encoding with the previous token, and the same rotation tolerance.
+    struct EncodedData {
+        AvatarDataDetail detail;
+        float minRotationDOT;
+        uint64_t previousToken;
+
+        uint64_t token;  // identifies the state the destinations are left in, 0 if they can't share it later
+        QByteArray bytes;
+        QVector<JointData> sentJoints;
+    };
+
+    using FrameTimestamp = p_high_resolution_clock::time_point;
+
+    // returns the encoding for this frame, calling encoder(EncodedData&) on the first request
+    template <typename F>
+    const EncodedData& getEncodedData(FrameTimestamp frame, AvatarDataDetail detail, float minRotationDOT,
+                                      uint64_t previousToken, F encoder) const;
+
+    using AvatarData::getDistanceBasedMinRotationDOT;
+
+    // tokens for the states no other destination can share, and for destinations that were never sent this avatar
+    static const uint64_t UNSHARED_TOKEN = 0;
+    static const uint64_t INITIAL_TOKEN = 1;
+
+    // unique across avatars, so a token survives its local ID being reused
+    static uint64_t nextEncodedDataToken() {
+        static std::atomic<uint64_t> lastToken { INITIAL_TOKEN };
+        return ++lastToken;
+    }
 
 private:
+    // encodings are only valid for a frame, the avatar doesn't change while the slaves broadcast
+    mutable std::mutex _encodedDataMutex;
+    mutable FrameTimestamp _encodedDataFrame;
+    mutable std::deque<EncodedData> _encodedData;
 };
 
+template <typename F>
+const MixerAvatar::EncodedData& MixerAvatar::getEncodedData(FrameTimestamp frame, AvatarDataDetail detail,
+                                                            float minRotationDOT, uint64_t previousToken,
+                                                            F encoder) const {
+    // slaves asking for the same encoding wait for the first one to finish it
+    std::lock_guard<std::mutex> lock(_encodedDataMutex);
+
+    if (frame != _encodedDataFrame) {
+        _encodedDataFrame = frame;
+        _encodedData.clear();
+    }
+
+    for (const auto& encodedData : _encodedData) {
+        if (encodedData.detail == detail && encodedData.minRotationDOT == minRotationDOT &&
+            encodedData.previousToken == previousToken) {
+            return encodedData;
+        }
+    }
+
+    _encodedData.push_back({ detail, minRotationDOT, previousToken, UNSHARED_TOKEN, QByteArray(), QVector<JointData>() });
+    encoder(_encodedData.back());
+    return _encodedData.back();
+}
+
 using MixerAvatarSharedPointer = std::shared_ptr<MixerAvatar>;
 
 #endif  // hifi_MixerAvatar_h
@@ -101,59 +101,63 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
-    if (viewFrustumChanged || _traversal.finished()) {
-        EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
-
-
-        DiffTraversal::View newView;
-        newView.viewFrustums = nodeData->getCurrentViews();
-
-        int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
-        newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
-        
-        startNewTraversal(newView, root, isFullScene);
-
-        // When the viewFrustum changed the sort order may be incorrect, so we re-sort
-        // and also use the opportunity to cull anything no longer in view
-        if (viewFrustumChanged && !_sendQueue.empty()) {
-            EntityPriorityQueue prevSendQueue;
-            std::swap(_sendQueue, prevSendQueue);
-            assert(_sendQueue.empty());
-
-            // Re-add elements from previous traversal if they still need to be sent
-            while (!prevSendQueue.empty()) {
-                EntityItemPointer entity = prevSendQueue.top().getEntity();
-                bool forceRemove = prevSendQueue.top().shouldForceRemove();
-                prevSendQueue.pop();
-                if (entity) {
-                    float priority = PrioritizedEntity::DO_NOT_SEND;
+    // Only the traversal needs the tree locked. It queues (weak) pointers to the entities it finds, and those
+    // are encoded and sent below without holding up the edits, since each entity guards its own properties.
+    _myServer->getOctree()->withReadLock([&] {
+        if (viewFrustumChanged || _traversal.finished()) {
+            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
-                    if (forceRemove) {
-                        priority = PrioritizedEntity::FORCE_REMOVE;
-                    } else {
-                        const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
-                    }
 
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority, forceRemove);
+            DiffTraversal::View newView;
+            newView.viewFrustums = nodeData->getCurrentViews();
+
+            int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
+            newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
+
+            startNewTraversal(newView, root, isFullScene);
+
+            // When the viewFrustum changed the sort order may be incorrect, so we re-sort
+            // and also use the opportunity to cull anything no longer in view
+            if (viewFrustumChanged && !_sendQueue.empty()) {
+                EntityPriorityQueue prevSendQueue;
+                std::swap(_sendQueue, prevSendQueue);
+                assert(_sendQueue.empty());
+
+                // Re-add elements from previous traversal if they still need to be sent
+                while (!prevSendQueue.empty()) {
+                    EntityItemPointer entity = prevSendQueue.top().getEntity();
+                    bool forceRemove = prevSendQueue.top().shouldForceRemove();
+                    prevSendQueue.pop();
+                    if (entity) {
+                        float priority = PrioritizedEntity::DO_NOT_SEND;
+
+                        if (forceRemove) {
+                            priority = PrioritizedEntity::FORCE_REMOVE;
+                        } else {
+                            const auto& view = _traversal.getCurrentView();
+                            priority = view.computePriority(entity);
+                        }
+
+                        if (priority != PrioritizedEntity::DO_NOT_SEND) {
+                            _sendQueue.emplace(entity, priority, forceRemove);
+                        }
                     }
                 }
             }
         }
-    }
 
-    if (!_traversal.finished()) {
-        quint64 startTime = usecTimestampNow();
+        if (!_traversal.finished()) {
+            quint64 startTime = usecTimestampNow();
 
-        #ifdef DEBUG
-        const uint64_t TIME_BUDGET = 400; // usec
-        #else
-        const uint64_t TIME_BUDGET = 200; // usec
-        #endif
-        _traversal.traverse(TIME_BUDGET);
-        OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
-    }
+            #ifdef DEBUG
+            const uint64_t TIME_BUDGET = 400; // usec
+            #else
+            const uint64_t TIME_BUDGET = 200; // usec
+            #endif
+            _traversal.traverse(TIME_BUDGET);
+            OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
+        }
+    });
 
     bool sendComplete = OctreeSendThread::traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
 
@@ -333,12 +337,14 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
         _packetData.appendValue(zeroByte); // colors
         if (params.includeExistsBits) {
             uint8_t childrenExistBits = 0;
-            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
-            for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
-                if (root->getChildAtIndex(i)) {
-                    childrenExistBits += (1 << i);
+            _myServer->getOctree()->withReadLock([&] {
+                EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
+                for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+                    if (root->getChildAtIndex(i)) {
+                        childrenExistBits += (1 << i);
+                    }
                 }
-            }
+            });
             _packetData.appendValue(childrenExistBits); // childrenInTreeMask
         }
         _packetData.appendValue(zeroByte); // childrenInBufferMask
@@ -38,6 +38,10 @@ public:
 
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    /// Sends this interval's packets to the client, returns false once the client is gone.
+    /// Called by process() when running on a dedicated thread, or by the OctreeSendThreadPool.
+    bool sendPass();
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -0,0 +1,165 @@
+//
+//  OctreeSendThreadPool.cpp
+//  assignment-client/src/octree
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendThreadPool.h"
+
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+#include <PerfStat.h>
+#include <SharedUtil.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+OctreeSendThreadPool::~OctreeSendThreadPool() {
+    stop();
+}
+
+void OctreeSendThreadPool::start(int numWorkers) {
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back(new Worker());
+        _workers.back()->setObjectName(QString("Octree Send Pool %1").arg(i));
+        _workers.back()->start();
+    }
+}
+
+void OctreeSendThreadPool::stop() {
+    for (auto& worker : _workers) {
+        worker->stop();
+    }
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+    _workers.clear();
+    _assignments.clear();
+}
+
+void OctreeSendThreadPool::add(OctreeSendThread* sendThread) {
+    if (_workers.empty()) {
+        return;
+    }
+
+    Worker* worker;
+    {
+        // the worker with the fewest clients gets the new one
+        std::lock_guard<std::mutex> lock(_mutex);
+        worker = std::min_element(_workers.begin(), _workers.end(), [](const std::unique_ptr<Worker>& left, const std::unique_ptr<Worker>& right) {
+            return left->getNumClients() < right->getNumClients();
+        })->get();
+        _assignments[sendThread] = worker;
+    }
+
+    // the client lives on its worker's thread, so that its queued slots don't race with its passes
+    sendThread->moveToThread(worker);
+    worker->add(sendThread);
+}
+
+void OctreeSendThreadPool::release(OctreeSendThread* sendThread) {
+    Worker* worker = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _assignments.find(sendThread);
+        if (it != _assignments.end()) {
+            worker = it->second;
+            _assignments.erase(it);
+        }
+    }
+
+    if (worker) {
+        worker->release(sendThread);
+    } else {
+        delete sendThread;
+    }
+}
+
+void OctreeSendThreadPool::Worker::add(OctreeSendThread* sendThread) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _clients.push_back({ sendThread, usecTimestampNow() });
+    _wake.notify_one();
+}
+
+void OctreeSendThreadPool::Worker::release(OctreeSendThread* sendThread) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _released.push_back(sendThread);
+    _wake.notify_one();
+}
+
+void OctreeSendThreadPool::Worker::stop() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+    _wake.notify_one();
+}
+
+size_t OctreeSendThreadPool::Worker::getNumClients() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _clients.size();
+}
+
+void OctreeSendThreadPool::Worker::deleteReleased() {
+    for (auto sendThread : _released) {
+        _clients.erase(std::remove_if(_clients.begin(), _clients.end(), [&](const Client& client) {
+            return client.sendThread == sendThread;
+        }), _clients.end());
+        delete sendThread;
+    }
+    _released.clear();
+}
+
+void OctreeSendThreadPool::Worker::run() {
+    // clients are only ever deleted from this thread, so they can be used without holding the lock
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop) {
+        lock.unlock();
+        QCoreApplication::processEvents();
+        lock.lock();
+        deleteReleased();
+
+        auto next = std::min_element(_clients.begin(), _clients.end(), [](const Client& left, const Client& right) {
+            return left.deadline < right.deadline;
+        });
+
+        quint64 now = usecTimestampNow();
+        if (next == _clients.end() || next->deadline > now) {
+            PerformanceWarning warn(false, "OctreeSendThreadPool... wait()", false,
+                                    &OctreeSendThread::_usleepTime, &OctreeSendThread::_usleepCalls);
+            if (next == _clients.end()) {
+                _wake.wait(lock);
+            } else {
+                _wake.wait_for(lock, std::chrono::microseconds(next->deadline - now));
+            }
+            continue;
+        }
+
+        OctreeSendThread* sendThread = next->sendThread;
+        lock.unlock();
+        bool keepSending = sendThread->sendPass();
+        lock.lock();
+
+        // clients may have been added meanwhile, so look it up again
+        next = std::find_if(_clients.begin(), _clients.end(), [&](const Client& client) {
+            return client.sendThread == sendThread;
+        });
+        if (keepSending) {
+            // same pacing as a dedicated thread sleeping out the rest of its interval
+            next->deadline = std::max(now + OCTREE_SEND_INTERVAL_USECS, usecTimestampNow());
+        } else {
+            // the server releases it back to us once it has heard
+            _clients.erase(next);
+            emit sendThread->finished();
+        }
+    }
+
+    // the clients that weren't released are still owned by the server
+    deleteReleased();
+    _clients.clear();
+}
@@ -0,0 +1,78 @@
+//
+//  OctreeSendThreadPool.h
+//  assignment-client/src/octree
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendThreadPool_h
+#define hifi_OctreeSendThreadPool_h
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QThread>
+
+class OctreeSendThread;
+
+// Runs the send passes of all the clients on a fixed number of threads, instead of a thread per client.
+//
+// Each client is pinned to one worker, and lives on that worker's thread so that its queued slots are
+// delivered in between its send passes, as they were on its own thread. A worker always runs the client
+// whose next pass is due first.
+class OctreeSendThreadPool {
+public:
+    OctreeSendThreadPool() = default;
+    ~OctreeSendThreadPool();
+
+    void start(int numWorkers);
+    void stop(); // deletes the released clients, and waits for the workers to exit
+
+    // schedules the first pass of the client right away
+    void add(OctreeSendThread* sendThread);
+
+    // the pool takes ownership of the client, and deletes it from its worker's thread once it is not running
+    void release(OctreeSendThread* sendThread);
+
+    int getNumWorkers() const { return (int)_workers.size(); }
+
+private:
+    class Worker : public QThread {
+    public:
+        void add(OctreeSendThread* sendThread);
+        void release(OctreeSendThread* sendThread);
+        void stop();
+        size_t getNumClients();
+
+    protected:
+        void run() override;
+
+    private:
+        void deleteReleased();
+
+        struct Client {
+            OctreeSendThread* sendThread;
+            quint64 deadline;
+        };
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::vector<Client> _clients;
+        std::vector<OctreeSendThread*> _released;
+        bool _stop { false };
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    std::mutex _mutex;
+    std::unordered_map<OctreeSendThread*, Worker*> _assignments;
+};
+
+#endif // hifi_OctreeSendThreadPool_h
@@ -878,16 +878,30 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+
+    // the sends of all the clients share a fixed number of threads
+    if (_sendPool.getNumWorkers() == 0) {
+        _sendPool.start(std::max(QThread::idealThreadCount(), 1));
+    }
+    sendThread->initialize(false);
+    _sendPool.add(sendThread.get());
 
     return sendThread;
 }
 
+void OctreeServer::releaseSendThread(SendThreads::iterator it) {
+    // the pool deletes it once it is done with it
+    _sendPool.release(it->second.release());
+    _sendThreads.erase(it);
+}
+
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
-        // This deletes the unique_ptr, so sendThread is destructed after that line
-        _sendThreads.erase(sendThread->getNodeUuid());
+        auto it = _sendThreads.find(sendThread->getNodeUuid());
+        if (it != _sendThreads.end() && it->second.get() == sendThread) {
+            releaseSendThread(it);
+        }
     }
 }
 
@@ -902,7 +916,7 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
-            _sendThreads.erase(it); // Remove right away and wait on thread to be
+            releaseSendThread(it); // Remove right away and let the pool delete it
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         }
@@ -1047,7 +1061,13 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
+        // JSON stays the default, the binary format is faster to save and load but only readable by this version
         _persistAsFileType = "json.gz";
+        QString persistFileType;
+        if (readOptionString("persistFileType", settingsSectionObject, persistFileType) && persistFileType == "bin") {
+            _persistAsFileType = persistFileType;
+        }
+        qDebug() << "persistFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1058,6 +1078,9 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistInterval=" << _persistInterval.count();
 
+        readOptionBool(QString("persistJournal"), settingsSectionObject, _persistJournal);
+        qDebug() << "persistJournal=" << _persistJournal;
+
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
@@ -1186,7 +1209,7 @@ void OctreeServer::domainSettingsRequestComplete() {
 
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
-                                                 _persistAsFileType);
+                                                 _persistAsFileType, _persistJournal);
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, &OctreePersistThread::start);
@@ -1294,9 +1317,11 @@ void OctreeServer::aboutToFinish() {
         sendThread.setIsShuttingDown();
     }
 
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
-    _sendThreads.clear(); // Cleans up all the send threads.
+    // Hand all the send threads back to the pool, which deletes them once their workers are done with them
+    while (!_sendThreads.empty()) {
+        releaseSendThread(_sendThreads.begin());
+    }
+    _sendPool.stop();
 
     if (_persistManager) {
         _persistThread.quit();
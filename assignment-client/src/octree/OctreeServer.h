@@ -24,6 +24,7 @@
 
 #include "OctreePersistThread.h"
 #include "OctreeSendThread.h"
+#include "OctreeSendThreadPool.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
 
@@ -165,6 +166,7 @@ protected:
     void beginRunning();
     
     UniqueSendThread createSendThread(const SharedNodePointer& node);
+    void releaseSendThread(SendThreads::iterator it);
     virtual UniqueSendThread newSendThread(const SharedNodePointer& node) = 0;
 
     int _argc;
@@ -194,6 +196,7 @@ protected:
     QThread _persistThread;
 
     std::chrono::milliseconds _persistInterval;
+    bool _persistJournal { false };
     bool _persistFileDownload;
     int _maxBackupVersions;
 
@@ -202,6 +205,7 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    OctreeSendThreadPool _sendPool;
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
@@ -381,10 +381,15 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         return;
     }
 
+    // Several mappings can point to the same asset, only add it to the zip once
+    std::set<AssetUtils::AssetHash> hashes;
     for (const auto& mapping : it->mappings) {
-        const auto& hash = mapping.second;
+        hashes.insert(mapping.second);
+    }
 
-        QDir assetsDir { _assetsDirectory };
+    static const qint64 COPY_CHUNK_SIZE = 1024 * 1024;
+    QDir assetsDir { _assetsDirectory };
+    for (const auto& hash : hashes) {
         QFile file { assetsDir.filePath(hash) };
         if (!file.open(QFile::ReadOnly)) {
             qCCritical(asset_backup) << "Could not open asset file" << file.fileName();
@@ -396,7 +401,14 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
             qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
             continue;
         }
-        zipFile.write(file.readAll());
+        // copy in chunks rather than holding whole assets in memory
+        while (!file.atEnd()) {
+            auto chunk = file.read(COPY_CHUNK_SIZE);
+            if (chunk.isEmpty() || zipFile.write(chunk) != chunk.size()) {
+                qCCritical(asset_backup) << "Could not copy asset file" << file.fileName() << "to zip";
+                break;
+            }
+        }
         zipFile.close();
         if (zipFile.getZipError() != UNZ_OK) {
             qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
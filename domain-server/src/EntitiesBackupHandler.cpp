@@ -11,7 +11,11 @@
 
 #include "EntitiesBackupHandler.h"
 
+#include <set>
+
 #include <QDebug>
+#include <QDir>
+#include <QSaveFile>
 
 #if !defined(__clang__) && defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -25,51 +29,121 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <AssetUtils.h>
 #include <OctreeDataUtils.h>
 
-EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath) :
+static const QString ENTITIES_DIR { "/entities/" };
+static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+static const QString ENTITIES_HASH_FILENAME = "models.json.gz.sha256";
+
+// zip method for files that are already compressed, deflating them again only costs time
+static const int ZIP_METHOD_STORED = 0;
+
+EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath,
+                                             const QString& backupDirectory) :
     _entitiesFilePath(entitiesFilePath),
-    _entitiesReplacementFilePath(entitiesReplacementFilePath)
+    _entitiesReplacementFilePath(entitiesReplacementFilePath),
+    _entitiesDirectory(backupDirectory + ENTITIES_DIR)
 {
+    // Make sure the entities directory exists.
+    QDir(_entitiesDirectory).mkpath(".");
 }
 
-static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+static bool readZipFile(QuaZip& zip, const QString& fileName, QByteArray& data) {
+    if (!zip.setCurrentFile(fileName)) {
+        return false;
+    }
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open" << fileName << "in backup";
+        return false;
+    }
+    data = zipFile.readAll();
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to unzip " << fileName << ": " << zipFile.getZipError();
+        return false;
+    }
+    return true;
+}
+
+static bool writeZipFile(QuaZip& zip, const QuaZipNewInfo& info, const QByteArray& data, int method = Z_DEFLATED) {
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::WriteOnly, info, nullptr, 0, method)) {
+        qCritical().nospace() << "Failed to open " << info.name << " for writing in zip";
+        return false;
+    }
+    if (zipFile.write(data) != data.size()) {
+        qCritical() << "Failed to write" << info.name << "to backup";
+        zipFile.close();
+        return false;
+    }
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to zip " << info.name << ": " << zipFile.getZipError();
+        return false;
+    }
+    return true;
+}
+
+void EntitiesBackupHandler::loadBackup(const QString& backupName, QuaZip& zip) {
+    QByteArray hash;
+    if (!readZipFile(zip, ENTITIES_HASH_FILENAME, hash)) {
+        // a full backup, or one from before the entities were stored by hash
+        return;
+    }
+
+    if (!AssetUtils::isValidHash(hash) || !QFile::exists(_entitiesDirectory + hash)) {
+        qCritical() << "Missing entities" << hash << "for backup" << backupName;
+        hash.clear();
+    }
+    _backups[backupName] = hash;
+}
+
+void EntitiesBackupHandler::loadingComplete() {
+    deleteUnusedEntitiesFiles();
+}
 
 void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     QFile entitiesFile { _entitiesFilePath };
-
-    if (entitiesFile.open(QIODevice::ReadOnly)) {
-        QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
-            qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
-            return;
-        }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
-            qCritical() << "Failed to write entities file to backup";
-            zipFile.close();
+    if (!entitiesFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    auto entityData = entitiesFile.readAll();
+
+    // backups of the same entities share the file
+    QString hash = AssetUtils::hashData(entityData).toHex();
+    QString storedFilePath = _entitiesDirectory + hash;
+    if (!QFile::exists(storedFilePath)) {
+        QSaveFile storedFile { storedFilePath };
+        if (!storedFile.open(QIODevice::WriteOnly) || storedFile.write(entityData) != entityData.size() ||
+            !storedFile.commit()) {
+            qCritical() << "Failed to write entities file to backup:" << storedFilePath;
             return;
         }
-        zipFile.close();
-        if (zipFile.getZipError() != UNZ_OK) {
-            qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
-        }
+    }
+
+    if (writeZipFile(zip, QuaZipNewInfo(ENTITIES_HASH_FILENAME), hash.toUtf8())) {
+        _backups[backupName] = hash;
     }
 }
 
 void EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip) {
-    if (!zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
+    QByteArray rawData;
+    QByteArray hash;
+    if (readZipFile(zip, ENTITIES_BACKUP_FILENAME, rawData)) {
+        // full backups carry the entities themselves
+    } else if (readZipFile(zip, ENTITIES_HASH_FILENAME, hash)) {
+        QFile storedFile { _entitiesDirectory + hash };
+        if (!AssetUtils::isValidHash(hash) || !storedFile.open(QIODevice::ReadOnly)) {
+            qCritical() << "Failed to find entities" << hash << "while recovering backup";
+            return;
+        }
+        rawData = storedFile.readAll();
+    } else {
         qWarning() << "Failed to find" << ENTITIES_BACKUP_FILENAME << "while recovering backup";
         return;
     }
-    QuaZipFile zipFile { &zip };
-    if (!zipFile.open(QIODevice::ReadOnly)) {
-        qCritical() << "Failed to open" << ENTITIES_BACKUP_FILENAME << "in backup";
-        return;
-    }
-    auto rawData = zipFile.readAll();
-
-    zipFile.close();
 
     OctreeUtils::RawEntityData data;
     if (!data.readOctreeDataInfoFromData(rawData)) {
@@ -79,14 +153,56 @@ void EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip
 
     data.resetIdAndVersion();
 
-    if (zipFile.getZipError() != UNZ_OK) {
-        qCritical().nospace() << "Failed to unzip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
-        return;
-    }
-
     QFile entitiesFile { _entitiesReplacementFilePath };
 
     if (entitiesFile.open(QIODevice::WriteOnly)) {
         entitiesFile.write(data.toGzippedByteArray());
     }
 }
+
+void EntitiesBackupHandler::deleteBackup(const QString& backupName) {
+    if (_backups.erase(backupName) > 0) {
+        deleteUnusedEntitiesFiles();
+    }
+}
+
+void EntitiesBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
+    auto it = _backups.find(backupName);
+    if (it == _backups.end()) {
+        // already a full backup
+        return;
+    }
+
+    QString storedFilePath = _entitiesDirectory + it->second;
+    QFile storedFile { storedFilePath };
+    if (it->second.isEmpty() || !storedFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Could not open entities file" << storedFilePath;
+        return;
+    }
+    writeZipFile(zip, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, storedFilePath), storedFile.readAll(), ZIP_METHOD_STORED);
+}
+
+bool EntitiesBackupHandler::isCorruptedBackup(const QString& backupName) {
+    auto it = _backups.find(backupName);
+    return it != _backups.end() && it->second.isEmpty();
+}
+
+void EntitiesBackupHandler::deleteUnusedEntitiesFiles() {
+    std::set<QString> usedHashes;
+    for (const auto& backup : _backups) {
+        if (backup.second.isEmpty()) {
+            qWarning() << "Some backups did not load properly, not deleting unused entities files for safety.";
+            return;
+        }
+        usedHashes.insert(backup.second);
+    }
+
+    QDir entitiesDir { _entitiesDirectory };
+    for (const auto& hash : entitiesDir.entryList(QDir::Files)) {
+        if (AssetUtils::isValidHash(hash) && usedHashes.find(hash) == usedHashes.end()) {
+            if (!entitiesDir.remove(hash)) {
+                qWarning() << "Could not delete entities file:" << hash;
+            }
+        }
+    }
+}
@@ -12,36 +12,46 @@
 #ifndef hifi_EntitiesBackupHandler_h
 #define hifi_EntitiesBackupHandler_h
 
+#include <map>
+
+#include <QString>
+
 #include "BackupHandler.h"
 
 class EntitiesBackupHandler : public BackupHandlerInterface {
 public:
-    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath);
+    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath, const QString& backupDirectory);
 
     std::pair<bool, float> isAvailable(const QString& backupName) override { return { true, 1.0f }; }
     std::pair<bool, float> getRecoveryStatus() override { return { false, 1.0f }; }
 
-    void loadBackup(const QString& backupName, QuaZip& zip) override {}
+    void loadBackup(const QString& backupName, QuaZip& zip) override;
 
-    void loadingComplete() override {}
+    void loadingComplete() override;
 
-    // Create a skeleton backup
+    // Create a skeleton backup, the entities are stored once by hash next to the backups
     void createBackup(const QString& backupName, QuaZip& zip) override;
 
-    // Recover from a full backup
+    // Recover from a full or skeleton backup
     void recoverBackup(const QString& backupName, QuaZip& zip) override;
 
     // Delete a skeleton backup
-    void deleteBackup(const QString& backupName) override {}
+    void deleteBackup(const QString& backupName) override;
 
     // Create a full backup
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override {}
+    void consolidateBackup(const QString& backupName, QuaZip& zip) override;
 
-    bool isCorruptedBackup(const QString& backupName) override { return false; }
+    bool isCorruptedBackup(const QString& backupName) override;
 
 private:
+    void deleteUnusedEntitiesFiles();
+
     QString _entitiesFilePath;
     QString _entitiesReplacementFilePath;
+    QString _entitiesDirectory;
+
+    // hash of the entities in each skeleton backup, the corrupted ones have an empty hash
+    std::map<QString, QString> _backups;
 };
 
 #endif /* hifi_EntitiesBackupHandler_h */
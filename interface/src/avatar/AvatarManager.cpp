@@ -217,42 +217,18 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     PerformanceTimer perfTimer("otherAvatars");
 
-    class SortableAvatar: public PrioritySortUtil::Sortable {
-    public:
-        SortableAvatar() = delete;
-        SortableAvatar(const std::shared_ptr<Avatar>& avatar) : _avatar(avatar) {}
-        glm::vec3 getPosition() const override { return _avatar->getWorldPosition(); }
-        float getRadius() const override { return _avatar->getBoundingRadius(); }
-        uint64_t getTimestamp() const override { return _avatar->getLastRenderUpdateTime(); }
-        std::shared_ptr<Avatar> getAvatar() const { return _avatar; }
-    private:
-        std::shared_ptr<Avatar> _avatar;
-    };
-
     auto avatarMap = getHashCopy();
 
     const auto& views = qApp->getConicalViews();
-    // Prepare 2 queues for heros and for crowd avatars
-    using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar>;
-    // Keep two independent queues, one for heroes and one for the riff-raff.
-    enum PriorityVariants
-    {
-        kHero = 0,
-        kNonHero,
-        NumVariants
-    };
-    AvatarPriorityQueue avatarPriorityQueues[NumVariants] = {
-             { views,
-               AvatarData::_avatarSortCoefficientSize,
-               AvatarData::_avatarSortCoefficientCenter,
-               AvatarData::_avatarSortCoefficientAge },
-             { views,
-               AvatarData::_avatarSortCoefficientSize,
-               AvatarData::_avatarSortCoefficientCenter,
-               AvatarData::_avatarSortCoefficientAge } };
+    for (auto& priorityQueue : _avatarPriorityQueues) {
+        priorityQueue.setViews(views);
+        priorityQueue.setWeights(AvatarData::_avatarSortCoefficientSize,
+                                 AvatarData::_avatarSortCoefficientCenter,
+                                 AvatarData::_avatarSortCoefficientAge);
+    }
     // Reserve space
-    //avatarPriorityQueues[kHero].reserve(10);  // just few
-    avatarPriorityQueues[kNonHero].reserve(avatarMap.size() - 1);  // don't include MyAvatar
+    //_avatarPriorityQueues[kHero].reserve(10);  // just few
+    _avatarPriorityQueues[kNonHero].reserve(avatarMap.size() - 1);  // don't include MyAvatar
 
     // Build vector and compute priorities
     auto nodeList = DependencyManager::get<NodeList>();
@@ -263,15 +239,15 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         // DO NOT update or fade out uninitialized Avatars
         if (avatar != _myAvatar && avatar->isInitialized() && !nodeList->isPersonalMutingNode(avatar->getID())) {
             if (avatar->getHasPriority()) {
-                avatarPriorityQueues[kHero].push(SortableAvatar(avatar));
+                _avatarPriorityQueues[kHero].push(SortableAvatar(avatar));
             } else {
-                avatarPriorityQueues[kNonHero].push(SortableAvatar(avatar));
+                _avatarPriorityQueues[kNonHero].push(SortableAvatar(avatar));
             }
         }
         ++itr;
     }
 
-    _numHeroAvatars = (int)avatarPriorityQueues[kHero].size();
+    _numHeroAvatars = (int)_avatarPriorityQueues[kHero].size();
 
     // process in sorted order
     uint64_t startTime = usecTimestampNow();
@@ -287,7 +263,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     workload::Transaction workloadTransaction;
  
     for (int p = kHero; p < NumVariants; p++) {
-        auto& priorityQueue = avatarPriorityQueues[p];
+        auto& priorityQueue = _avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
         const auto& sortedAvatarVector = priorityQueue.getSortedVector();
 
@@ -345,7 +321,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     // Hero,
                     // --> put them back in the non hero queue
 
-                    auto& crowdQueue = avatarPriorityQueues[kNonHero];
+                    auto& crowdQueue = _avatarPriorityQueues[kNonHero];
                     while (it != sortedAvatarVector.end()) {
                         crowdQueue.push(SortableAvatar((*it).getAvatar()));
                         ++it;
@@ -366,6 +342,9 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             }
         }
 
+        // don't keep the avatars alive until the next frame
+        priorityQueue.clear();
+
         if (p == kHero) {
             numHerosUpdated = numAvatarsUpdated;
         }
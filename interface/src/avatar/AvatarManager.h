@@ -21,6 +21,7 @@
 #include <AvatarHashMap.h>
 #include <PhysicsEngine.h>
 #include <PIDController.h>
+#include <PrioritySortUtil.h>
 #include <SimpleMovingAverage.h>
 #include <shared/RateCounter.h>
 #include <avatars-renderer/ScriptAvatar.h>
@@ -255,6 +256,27 @@ private:
     std::vector<int32_t> _spaceProxiesToDelete;
 
     AvatarTransit::TransitConfig  _transitConfig;
+
+    class SortableAvatar: public PrioritySortUtil::Sortable {
+    public:
+        SortableAvatar() = delete;
+        SortableAvatar(const std::shared_ptr<Avatar>& avatar) : _avatar(avatar) {}
+        glm::vec3 getPosition() const override { return _avatar->getWorldPosition(); }
+        float getRadius() const override { return _avatar->getBoundingRadius(); }
+        uint64_t getTimestamp() const override { return _avatar->getLastRenderUpdateTime(); }
+        std::shared_ptr<Avatar> getAvatar() const { return _avatar; }
+    private:
+        std::shared_ptr<Avatar> _avatar;
+    };
+
+    // Keep two independent queues, one for heroes and one for the riff-raff,
+    // reused from frame to frame to keep their storage
+    enum PriorityVariants {
+        kHero = 0,
+        kNonHero,
+        NumVariants
+    };
+    PrioritySortUtil::PriorityQueue<SortableAvatar> _avatarPriorityQueues[NumVariants];
 };
 
 #endif // hifi_AvatarManager_h
@@ -276,6 +276,47 @@ static void FIR_1x4_SSE(float* src, float* dst0, float* dst1, float* dst2, float
     }
 }
 
+// 1 channel input, 2 channel output
+static void FIR_1x2_SSE(float* src, float* dst0, float* dst1, float coef[2][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            __m128 x0 = _mm_loadu_ps(&ps[k+0]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-0]), x0));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-0]), x0));
+
+            __m128 x1 = _mm_loadu_ps(&ps[k+1]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-1]), x1));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-1]), x1));
+
+            __m128 x2 = _mm_loadu_ps(&ps[k+2]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-2]), x2));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-2]), x2));
+
+            __m128 x3 = _mm_loadu_ps(&ps[k+3]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-3]), x3));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-3]), x3));
+        }
+
+        _mm_storeu_ps(&dst0[i], acc0);
+        _mm_storeu_ps(&dst1[i], acc1);
+    }
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4_SSE(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -446,6 +487,8 @@ static void interpolate_SSE(const float* src0, const float* src1, float* dst, fl
 
 void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_1x2_AVX2(float* src, float* dst0, float* dst1, float coef[2][HRTF_TAPS], int numFrames);
+void FIR_1x2_AVX512(float* src, float* dst0, float* dst1, float coef[2][HRTF_TAPS], int numFrames);
 void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
 void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
@@ -456,6 +499,12 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
 }
 
+static void FIR_1x2(float* src, float* dst0, float* dst1, float coef[2][HRTF_TAPS], int numFrames) {
+    // same dispatch as FIR_1x4, the stationary path must sum in the same order
+    static auto f = cpuSupportsAVX512() ? FIR_1x2_AVX512 : (cpuSupportsAVX2() ? FIR_1x2_AVX2 : FIR_1x2_SSE);
+    (*f)(src, dst0, dst1, coef, numFrames); // dispatch
+}
+
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
     static auto f = cpuSupportsAVX2() ? interleave_4x4_AVX2 : interleave_4x4_SSE;
     (*f)(src0, src1, src2, src3, dst, numFrames); // dispatch
@@ -543,6 +592,47 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     }
 }
 
+// 1 channel input, 2 channel output
+static void FIR_1x2(float* src, float* dst0, float* dst1, float coef[2][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        dst0[i+0] = 0.0f;
+        dst0[i+1] = 0.0f;
+        dst0[i+2] = 0.0f;
+        dst0[i+3] = 0.0f;
+
+        dst1[i+0] = 0.0f;
+        dst1[i+1] = 0.0f;
+        dst1[i+2] = 0.0f;
+        dst1[i+3] = 0.0f;
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            // channel 0
+            dst0[i+0] += coef0[-k-0] * ps[k+0] + coef0[-k-1] * ps[k+1] + coef0[-k-2] * ps[k+2] + coef0[-k-3] * ps[k+3];
+            dst0[i+1] += coef0[-k-0] * ps[k+1] + coef0[-k-1] * ps[k+2] + coef0[-k-2] * ps[k+3] + coef0[-k-3] * ps[k+4];
+            dst0[i+2] += coef0[-k-0] * ps[k+2] + coef0[-k-1] * ps[k+3] + coef0[-k-2] * ps[k+4] + coef0[-k-3] * ps[k+5];
+            dst0[i+3] += coef0[-k-0] * ps[k+3] + coef0[-k-1] * ps[k+4] + coef0[-k-2] * ps[k+5] + coef0[-k-3] * ps[k+6];
+
+            // channel 1
+            dst1[i+0] += coef1[-k-0] * ps[k+0] + coef1[-k-1] * ps[k+1] + coef1[-k-2] * ps[k+2] + coef1[-k-3] * ps[k+3];
+            dst1[i+1] += coef1[-k-0] * ps[k+1] + coef1[-k-1] * ps[k+2] + coef1[-k-2] * ps[k+3] + coef1[-k-3] * ps[k+4];
+            dst1[i+2] += coef1[-k-0] * ps[k+2] + coef1[-k-1] * ps[k+3] + coef1[-k-2] * ps[k+4] + coef1[-k-3] * ps[k+5];
+            dst1[i+3] += coef1[-k-0] * ps[k+3] + coef1[-k-1] * ps[k+4] + coef1[-k-2] * ps[k+5] + coef1[-k-3] * ps[k+6];
+        }
+    }
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -1088,33 +1178,53 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
     }
 }
 
-void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
-
-    assert(index >= 0);
-    assert(index < HRTF_TABLES);
-    assert(numFrames == HRTF_BLOCK);
-
-    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
-    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
-    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
-    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
-    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
-    int delay[4];                                           // 4-channel (interleaved)
+bool AudioHRTF::prepareFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                               int index, float azimuth, float distance, float gain) {
 
     // apply global and local gain adjustment
     gain *= _gainAdjust;
 
-    // to avoid polluting the cache, old filters are recomputed instead of stored
-    setFilters(firCoef, bqCoef, delay, index, _azimuthState, _distanceState, _gainState, L0);
-
     // compute new filters
     setFilters(firCoef, bqCoef, delay, index, azimuth, distance, gain, L1);
 
+    bool isStationary = (azimuth == _azimuthState && distance == _distanceState && gain == _gainState);
+
+    if (isStationary) {
+
+        // stationary source, old filters are identical to the new ones
+        memcpy(firCoef[L0], firCoef[L1], HRTF_TAPS * sizeof(float));
+        memcpy(firCoef[R0], firCoef[R1], HRTF_TAPS * sizeof(float));
+
+        for (int k = 0; k < 5; k++) {
+            bqCoef[k][L0] = bqCoef[k][L1];
+            bqCoef[k][R0] = bqCoef[k][R1];
+            bqCoef[k][L2] = bqCoef[k][L3];
+            bqCoef[k][R2] = bqCoef[k][R3];
+        }
+        delay[L0] = delay[L1];
+        delay[R0] = delay[R1];
+
+    } else {
+
+        // to avoid polluting the cache, old filters are recomputed instead of stored
+        setFilters(firCoef, bqCoef, delay, index, _azimuthState, _distanceState, _gainState, L0);
+    }
+
     // new parameters become old
     _azimuthState = azimuth;
     _distanceState = distance;
     _gainState = gain;
 
+    return isStationary;
+}
+
+void AudioHRTF::convolve(const int16_t* input, float* output, float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                         bool isStationary) {
+
+    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
+    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
+    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
+
     // convert mono input to float
     for (int i = 0; i < HRTF_BLOCK; i++) {
         in[HRTF_TAPS+i] = (float)input[i] * (1/32768.0f);
@@ -1124,17 +1234,29 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
     memcpy(_firState, &in[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
 
+    // the old filters of a stationary source are the new ones, and its old/new delay state is always identical
+    // (see below) so the new FIR output stands in for the old
+    int oldL = isStationary ? L1 : L0;
+    int oldR = isStationary ? R1 : R0;
+
     // process old/new FIR
-    FIR_1x4(&in[HRTF_TAPS], 
-            &firBuffer[L0][HRTF_DELAY], 
-            &firBuffer[R0][HRTF_DELAY], 
-            &firBuffer[L1][HRTF_DELAY], 
-            &firBuffer[R1][HRTF_DELAY], 
-            firCoef, HRTF_BLOCK);
+    if (isStationary) {
+        FIR_1x2(&in[HRTF_TAPS],
+                &firBuffer[L1][HRTF_DELAY],
+                &firBuffer[R1][HRTF_DELAY],
+                &firCoef[L1], HRTF_BLOCK);
+    } else {
+        FIR_1x4(&in[HRTF_TAPS], 
+                &firBuffer[L0][HRTF_DELAY], 
+                &firBuffer[R0][HRTF_DELAY], 
+                &firBuffer[L1][HRTF_DELAY], 
+                &firBuffer[R1][HRTF_DELAY], 
+                firCoef, HRTF_BLOCK);
+    }
 
     // delay state update
-    memcpy(firBuffer[L0], _delayState[L0], HRTF_DELAY * sizeof(float));
-    memcpy(firBuffer[R0], _delayState[R0], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[oldL], _delayState[L0], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[oldR], _delayState[R0], HRTF_DELAY * sizeof(float));
     memcpy(firBuffer[L1], _delayState[L1], HRTF_DELAY * sizeof(float));
     memcpy(firBuffer[R1], _delayState[R1], HRTF_DELAY * sizeof(float));
 
@@ -1144,8 +1266,8 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     memcpy(_delayState[R1], &firBuffer[R1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
 
     // interleave with old/new integer delay
-    interleave_4x4(&firBuffer[L0][HRTF_DELAY] - delay[L0],
-                   &firBuffer[R0][HRTF_DELAY] - delay[R0],
+    interleave_4x4(&firBuffer[oldL][HRTF_DELAY] - delay[L0],
+                   &firBuffer[oldR][HRTF_DELAY] - delay[R0],
                    &firBuffer[L1][HRTF_DELAY] - delay[L1],
                    &firBuffer[R1][HRTF_DELAY] - delay[R1],
                    bqBuffer, HRTF_BLOCK);
@@ -1175,3 +1297,51 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
 
     _resetState = false;
 }
+
+void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
+    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
+    int delay[4];                                           // 4-channel (interleaved)
+
+    bool isStationary = prepareFilters(firCoef, bqCoef, delay, index, azimuth, distance, gain);
+
+    convolve(input, output, firCoef, bqCoef, delay, isStationary);
+}
+
+void AudioHRTF::renderBatch(AudioHRTF* const* hrtfs, const int16_t* const* inputs, float* output, int index,
+                            const float* azimuths, const float* distances, const float* gains,
+                            int numSources, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    // sources are processed in groups, small enough for their filters to stay in L1
+    static const int HRTF_GROUP = 8;
+
+    ALIGN32 float firCoef[HRTF_GROUP][4][HRTF_TAPS];        // 4-channel, per source
+    ALIGN32 float bqCoef[HRTF_GROUP][5][8];                 // 4-channel (interleaved), per source
+    int delay[HRTF_GROUP][4];                               // 4-channel (interleaved), per source
+    bool isStationary[HRTF_GROUP];                          // per source
+
+    for (int group = 0; group < numSources; group += HRTF_GROUP) {
+
+        int numGroupSources = MIN(HRTF_GROUP, numSources - group);
+
+        // interpolate filters for the whole group
+        for (int i = 0; i < numGroupSources; i++) {
+            isStationary[i] = hrtfs[group + i]->prepareFilters(firCoef[i], bqCoef[i], delay[i], index,
+                                             azimuths[group + i], distances[group + i], gains[group + i]);
+        }
+
+        // convolve each source into the mix
+        for (int i = 0; i < numGroupSources; i++) {
+            hrtfs[group + i]->convolve(inputs[group + i], output, firCoef[i], bqCoef[i], delay[i], isStationary[i]);
+        }
+    }
+}
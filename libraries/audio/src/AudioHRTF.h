@@ -50,6 +50,16 @@ public:
     //
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // Render many sources into the same mix.
+    // Filters for a group of sources are interpolated together, then each source is convolved into the mix.
+    // Per-source arguments are parallel arrays of numSources elements, the rest is as for render().
+    // The mix is the same, to the bit, as rendering each source in turn with render().
+    //
+    static void renderBatch(AudioHRTF* const* hrtfs, const int16_t* const* inputs, float* output, int index,
+                            const float* azimuths, const float* distances, const float* gains,
+                            int numSources, int numFrames);
+
     //
     // Fast path when input is known to be silent and state as been flushed
     //
@@ -93,6 +103,14 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    // compute old/new filters and update the parameter history, returns true if the old and new filters are the same
+    bool prepareFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                        int index, float azimuth, float distance, float gain);
+
+    // filter one block through old/new filters, crossfade and accumulate into output
+    void convolve(const int16_t* input, float* output, float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                  bool isStationary);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
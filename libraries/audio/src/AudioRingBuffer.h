@@ -159,6 +159,10 @@ public:
             return ConstIterator(_bufferFirst, _bufferLength, atShiftedBy(-i));
         }
 
+        // the next numSamples samples where they are in the buffer, or nullptr if they wrap around its end
+        const Sample* contiguousSamples(int numSamples) const {
+            return (_bufferLast - _at + 1 >= numSamples) ? _at : nullptr;
+        }
         void readSamples(Sample* dest, int numSamples) {
             auto samplesToEnd = _bufferLast - _at + 1;
 
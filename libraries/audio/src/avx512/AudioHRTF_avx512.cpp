@@ -87,4 +87,52 @@ void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* ds
     _mm256_zeroupper();
 }
 
+// 1 channel input, 2 channel output
+void FIR_1x2_AVX512(float* src, float* dst0, float* dst1, float coef[2][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 acc0 = _mm512_setzero_ps();
+        __m512 acc1 = _mm512_setzero_ps();
+        __m512 acc4 = _mm512_setzero_ps();
+        __m512 acc5 = _mm512_setzero_ps();
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            __m512 x0 = _mm512_loadu_ps(&ps[k+0]);
+            acc0 = _mm512_fmadd_ps(_mm512_set1_ps(coef0[-k-0]), x0, acc0);
+            acc1 = _mm512_fmadd_ps(_mm512_set1_ps(coef1[-k-0]), x0, acc1);
+
+            __m512 x1 = _mm512_loadu_ps(&ps[k+1]);
+            acc4 = _mm512_fmadd_ps(_mm512_set1_ps(coef0[-k-1]), x1, acc4);
+            acc5 = _mm512_fmadd_ps(_mm512_set1_ps(coef1[-k-1]), x1, acc5);
+
+            __m512 x2 = _mm512_loadu_ps(&ps[k+2]);
+            acc0 = _mm512_fmadd_ps(_mm512_set1_ps(coef0[-k-2]), x2, acc0);
+            acc1 = _mm512_fmadd_ps(_mm512_set1_ps(coef1[-k-2]), x2, acc1);
+
+            __m512 x3 = _mm512_loadu_ps(&ps[k+3]);
+            acc4 = _mm512_fmadd_ps(_mm512_set1_ps(coef0[-k-3]), x3, acc4);
+            acc5 = _mm512_fmadd_ps(_mm512_set1_ps(coef1[-k-3]), x3, acc5);
+        }
+
+        acc0 = _mm512_add_ps(acc0, acc4);
+        acc1 = _mm512_add_ps(acc1, acc5);
+
+        _mm512_storeu_ps(&dst0[i], acc0);
+        _mm512_storeu_ps(&dst1[i], acc1);
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
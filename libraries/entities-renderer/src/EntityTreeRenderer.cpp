@@ -368,6 +368,18 @@ void EntityTreeRenderer::addPendingEntities(const render::ScenePointer& scene, r
     }
 }
 
+glm::vec3 EntityTreeRenderer::SortableRenderer::getPosition() const {
+    return _renderer->getEntity()->getWorldPosition();
+}
+
+float EntityTreeRenderer::SortableRenderer::getRadius() const {
+    return 0.5f * _renderer->getEntity()->getQueryAACube().getScale();
+}
+
+uint64_t EntityTreeRenderer::SortableRenderer::getTimestamp() const {
+    return _renderer->getUpdateTime();
+}
+
 void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene, render::Transaction& transaction) {
     PROFILE_RANGE_EX(simulation_physics, "ChangeInScene", 0xffff00ff, (uint64_t)_changedEntities.size());
     PerformanceTimer pt("change");
@@ -414,36 +426,25 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         // we expect the cost to updating all renderables to exceed available time budget
         // so we first sort by priority and update in order until out of time
 
-        class SortableRenderer: public PrioritySortUtil::Sortable {
-        public:
-            SortableRenderer(const EntityRendererPointer& renderer) : _renderer(renderer) { }
-
-            glm::vec3 getPosition() const override { return _renderer->getEntity()->getWorldPosition(); }
-            float getRadius() const override { return 0.5f * _renderer->getEntity()->getQueryAACube().getScale(); }
-            uint64_t getTimestamp() const override { return _renderer->getUpdateTime(); }
-
-            EntityRendererPointer getRenderer() const { return _renderer; }
-        private:
-            EntityRendererPointer _renderer;
-        };
-
         // prioritize and sort the renderables
         uint64_t sortStart = usecTimestampNow();
 
-        const auto& views = _viewState->getConicalViews();
-        PrioritySortUtil::PriorityQueue<SortableRenderer> sortedRenderables(views);
-        sortedRenderables.reserve(_renderablesToUpdate.size());
+        _sortedRenderables.setViews(_viewState->getConicalViews());
+        _sortedRenderables.reserve(_renderablesToUpdate.size());
         {
             PROFILE_RANGE_EX(simulation_physics, "SortRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
             std::unordered_map<EntityItemID, EntityRendererPointer>::iterator itr = _renderablesToUpdate.begin();
             while (itr != _renderablesToUpdate.end()) {
                 assert(itr->second); // only valid renderables are added to _renderablesToUpdate
-                sortedRenderables.push(SortableRenderer(itr->second));
+                _sortedRenderables.push(SortableRenderer(itr->second));
                 ++itr;
             }
         }
         {
-            PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, sortedRenderables.size());
+            PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, _sortedRenderables.size());
+
+            // the priorities are computed as the renderables get sorted, which counts against the budget too
+            const auto& sortedRenderablesVector = _sortedRenderables.getSortedVector();
 
             // compute remaining time budget
             uint64_t updateStart = usecTimestampNow();
@@ -455,8 +456,7 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
             uint64_t expiry = updateStart + timeBudget;
 
             // process the sorted renderables
-            size_t numSorted = sortedRenderables.size();
-            const auto& sortedRenderablesVector = sortedRenderables.getSortedVector();
+            size_t numUpdated = 1; // start at one to avoid divide by zero
             for (const auto& sortedRenderable : sortedRenderablesVector) {
                 if (usecTimestampNow() > expiry) {
                     break;
@@ -464,10 +464,12 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
                 const auto& renderable = sortedRenderable.getRenderer();
                 renderable->updateInScene(scene, transaction);
                 _renderablesToUpdate.erase(renderable->getEntity()->getID());
+                ++numUpdated;
             }
+            // don't keep the renderables alive until the next frame
+            _sortedRenderables.clear();
 
             // compute average per-renderable update cost
-            size_t numUpdated = numSorted - sortedRenderables.size() + 1; // add one to avoid divide by zero
             float cost = (float)(usecTimestampNow() - updateStart) / (float)(numUpdated);
             const float blend = 0.1f;
             _avgRenderableUpdateCost = (1.0f - blend) * _avgRenderableUpdateCost + blend * cost;
@@ -20,6 +20,7 @@
 #include <EntityScriptingInterface.h> // for RayToEntityIntersectionResult
 #include <EntityTree.h>
 #include <PointerEvent.h>
+#include <PrioritySortUtil.h>
 #include <ScriptCache.h>
 #include <TextureCache.h>
 #include <OctreeProcessor.h>
@@ -253,6 +254,21 @@ private:
     std::unordered_set<EntityItemID> _changedEntities;
 
     std::unordered_map<EntityItemID, EntityRendererPointer> _renderablesToUpdate;
+
+    class SortableRenderer : public PrioritySortUtil::Sortable {
+    public:
+        SortableRenderer(const EntityRendererPointer& renderer) : _renderer(renderer) { }
+
+        glm::vec3 getPosition() const override;
+        float getRadius() const override;
+        uint64_t getTimestamp() const override;
+
+        EntityRendererPointer getRenderer() const { return _renderer; }
+    private:
+        EntityRendererPointer _renderer;
+    };
+    // reused from frame to frame to keep its storage, emptied once the renderables are updated
+    PrioritySortUtil::PriorityQueue<SortableRenderer> _sortedRenderables;
     std::unordered_map<EntityItemID, EntityRendererPointer> _entitiesInScene;
     std::unordered_map<EntityItemID, EntityItemWeakPointer> _entitiesToAdd;
     // For Scene.shouldRenderEntities
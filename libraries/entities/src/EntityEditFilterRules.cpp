@@ -0,0 +1,262 @@
+//
+//  EntityEditFilterRules.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditFilterRules.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include <QJsonArray>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "EntitiesLogging.h"
+
+static const QString FILTER_TYPE_NAMES[] = { "add", "edit", "physics", "delete" };
+
+static bool parseFilterType(const QString& name, EntityTree::FilterType& filterType) {
+    for (int i = 0; i <= EntityTree::FilterType::Delete; ++i) {
+        if (name == FILTER_TYPE_NAMES[i]) {
+            filterType = (EntityTree::FilterType)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseVec3(const QJsonValue& value, glm::vec3& vec) {
+    QJsonArray array = value.toArray();
+    if (array.size() != 3) {
+        return false;
+    }
+    vec = glm::vec3(array[0].toDouble(), array[1].toDouble(), array[2].toDouble());
+    return true;
+}
+
+float EntityEditFilterRules::Range::clamp(float value) const {
+    if (hasMin && value < min) {
+        value = min;
+    }
+    if (hasMax && value > max) {
+        value = max;
+    }
+    return value;
+}
+
+bool EntityEditFilterRules::parse(const QJsonObject& rules) {
+    _wantsToFilterAdd = rules["wantsToFilterAdd"].toBool(true);
+    _wantsToFilterEdit = rules["wantsToFilterEdit"].toBool(true);
+    _wantsToFilterPhysics = rules["wantsToFilterPhysics"].toBool(true);
+    _wantsToFilterDelete = rules["wantsToFilterDelete"].toBool(false);
+
+    for (const auto& value : rules["rejectFilterTypes"].toArray()) {
+        EntityTree::FilterType filterType;
+        if (!parseFilterType(value.toString(), filterType)) {
+            qCWarning(entities) << "Unknown filter type in entity edit filter rules:" << value.toString();
+            return false;
+        }
+        _rejectedFilterTypes |= 1 << filterType;
+
+        // the edits to reject have to go through the rules, deletes are left out by default
+        switch (filterType) {
+            case EntityTree::FilterType::Add:
+                _wantsToFilterAdd = true;
+                break;
+            case EntityTree::FilterType::Edit:
+                _wantsToFilterEdit = true;
+                break;
+            case EntityTree::FilterType::Physics:
+                _wantsToFilterPhysics = true;
+                break;
+            case EntityTree::FilterType::Delete:
+                _wantsToFilterDelete = true;
+                break;
+        }
+    }
+
+    for (const auto& value : rules["rejectProperties"].toArray()) {
+        EntityPropertyInfo propertyInfo;
+        if (!EntityItemProperties::getPropertyInfo(value.toString(), propertyInfo)) {
+            qCWarning(entities) << "Unknown property in entity edit filter rules:" << value.toString();
+            return false;
+        }
+        _rejectedProperties.push_back(propertyInfo.propertyEnum);
+    }
+
+    QJsonObject clamp = rules["clamp"].toObject();
+    const std::pair<QString, Range*> RANGES[] = {
+        { "dimensions", &_dimensions },
+        { "velocity", &_velocity },
+        { "angularVelocity", &_angularVelocity },
+        { "gravity", &_gravity },
+        { "acceleration", &_acceleration },
+        { "lifetime", &_lifetime },
+        { "density", &_density },
+        { "restitution", &_restitution },
+        { "friction", &_friction }
+    };
+    for (auto it = clamp.constBegin(); it != clamp.constEnd(); ++it) {
+        auto range = std::find_if(std::begin(RANGES), std::end(RANGES), [&](const std::pair<QString, Range*>& entry) {
+            return entry.first == it.key();
+        });
+        if (range == std::end(RANGES)) {
+            qCWarning(entities) << "Unsupported property to clamp in entity edit filter rules:" << it.key();
+            return false;
+        }
+        QJsonObject limits = it.value().toObject();
+        range->second->hasMin = limits.contains("min");
+        range->second->min = (float)limits["min"].toDouble();
+        range->second->hasMax = limits.contains("max");
+        range->second->max = (float)limits["max"].toDouble();
+    }
+
+    QJsonValue bounds = rules["bounds"];
+    if (bounds.isString()) {
+        if (bounds.toString() != "zone") {
+            qCWarning(entities) << "Unknown bounds in entity edit filter rules:" << bounds.toString();
+            return false;
+        }
+        _boundsType = ZoneBounds;
+    } else if (bounds.isObject()) {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        if (!parseVec3(bounds.toObject()["min"], minimum) || !parseVec3(bounds.toObject()["max"], maximum)) {
+            qCWarning(entities) << "Malformed bounds in entity edit filter rules";
+            return false;
+        }
+        _boundsType = FixedBounds;
+        _bounds = AABox(minimum, maximum - minimum);
+    }
+    _clampOutOfBounds = rules["outOfBounds"].toString() == "clamp";
+
+    _maxEditsPerSecond = rules["maxEditsPerSecond"].toInt(0);
+
+    return true;
+}
+
+bool EntityEditFilterRules::wantsToFilter(EntityTree::FilterType filterType) const {
+    switch (filterType) {
+        case EntityTree::FilterType::Add:
+            return _wantsToFilterAdd;
+        case EntityTree::FilterType::Edit:
+            return _wantsToFilterEdit;
+        case EntityTree::FilterType::Physics:
+            return _wantsToFilterPhysics;
+        case EntityTree::FilterType::Delete:
+            return _wantsToFilterDelete;
+    }
+    return true;
+}
+
+bool EntityEditFilterRules::isRateLimited(const EntityItemID& entityID) {
+    quint64 now = usecTimestampNow();
+
+    std::lock_guard<std::mutex> lock(_editRatesMutex);
+
+    // forget about the entities that weren't edited lately, once in a while
+    const quint64 PRUNE_INTERVAL = 10 * USECS_PER_SECOND;
+    if (now - _lastEditRatesPrune > PRUNE_INTERVAL) {
+        for (auto it = _editRates.begin(); it != _editRates.end();) {
+            if (now - it->windowStart > USECS_PER_SECOND) {
+                it = _editRates.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        _lastEditRatesPrune = now;
+    }
+
+    auto& editRate = _editRates[entityID];
+    if (now - editRate.windowStart > USECS_PER_SECOND) {
+        editRate.windowStart = now;
+        editRate.numEdits = 0;
+    }
+    return ++editRate.numEdits > _maxEditsPerSecond;
+}
+
+bool EntityEditFilterRules::apply(EntityItemProperties& properties, EntityTree::FilterType filterType,
+                                  const EntityItemID& entityID, const AABox* zoneBox, bool& wasChanged) {
+    if (_rejectedFilterTypes & (1 << filterType)) {
+        return false;
+    }
+    if (filterType == EntityTree::FilterType::Delete) {
+        return true;
+    }
+
+    if (!_rejectedProperties.empty()) {
+        EntityPropertyFlags changedProperties = properties.getChangedProperties();
+        for (auto property : _rejectedProperties) {
+            if (changedProperties.getHasProperty(property)) {
+                return false;
+            }
+        }
+    }
+
+    if (_maxEditsPerSecond > 0 && !entityID.isInvalidID() && isRateLimited(entityID)) {
+        return false;
+    }
+
+    if (_boundsType != NoBounds && properties.positionChanged()) {
+        const AABox* bounds = _boundsType == ZoneBounds ? zoneBox : &_bounds;
+        if (bounds && !bounds->contains(properties.getPosition())) {
+            if (!_clampOutOfBounds) {
+                return false;
+            }
+            properties.setPosition(glm::clamp(properties.getPosition(), bounds->getMinimumPoint(), bounds->getMaximumPoint()));
+            wasChanged = true;
+        }
+    }
+
+    if (_dimensions.isSet() && properties.dimensionsChanged()) {
+        glm::vec3 dimensions = properties.getDimensions();
+        glm::vec3 clamped(_dimensions.clamp(dimensions.x), _dimensions.clamp(dimensions.y), _dimensions.clamp(dimensions.z));
+        if (clamped != dimensions) {
+            properties.setDimensions(clamped);
+            wasChanged = true;
+        }
+    }
+
+    auto clampLength = [&](const Range& range, bool changed, const glm::vec3& value, void (EntityItemProperties::*setter)(const glm::vec3&)) {
+        if (range.isSet() && changed) {
+            float length = glm::length(value);
+            float clampedLength = range.clamp(length);
+            if (clampedLength != length && length > 0.0f) {
+                (properties.*setter)(value * (clampedLength / length));
+                wasChanged = true;
+            }
+        }
+    };
+    clampLength(_velocity, properties.velocityChanged(), properties.getVelocity(), &EntityItemProperties::setVelocity);
+    clampLength(_angularVelocity, properties.angularVelocityChanged(), properties.getAngularVelocity(),
+                &EntityItemProperties::setAngularVelocity);
+    clampLength(_gravity, properties.gravityChanged(), properties.getGravity(), &EntityItemProperties::setGravity);
+    clampLength(_acceleration, properties.accelerationChanged(), properties.getAcceleration(),
+                &EntityItemProperties::setAcceleration);
+
+    auto clampValue = [&](const Range& range, bool changed, float value, void (EntityItemProperties::*setter)(float)) {
+        if (range.isSet() && changed) {
+            float clamped = range.clamp(value);
+            if (clamped != value) {
+                (properties.*setter)(clamped);
+                wasChanged = true;
+            }
+        }
+    };
+    // an immortal entity lives longer than any maximum lifetime
+    float lifetime = properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ? FLT_MAX : properties.getLifetime();
+    clampValue(_lifetime, properties.lifetimeChanged(), lifetime, &EntityItemProperties::setLifetime);
+    clampValue(_density, properties.densityChanged(), properties.getDensity(), &EntityItemProperties::setDensity);
+    clampValue(_restitution, properties.restitutionChanged(), properties.getRestitution(), &EntityItemProperties::setRestitution);
+    clampValue(_friction, properties.frictionChanged(), properties.getFriction(), &EntityItemProperties::setFriction);
+
+    return true;
+}
@@ -0,0 +1,106 @@
+//
+//  EntityEditFilterRules.h
+//  libraries/entities/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_EntityEditFilterRules_h
+#define hifi_EntityEditFilterRules_h
+
+#include <mutex>
+#include <vector>
+
+#include <QHash>
+#include <QJsonObject>
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+
+#include "EntityItemID.h"
+#include "EntityItemProperties.h"
+#include "EntityTree.h"
+
+// A declarative entity edit filter, applied natively to the EntityItemProperties of the edits
+// rather than through a script engine. The rules are a JSON object, all of them optional:
+//
+//  {
+//      "wantsToFilterAdd": true,               // which edits the rules apply to, same defaults as for a filter script
+//      "wantsToFilterEdit": true,
+//      "wantsToFilterPhysics": true,
+//      "wantsToFilterDelete": false,
+//      "rejectFilterTypes": [ "delete" ],      // reject these edits outright ("add", "edit", "physics", "delete"),
+//                                              // which implies wanting to filter them
+//      "rejectProperties": [ "locked" ],       // reject edits that set any of these properties
+//      "clamp": {                              // clamp these properties to a range
+//          "dimensions": { "min": 0.01, "max": 10 },   // for each axis
+//          "velocity": { "max": 10 },                  // velocity, angularVelocity, gravity and acceleration by length
+//          "lifetime": { "max": 3600 }                 // lifetime, density, restitution and friction by value
+//      },
+//      "bounds": "zone",                       // keep positions within the zone of the filter, or within
+//                                              // { "min": [ x, y, z ], "max": [ x, y, z ] }
+//      "outOfBounds": "reject",                // "reject" the edits out of bounds, or "clamp" their position
+//      "maxEditsPerSecond": 30                 // reject edits of an entity beyond this rate
+//  }
+class EntityEditFilterRules {
+public:
+    /// returns false if the rules are malformed, in which case the filter should reject all edits
+    bool parse(const QJsonObject& rules);
+
+    bool wantsToFilter(EntityTree::FilterType filterType) const;
+    bool wantsZoneBounds() const { return _boundsType == ZoneBounds; }
+
+    /// returns false if the edit is rejected, otherwise clamps the properties and sets wasChanged if any were
+    bool apply(EntityItemProperties& properties, EntityTree::FilterType filterType, const EntityItemID& entityID,
+               const AABox* zoneBox, bool& wasChanged);
+
+private:
+    struct Range {
+        bool hasMin { false };
+        bool hasMax { false };
+        float min { 0.0f };
+        float max { 0.0f };
+
+        bool isSet() const { return hasMin || hasMax; }
+        float clamp(float value) const;
+    };
+
+    bool isRateLimited(const EntityItemID& entityID);
+
+    bool _wantsToFilterAdd { true };
+    bool _wantsToFilterEdit { true };
+    bool _wantsToFilterPhysics { true };
+    bool _wantsToFilterDelete { false };
+
+    uint32_t _rejectedFilterTypes { 0 };
+    std::vector<EntityPropertyList> _rejectedProperties;
+
+    Range _dimensions;
+    Range _velocity;
+    Range _angularVelocity;
+    Range _gravity;
+    Range _acceleration;
+    Range _lifetime;
+    Range _density;
+    Range _restitution;
+    Range _friction;
+
+    enum BoundsType { NoBounds, ZoneBounds, FixedBounds };
+    BoundsType _boundsType { NoBounds };
+    AABox _bounds;
+    bool _clampOutOfBounds { false };
+
+    int _maxEditsPerSecond { 0 };
+    struct EditRate {
+        quint64 windowStart { 0 };
+        int numEdits { 0 };
+    };
+    std::mutex _editRatesMutex;
+    QHash<EntityItemID, EditRate> _editRates;
+    quint64 _lastEditRatesPrune { 0 };
+};
+
+#endif // hifi_EntityEditFilterRules_h
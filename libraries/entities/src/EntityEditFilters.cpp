@@ -11,6 +11,7 @@
 
 #include "EntityEditFilters.h"
 
+#include <QJsonDocument>
 #include <QUrl>
 
 #include <ResourceManager.h>
@@ -72,6 +73,24 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
+            if (filterData.rules) {
+                AABox zoneBox;
+                bool hasZoneBox = false;
+                if (filterData.rules->wantsZoneBounds() && !id.isInvalidID()) {
+                    auto zoneEntity = _tree->findEntityByEntityItemID(id);
+                    if (zoneEntity) {
+                        zoneBox = zoneEntity->getAABox(hasZoneBox);
+                    }
+                }
+                if (!filterData.rules->apply(propertiesIn, filterType, itemID, hasZoneBox ? &zoneBox : nullptr, wasChanged)) {
+                    return false;
+                }
+                if (&propertiesOut != &propertiesIn) {
+                    propertiesOut = propertiesIn;
+                }
+                continue;
+            }
+
             auto oldProperties = propertiesIn.getDesiredProperties();
             auto specifiedProperties = propertiesIn.getChangedProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
@@ -247,6 +266,34 @@ static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName
     return false;
 }
 
+bool EntityEditFilters::loadFilterRules(EntityItemID entityID, const QByteArray& contents) {
+    // declarative rules are a JSON object, which is never a meaningful script
+    QJsonParseError parseError;
+    auto rulesDocument = QJsonDocument::fromJson(contents, &parseError);
+    if (parseError.error == QJsonParseError::NoError && rulesDocument.isObject()) {
+        FilterData filterData;
+        filterData.rules = std::make_shared<EntityEditFilterRules>();
+        if (!filterData.rules->parse(rulesDocument.object())) {
+            qDebug() << "Malformed filter rules. Will reject all edits for those without lock rights.";
+            filterData.rules.reset();
+            filterData.rejectAll = true;
+        } else {
+            filterData.wantsToFilterAdd = filterData.rules->wantsToFilter(EntityTree::FilterType::Add);
+            filterData.wantsToFilterEdit = filterData.rules->wantsToFilter(EntityTree::FilterType::Edit);
+            filterData.wantsToFilterPhysics = filterData.rules->wantsToFilter(EntityTree::FilterType::Physics);
+            filterData.wantsToFilterDelete = filterData.rules->wantsToFilter(EntityTree::FilterType::Delete);
+        }
+
+        _lock.lockForWrite();
+        _filterDataMap.insert(entityID, filterData);
+        _lock.unlock();
+
+        qDebug() << "filter rules processed for entity id " << entityID;
+        return true;
+    }
+    return false;
+}
+
 void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
     qDebug() << "script request completed for entity " << entityID;
     auto scriptRequest = qobject_cast<ResourceRequest*>(sender());
@@ -254,6 +301,10 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         const QString urlString = scriptRequest->getUrl().toString();
         auto scriptContents = scriptRequest->getData();
         qInfo() << "Downloaded script:" << scriptContents;
+        if (loadFilterRules(entityID, scriptContents)) {
+            emit filterAdded(entityID, true);
+            return;
+        }
         QScriptProgram program(scriptContents, urlString);
         if (hasCorrectSyntax(program)) {
             // create a QScriptEngine for this script
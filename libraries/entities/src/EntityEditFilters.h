@@ -18,13 +18,18 @@
 #include <glm/glm.hpp>
 
 #include <functional>
+#include <memory>
 
+#include "EntityEditFilterRules.h"
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
 
+class EntityEditFilterTests;
+
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
+    friend class ::EntityEditFilterTests;
 public:
     struct FilterData {
         QScriptValue filterFn;
@@ -43,9 +48,12 @@ public:
         std::function<bool()> uncaughtExceptions;
         QScriptEngine* engine;
         bool rejectAll;
+
+        // set instead of the engine for a declarative filter
+        std::shared_ptr<EntityEditFilterRules> rules;
         
         FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        bool valid() { return (rejectAll || rules || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
     };
 
     EntityEditFilters() {};
@@ -66,6 +74,9 @@ private slots:
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
 
+    // loads the downloaded contents of a filter if they are the JSON of declarative EntityEditFilterRules
+    bool loadFilterRules(EntityItemID entityID, const QByteArray& contents);
+
     EntityTreePointer _tree {};
     bool _rejectAll {false};
     QScriptValue _nullObjectForFilter{};
@@ -166,6 +166,13 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     OctreeElement::AppendState appendState = OctreeElement::COMPLETED; // assume the best
 
+    // read the generation before anything else, so that an encoding racing with an edit is never reused
+    uint32_t encodedGeneration = _encodedGeneration;
+    quint64 lastEdited = getLastEdited();
+    quint64 lastUpdated = getLastUpdated();
+    quint64 lastSimulated = getLastSimulated();
+    quint64 changedOnServer = getLastChangedOnServer();
+
     // encode our ID as a byte count coded byte stream
     QByteArray encodedID = getID().toRfc4122();
 
@@ -174,12 +181,12 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     QByteArray encodedType = typeCoder;
 
     // last updated (animations, non-physics changes)
-    quint64 updateDelta = getLastUpdated() <= getLastEdited() ? 0 : getLastUpdated() - getLastEdited();
+    quint64 updateDelta = lastUpdated <= lastEdited ? 0 : lastUpdated - lastEdited;
     ByteCountCoded<quint64> updateDeltaCoder = updateDelta;
     QByteArray encodedUpdateDelta = updateDeltaCoder;
 
     // last simulated (velocity, angular velocity, physics changes)
-    quint64 simulatedDelta = getLastSimulated() <= getLastEdited() ? 0 : getLastSimulated() - getLastEdited();
+    quint64 simulatedDelta = lastSimulated <= lastEdited ? 0 : lastSimulated - lastEdited;
     ByteCountCoded<quint64> simulatedDeltaCoder = simulatedDelta;
     QByteArray encodedSimulatedDelta = simulatedDeltaCoder;
 
@@ -194,15 +201,29 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
-    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
+    bool isPartialPass = entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID());
+    if (isPartialPass) {
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
+    } else {
+        // reuse the encoding of another sender if nothing changed since, as long as it fits as a whole
+        auto encodedData = std::atomic_load(&_encodedData);
+        if (encodedData && encodedData->generation == encodedGeneration && encodedData->lastEdited == lastEdited &&
+            encodedData->lastUpdated == lastUpdated && encodedData->lastSimulated == lastSimulated &&
+            encodedData->changedOnServer == changedOnServer && encodedData->requestedProperties == requestedProperties) {
+            LevelDetails cachedLevel = packetData->startLevel();
+            if (packetData->appendRawData((const unsigned char*)encodedData->bytes.constData(), encodedData->bytes.size())) {
+                packetData->endLevel(cachedLevel);
+                params.trackSend(getID(), lastEdited);
+                return OctreeElement::COMPLETED;
+            }
+            packetData->discardLevel(cachedLevel);
+        }
     }
 
     EntityPropertyFlags propertiesDidntFit = requestedProperties;
 
     LevelDetails entityLevel = packetData->startLevel();
-
-    quint64 lastEdited = getLastEdited();
+    int entityDataOffset = packetData->getUncompressedByteOffset();
 
     #ifdef WANT_DEBUG
         float editedAgo = getEditedAgo();
@@ -384,7 +405,21 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // if any part of our entity was sent, call trackSend
     if (appendState != OctreeElement::NONE) {
-        params.trackSend(getID(), getLastEdited());
+        params.trackSend(getID(), lastEdited);
+    }
+
+    // a complete encoding can be reused by the other senders
+    if (appendState == OctreeElement::COMPLETED && !isPartialPass) {
+        auto encodedData = std::make_shared<EncodedData>();
+        encodedData->generation = encodedGeneration;
+        encodedData->lastEdited = lastEdited;
+        encodedData->lastUpdated = lastUpdated;
+        encodedData->lastSimulated = lastSimulated;
+        encodedData->changedOnServer = changedOnServer;
+        encodedData->requestedProperties = requestedProperties;
+        encodedData->bytes = QByteArray((const char*)packetData->getUncompressedData(entityDataOffset),
+                                        packetData->getUncompressedByteOffset() - entityDataOffset);
+        std::atomic_store(&_encodedData, std::shared_ptr<const EncodedData>(encodedData));
     }
 
     return appendState;
@@ -1571,6 +1606,7 @@ bool EntityItem::setProperties(const EntityItemProperties& properties) {
         _created = timestamp;
     }
 
+    invalidateEncodedData();
     return somethingChanged;
 }
 
@@ -2586,6 +2622,7 @@ QList<EntityDynamicPointer> EntityItem::getActionsOfType(EntityDynamicType typeT
 
 void EntityItem::locationChanged(bool tellPhysics, bool tellChildren) {
     requiresRecalcBoxes();
+    invalidateEncodedData();
     if (tellPhysics) {
         _flags |= Simulation::DIRTY_TRANSFORM;
         EntityTreePointer tree = getTree();
@@ -2601,6 +2638,7 @@ void EntityItem::locationChanged(bool tellPhysics, bool tellChildren) {
 
 void EntityItem::dimensionsChanged() {
     requiresRecalcBoxes();
+    invalidateEncodedData();
     SpatiallyNestable::dimensionsChanged(); // Do what you have to do
     _boundingRadius = 0.5f * glm::length(getScaledDimensions());
     std::pair<int32_t, glm::vec4> data(_spaceIndex, glm::vec4(getWorldPosition(), _boundingRadius));
@@ -2683,6 +2721,7 @@ void EntityItem::setLastSimulated(quint64 now) {
     withWriteLock([&] {
         _lastSimulated = now;
     });
+    invalidateEncodedData();
 }
 
 quint64 EntityItem::getLastEdited() const {
@@ -2698,6 +2737,7 @@ void EntityItem::setLastEdited(quint64 lastEdited) {
         _lastEdited = _lastUpdated = lastEdited;
         _changedOnServer = glm::max(lastEdited, _changedOnServer);
     });
+    invalidateEncodedData();
 }
 
 quint64 EntityItem::getLastBroadcast() const {
@@ -2718,6 +2758,7 @@ void EntityItem::markAsChangedOnServer() {
     withWriteLock([&] {
         _changedOnServer = usecTimestampNow();
     });
+    invalidateEncodedData();
 }
 
 quint64 EntityItem::getLastChangedOnServer() const {
@@ -3158,6 +3199,7 @@ void EntityItem::markDirtyFlags(uint32_t mask) {
         mask &= Simulation::DIRTY_FLAGS;
         _flags |= mask;
     });
+    invalidateEncodedData();
 }
 
 void EntityItem::clearDirtyFlags(uint32_t mask) {
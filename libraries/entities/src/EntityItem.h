@@ -12,6 +12,7 @@
 #ifndef hifi_EntityItem_h
 #define hifi_EntityItem_h
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 
@@ -130,6 +131,9 @@ public:
     void markAsChangedOnServer();
     quint64 getLastChangedOnServer() const;
 
+    /// Drops the encoding shared by the senders, call this when anything that is sent over the wire may have changed
+    void invalidateEncodedData() { ++_encodedGeneration; }
+
     virtual EntityPropertyFlags getEntityProperties(EncodeBitstreamParams& params) const;
 
     virtual OctreeElement::AppendState appendEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
@@ -595,6 +599,20 @@ protected:
     quint64 _created { 0 };
     quint64 _changedOnServer { 0 };
 
+    // The last complete encoding of this entity. It doesn't depend on who it is sent to, so all the senders share it
+    // until the entity changes, rather than each of them encoding the same entity again.
+    struct EncodedData {
+        uint32_t generation;
+        quint64 lastEdited;
+        quint64 lastUpdated;
+        quint64 lastSimulated;
+        quint64 changedOnServer;
+        EntityPropertyFlags requestedProperties;
+        QByteArray bytes;
+    };
+    mutable std::shared_ptr<const EncodedData> _encodedData;
+    std::atomic<uint32_t> _encodedGeneration { 0 };
+
     mutable AABox _cachedAABox;
     mutable AACube _maxAACube;
     mutable AACube _minAACube;
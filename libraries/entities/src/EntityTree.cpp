@@ -10,12 +10,16 @@
 //
 
 #include "EntityTree.h"
+#include <algorithm>
+#include <numeric>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
 #include <NetworkingConstants.h>
+#include <OctreeDataUtils.h>
 #include "AccountManager.h"
 #include <QJsonObject>
 #include <QJsonDocument>
@@ -26,6 +30,7 @@
 #include <Extents.h>
 #include <PerfStat.h>
 #include <Profile.h>
+#include <ThreadHelpers.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -2725,6 +2730,186 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
     }
 }
 
+// keep enough entities on each thread to be worth starting it
+static const int MIN_ENTITIES_PER_THREAD = 256;
+
+// Interleaves the bits of a position in the tree, so that sorting by it keeps neighbours together
+// and entities added one after the other land in the same branches of the octree.
+static uint64_t spatialSortKey(const glm::vec3& position) {
+    const int BITS_PER_AXIS = 21;
+    const float MAX_COORDINATE = (float)((1 << BITS_PER_AXIS) - 1);
+    glm::vec3 scaled = glm::clamp((position + (float)HALF_TREE_SCALE) * (MAX_COORDINATE / (float)TREE_SCALE),
+                                  0.0f, MAX_COORDINATE);
+    uint32_t x = (uint32_t)scaled.x;
+    uint32_t y = (uint32_t)scaled.y;
+    uint32_t z = (uint32_t)scaled.z;
+    uint64_t key = 0;
+    for (int bit = BITS_PER_AXIS - 1; bit >= 0; --bit) {
+        key = (key << 3) | (((x >> bit) & 1) << 2) | (((y >> bit) & 1) << 1) | ((z >> bit) & 1);
+    }
+    return key;
+}
+
+bool EntityTree::addEntitiesInSpatialOrder(const std::vector<EntityItemID>& entityIDs,
+                                           const std::vector<EntityItemProperties>& properties, std::vector<int>& indices,
+                                           QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    std::vector<uint64_t> keys(properties.size());
+    for (int i : indices) {
+        keys[i] = spatialSortKey(properties[i].getPosition());
+    }
+    std::sort(indices.begin(), indices.end(), [&](int a, int b) {
+        return keys[a] < keys[b];
+    });
+
+    bool success = true;
+    for (int i : indices) {
+        EntityItemPointer entity = addEntity(entityIDs[i], properties[i]);
+        if (!entity) {
+            qCDebug(entities) << "adding Entity failed:" << entityIDs[i] << properties[i].getType();
+            success = false;
+            continue;
+        }
+
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+    }
+    return success;
+}
+
+void EntityTree::propertiesFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                   EntityItemID& entityItemID, EntityItemProperties& properties) const {
+    // QVariantMap --> QScriptValue --> EntityItemProperties
+
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    properties = EntityItemProperties();
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        properties.setOwningAvatarID(myNodeID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
+
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
+
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
+        }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
+        }
+    }
+}
 
 bool EntityTree::readFromMap(QVariantMap& map) {
     // These are needed to deal with older content (before adding inheritance modes)
@@ -2752,185 +2937,378 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
     // to add the new entity to the EntityTree.
-    QVariantList entitiesQList = map["Entities"].toList();
-    QScriptEngine scriptEngine;
+    const QVariantList entitiesQList = map["Entities"].toList();
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
         return false;
     }
 
+    // Converting is independent for every entity, so it is spread over the cores with a script engine
+    // for each thread. Wearables look up the joints of my avatar while converting, which has to stay
+    // on this thread. Adding to the tree happens here in spatially sorted batches.
+    const int BATCH_SIZE = 4096;
+    int numEntities = entitiesQList.size();
+    std::vector<EntityItemID> entityIDs(std::min(numEntities, BATCH_SIZE));
+    std::vector<EntityItemProperties> properties(entityIDs.size());
+    std::vector<int> indices;
     QMap<QUuid, QVector<QUuid>> cloneIDs;
 
     bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
-
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+    for (int batchStart = 0; batchStart < numEntities; batchStart += BATCH_SIZE) {
+        int batchSize = std::min(numEntities - batchStart, BATCH_SIZE);
+
+        auto convertRange = [&](int begin, int end) {
+            QScriptEngine scriptEngine;
+            for (int i = begin; i < end; ++i) {
+                QVariantMap entityMap = entitiesQList.at(batchStart + i).toMap();
+                propertiesFromMap(entityMap, contentVersion, scriptEngine, entityIDs[i], properties[i]);
+            }
+        };
+        if (_myAvatar) {
+            convertRange(0, batchSize);
+        } else {
+            forEachRangeInParallel(batchSize, MIN_ENTITIES_PER_THREAD, convertRange);
+        }
 
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+        indices.resize(batchSize);
+        std::iota(indices.begin(), indices.end(), 0);
+        if (!addEntitiesInSpatialOrder(entityIDs, properties, indices, cloneIDs)) {
+            success = false;
+        }
+    }
 
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
         }
+    }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+    return success;
+}
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
-        }
+bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+    withReadLock([&] {
+        recurseTreeWithOperator(&theOperator);
+    });
+
+    jsonString = theOperator.getJson();
+    return true;
+}
+
+// Encodes the entity as the edit packet that would add it, the way it is persisted in the binary format
+// and in the journal. Returns false if the entity is too large for an edit packet.
+static bool encodeEntityForPersist(const EntityItemPointer& entity, QByteArray& buffer) {
+    const int INITIAL_ENTITY_BUFFER_SIZE = 64 * 1024;
+    const int MAX_ENTITY_BUFFER_SIZE = 64 * 1024 * 1024;
+
+    EntityItemProperties properties = entity->getProperties();
+    properties.markAllChanged();
+    EntityPropertyFlags requestedProperties = properties.getChangedProperties();
+    requestedProperties -= PROP_SIMULATION_OWNER; // not persisted in JSON either
+
+    EntityPropertyFlags didntFitProperties;
+    int bufferSize = INITIAL_ENTITY_BUFFER_SIZE;
+    OctreeElement::AppendState appendState;
+    do {
+        buffer.resize(bufferSize);
+        appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entity->getEntityItemID(),
+                                                                   properties, buffer, requestedProperties,
+                                                                   didntFitProperties);
+        bufferSize *= 2;
+    } while (appendState != OctreeElement::COMPLETED && bufferSize <= MAX_ENTITY_BUFFER_SIZE);
+
+    if (appendState != OctreeElement::COMPLETED) {
+        qCWarning(entities) << "Entity too large to persist:" << entity->getEntityItemID();
+        return false;
+    }
+    return true;
+}
+
+bool EntityTree::writeToBinary(QByteArray& data, const OctreeElementPointer& element) {
+    // each entity is stored as the edit packet that would add it, preceded by its size
+    OctreeUtils::BinaryOctreeHeader header;
+    header.dataPacketVersion = versionForPacketType(expectedDataPacketType());
+    header.setID(_persistID);
+    header.dataVersion = _persistDataVersion;
+
+    data.resize(sizeof(header));
+    QByteArray buffer;
+    bool success = true;
+
+    withReadLock([&] {
+        QReadLocker locker(&_entityMapLock);
+        data.reserve(data.size() + _entityMap.size() * 256);
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        for (const auto& entity : _entityMap) {
+            if (!encodeEntityForPersist(entity, buffer)) {
+                success = false;
+                continue;
             }
+
+            uint32_t recordSize = buffer.size();
+            data.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+            data.append(buffer);
+            ++header.numRecords;
         }
+    });
+
+    memcpy(data.data(), &header, sizeof(header));
+    return success;
+}
+
+bool EntityTree::readFromBinary(const unsigned char* data, qint64 size) {
+    OctreeUtils::BinaryOctreeHeader header;
+    if (!OctreeUtils::readBinaryOctreeHeader(data, size, header)) {
+        qCWarning(entities) << "Not a binary entities file";
+        return false;
+    }
+    if (header.dataPacketVersion != versionForPacketType(expectedDataPacketType())) {
+        // edit packets don't carry enough to convert old content, that is what the JSON is for
+        qCWarning(entities) << "Binary entities file was written for entity version" << header.dataPacketVersion;
+        return false;
+    }
+
+    _persistID = header.getID();
+    _persistDataVersion = header.dataVersion;
+    _namedPaths.clear();
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
+    // find the records first, so that they can be decoded out of order
+    struct Record {
+        qint64 offset;
+        uint32_t size;
+    };
+    std::vector<Record> records;
+    records.reserve(header.numRecords);
+    qint64 offset = sizeof(header);
+    for (uint32_t i = 0; i < header.numRecords; ++i) {
+        Record record;
+        if (offset + (qint64)sizeof(record.size) > size) {
+            break;
+        }
+        memcpy(&record.size, data + offset, sizeof(record.size));
+        record.offset = offset + sizeof(record.size);
+        if (record.offset + record.size > size) {
+            break;
         }
+        records.push_back(record);
+        offset = record.offset + record.size;
+    }
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    bool success = true;
+    int numRecords = (int)records.size();
+    if (numRecords != (int)header.numRecords) {
+        qCWarning(entities) << "Binary entities file is truncated, found" << numRecords << "of" << header.numRecords << "entities";
+        success = false;
+    }
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+    // Decoding is independent for every entity, so it is spread over the cores. Adding to the tree is not,
+    // it happens here in spatially sorted batches small enough to keep the decoded properties from piling up.
+    const int BATCH_SIZE = 4096;
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
+    std::vector<EntityItemID> entityIDs(std::min(numRecords, BATCH_SIZE));
+    std::vector<EntityItemProperties> properties(entityIDs.size());
+    std::vector<uint8_t> decoded(entityIDs.size());
+    std::vector<int> indices;
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+
+    for (int batchStart = 0; batchStart < numRecords; batchStart += BATCH_SIZE) {
+        int batchSize = std::min(numRecords - batchStart, BATCH_SIZE);
+
+        forEachRangeInParallel(batchSize, MIN_ENTITIES_PER_THREAD, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                const Record& record = records[batchStart + i];
+                int processedBytes = 0;
+                properties[i] = EntityItemProperties();
+                decoded[i] = EntityItemProperties::decodeEntityEditPacket(data + record.offset, (int)record.size, processedBytes,
+                                                                         entityIDs[i], properties[i]);
             }
+        });
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        indices.clear();
+        for (int i = 0; i < batchSize; ++i) {
+            if (decoded[i]) {
+                indices.push_back(i);
             } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+                qCDebug(entities) << "decoding Entity failed:" << batchStart + i;
+                success = false;
             }
         }
+        if (!addEntitiesInSpatialOrder(entityIDs, properties, indices, cloneIDs)) {
+            success = false;
+        }
+    }
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+    return success;
+}
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
-            }
-        }
+bool EntityTree::startJournal() {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    if (!_isJournaling) {
+        _isJournaling = true;
+        _journalChangedEntities.clear();
+        _journalDeletedEntities.clear();
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+        // the hooks are called with the tree locked for writing, from whichever thread made the change
+        connect(this, &EntityTree::addingEntity, this, &EntityTree::journalEntityChanged, Qt::DirectConnection);
+        connect(this, &EntityTree::editingEntityPointer, this, [this](const EntityItemPointer& entity) {
+            journalEntityChanged(entity->getEntityItemID());
+        }, Qt::DirectConnection);
+        connect(this, &EntityTree::deletingEntity, this, &EntityTree::journalEntityDeleted, Qt::DirectConnection);
+    }
+    return true;
+}
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
-            }
+void EntityTree::journalEntityChanged(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    _journalDeletedEntities.remove(entityID);
+    _journalChangedEntities.insert(entityID);
+}
+
+void EntityTree::journalEntityDeleted(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    _journalChangedEntities.remove(entityID);
+    _journalDeletedEntities.insert(entityID);
+}
+
+// Each journal record is its type, the size of its data and the data: the edit packet that would add the entity
+// for a change, its ID for a delete. Replaying the records in order brings the snapshot up to date.
+enum JournalRecordType : uint8_t {
+    JOURNAL_RECORD_CHANGE = 0,
+    JOURNAL_RECORD_DELETE = 1
+};
+
+static void appendJournalRecord(QByteArray& records, JournalRecordType type, const char* data, uint32_t size) {
+    records.append(reinterpret_cast<const char*>(&type), sizeof(type));
+    records.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    records.append(data, size);
+}
+
+bool EntityTree::writeJournalRecords(QByteArray& records) {
+    // NOTE: callers must lock the tree before using this method
+    QSet<EntityItemID> changedEntities;
+    QSet<EntityItemID> deletedEntities;
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+        if (!_isJournaling) {
+            return false;
         }
+        changedEntities.swap(_journalChangedEntities);
+        deletedEntities.swap(_journalDeletedEntities);
+    }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+    QByteArray buffer;
+    for (const auto& entityID : deletedEntities) {
+        QByteArray id = entityID.toRfc4122();
+        appendJournalRecord(records, JOURNAL_RECORD_DELETE, id.constData(), id.size());
+    }
+    for (const auto& entityID : changedEntities) {
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
+        if (!entity) {
+            // added and deleted again, after the delete was recorded
+            continue;
         }
+        if (!encodeEntityForPersist(entity, buffer)) {
+            // the journal would be missing this change, only a snapshot will do
+            return false;
+        }
+        appendJournalRecord(records, JOURNAL_RECORD_CHANGE, buffer.constData(), buffer.size());
+    }
+    return true;
+}
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+bool EntityTree::readJournalRecords(const unsigned char* data, qint64 size) {
+    const qint64 RECORD_HEADER_SIZE = sizeof(JournalRecordType) + sizeof(uint32_t);
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = true;
+
+    qint64 offset = 0;
+    while (offset + RECORD_HEADER_SIZE <= size) {
+        JournalRecordType type = (JournalRecordType)data[offset];
+        uint32_t recordSize;
+        memcpy(&recordSize, data + offset + sizeof(JournalRecordType), sizeof(recordSize));
+        const unsigned char* recordData = data + offset + RECORD_HEADER_SIZE;
+        offset += RECORD_HEADER_SIZE + recordSize;
+        if (offset > size) {
+            break;
         }
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
-            }
+        if (type == JOURNAL_RECORD_DELETE) {
+            EntityItemID entityID(QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(recordData),
+                                                                             recordSize)));
+            deleteEntity(entityID, true);
+            continue;
         }
 
-        EntityItemPointer entity = addEntity(entityItemID, properties);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+        EntityItemID entityID;
+        EntityItemProperties properties;
+        int processedBytes = 0;
+        if (type != JOURNAL_RECORD_CHANGE ||
+            !EntityItemProperties::decodeEntityEditPacket(recordData, (int)recordSize, processedBytes, entityID, properties)) {
+            qCDebug(entities) << "decoding journaled Entity failed at" << offset;
             success = false;
+            continue;
         }
 
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
         if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+            // the record holds every property of the entity, it replaces them whatever the locks say
+            EntityTreeElementPointer containingElement = entity->getElement();
+            if (containingElement) {
+                UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, properties.getQueryAACube());
+                recurseTreeWithOperator(&theOperator);
+            }
+            entity->setProperties(properties);
+            if (!entity->getParentID().isNull()) {
+                addToNeedsParentFixupList(entity);
+            }
+            _isDirty = true;
+        } else {
+            entity = addEntity(entityID, properties);
+            if (!entity) {
+                qCDebug(entities) << "adding journaled Entity failed:" << entityID << properties.getType();
+                success = false;
+                continue;
             }
         }
+
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
     }
+    fixupNeedsParentFixups();
 
     for (const auto& entityID : cloneIDs.keys()) {
         auto entity = findEntityByID(entityID);
         if (entity) {
-            entity->setCloneIDs(cloneIDs.value(entityID));
+            QVector<QUuid> entityCloneIDs = entity->getCloneIDs();
+            for (const auto& cloneID : cloneIDs.value(entityID)) {
+                if (!entityCloneIDs.contains(cloneID)) {
+                    entityCloneIDs.push_back(cloneID);
+                }
+            }
+            entity->setCloneIDs(entityCloneIDs);
         }
     }
 
+    if (offset != size) {
+        qCWarning(entities) << "Entity journal ends with an incomplete record";
+        success = false;
+    }
     return success;
 }
 
-bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
-    QScriptEngine scriptEngine;
-    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
-    withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
-    });
-
-    jsonString = theOperator.getJson();
-    return true;
-}
-
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
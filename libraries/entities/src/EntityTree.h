@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <mutex>
+
 #include <QSet>
 #include <QVector>
 
@@ -23,6 +25,8 @@
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
 
+class QScriptEngine;
+
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
@@ -199,6 +203,11 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToBinary(QByteArray& data, const OctreeElementPointer& element) override;
+    virtual bool readFromBinary(const unsigned char* data, qint64 size) override;
+    virtual bool startJournal() override;
+    virtual bool writeJournalRecords(QByteArray& records) override;
+    virtual bool readJournalRecords(const unsigned char* data, qint64 size) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -390,8 +399,23 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    // entities added, edited or deleted since the last writeJournalRecords
+    std::mutex _journalMutex;
+    bool _isJournaling { false };
+    QSet<EntityItemID> _journalChangedEntities;
+    QSet<EntityItemID> _journalDeletedEntities;
+
     void updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                        MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
+
+    void propertiesFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                           EntityItemID& entityItemID, EntityItemProperties& properties) const;
+    void journalEntityChanged(const EntityItemID& entityID);
+    void journalEntityDeleted(const EntityItemID& entityID);
+
+    bool addEntitiesInSpatialOrder(const std::vector<EntityItemID>& entityIDs,
+                                   const std::vector<EntityItemProperties>& properties, std::vector<int>& indices,
+                                   QMap<QUuid, QVector<QUuid>>& cloneIDs);
 };
 
 void convertGrabUserDataToProperties(EntityItemProperties& properties);
@@ -156,15 +156,18 @@ public:
         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
 
+    // iterates over a copy-on-write snapshot of the entities, so that the element
+    // isn't locked against edits while f runs
     template <typename F>
     void forEachEntity(F f) const {
-        withReadLock([&] {
-            foreach(EntityItemPointer entityItem, _entityItems) {
-                f(entityItem);
-            }
-        });
+        EntityItems entityItems = getEntitiesSnapshot();
+        foreach(EntityItemPointer entityItem, entityItems) {
+            f(entityItem);
+        }
     }
 
+    EntityItems getEntitiesSnapshot() const { return resultWithReadLock<EntityItems>([&] { return _entityItems; }); }
+
     virtual uint16_t size() const;
     bool hasEntities() const { return size() > 0; }
 
@@ -0,0 +1,140 @@
+//
+//  AssetFileCache.cpp
+//  libraries/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include "NetworkLogging.h"
+
+const qint64 AssetFileCache::DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+MappedAssetFile::~MappedAssetFile() {
+    if (_data) {
+        _file.unmap((uchar*)_data);
+    }
+}
+
+bool MappedAssetFile::map() {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    _size = _file.size();
+    if (_size == 0) {
+        // there is nothing to map in an empty file
+        return true;
+    }
+    _data = (const char*)_file.map(0, _size);
+    if (!_data) {
+        qCWarning(networking) << "Failed to map asset file" << _file.fileName() << _file.errorString();
+        return false;
+    }
+    // the mapping stays valid once the file is closed
+    _file.close();
+    return true;
+}
+
+void AssetFileCache::setFilesDirectory(const QDir& filesDirectory) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _filesDirectory = filesDirectory;
+}
+
+void AssetFileCache::setMaxSize(qint64 maxSize) {
+    std::vector<MappedAssetFilePointer> evictedFiles;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxSize = maxSize;
+    evict(evictedFiles);
+}
+
+MappedAssetFilePointer AssetFileCache::getFile(const AssetUtils::AssetHash& hash) {
+    std::vector<MappedAssetFilePointer> evictedFiles;
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // wait for any other task already mapping this file
+    _fileMapped.wait(lock, [&] { return !_filesBeingMapped.contains(hash); });
+
+    auto it = _files.find(hash);
+    if (it != _files.end()) {
+        if (auto file = it->file.lock()) {
+            if (it->cachedFile) {
+                _leastRecentlyUsed.splice(_leastRecentlyUsed.begin(), _leastRecentlyUsed, it->lruPosition);
+            }
+            return file;
+        }
+        // released, its entry is about to be removed
+        _files.erase(it);
+    }
+
+    _filesBeingMapped.insert(hash);
+    QString filePath = _filesDirectory.filePath(hash);
+    lock.unlock();
+
+    std::unique_ptr<MappedAssetFile> mappedFile(new MappedAssetFile(filePath));
+    bool mapped = mappedFile->map();
+
+    lock.lock();
+    _filesBeingMapped.remove(hash);
+    _fileMapped.notify_all();
+
+    if (!mapped) {
+        return MappedAssetFilePointer();
+    }
+
+    // the entry goes away with the mapping, whether the file was cached or not
+    MappedAssetFilePointer file(mappedFile.release(), [this, hash](const MappedAssetFile* releasedFile) {
+        delete releasedFile;
+        releaseFile(hash);
+    });
+
+    Entry& entry = _files[hash];
+    entry.file = file;
+    if (file->getSize() <= _maxSize) {
+        entry.cachedFile = file;
+        _leastRecentlyUsed.push_front(hash);
+        entry.lruPosition = _leastRecentlyUsed.begin();
+        _size += file->getSize();
+        evict(evictedFiles);
+    }
+    return file;
+}
+
+void AssetFileCache::removeFile(const AssetUtils::AssetHash& hash) {
+    MappedAssetFilePointer removedFile;
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _files.find(hash);
+    if (it != _files.end()) {
+        if (it->cachedFile) {
+            _size -= it->cachedFile->getSize();
+            _leastRecentlyUsed.erase(it->lruPosition);
+            removedFile = std::move(it->cachedFile);
+        }
+        _files.erase(it);
+    }
+}
+
+void AssetFileCache::releaseFile(const AssetUtils::AssetHash& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _files.find(hash);
+    // unless the file was mapped again since
+    if (it != _files.end() && !it->cachedFile && it->file.expired()) {
+        _files.erase(it);
+    }
+}
+
+void AssetFileCache::evict(std::vector<MappedAssetFilePointer>& evictedFiles) {
+    while (_size > _maxSize && !_leastRecentlyUsed.empty()) {
+        auto it = _files.find(_leastRecentlyUsed.back());
+        _leastRecentlyUsed.pop_back();
+        if (it != _files.end() && it->cachedFile) {
+            _size -= it->cachedFile->getSize();
+            // files still being sent stay mapped until their tasks are done
+            evictedFiles.push_back(std::move(it->cachedFile));
+        }
+    }
+}
@@ -0,0 +1,98 @@
+//
+//  AssetFileCache.h
+//  libraries/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+#include "AssetUtils.h"
+
+class AssetFileCacheTests;
+
+// An asset file mapped into memory, unmapped once the last task sending it lets go of it
+class MappedAssetFile {
+public:
+    MappedAssetFile(const QString& filePath) : _file(filePath) {}
+    ~MappedAssetFile();
+
+    bool map();
+
+    const char* getData() const { return _data; }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    const char* _data { nullptr };
+    qint64 _size { 0 };
+};
+
+using MappedAssetFilePointer = std::shared_ptr<const MappedAssetFile>;
+
+// Keeps the most recently requested asset files mapped, up to a total size, so that a crowd asking
+// for the same assets doesn't read them from disk over and over. Concurrent requests for a file that
+// is being mapped wait for it rather than mapping it again.
+// Thread safe, it is shared by all the send tasks of the asset server. The files it returns must be
+// released before it is destroyed.
+class AssetFileCache {
+public:
+    AssetFileCache(qint64 maxSize = DEFAULT_MAX_SIZE) : _maxSize(maxSize) {}
+
+    static const qint64 DEFAULT_MAX_SIZE;
+
+    void setFilesDirectory(const QDir& filesDirectory);
+    void setMaxSize(qint64 maxSize);
+
+    /// returns nullptr if the asset can't be read
+    MappedAssetFilePointer getFile(const AssetUtils::AssetHash& hash);
+
+    /// forget about an asset, call before deleting its file
+    void removeFile(const AssetUtils::AssetHash& hash);
+
+private:
+    // the files evicted are released by the caller, once the cache is unlocked
+    void evict(std::vector<MappedAssetFilePointer>& evictedFiles);
+
+    // called once the last task using a file lets go of it
+    void releaseFile(const AssetUtils::AssetHash& hash);
+
+    struct Entry {
+        // every file currently mapped, whether it is cached or still held by a send task
+        std::weak_ptr<const MappedAssetFile> file;
+        // set while the file is cached
+        MappedAssetFilePointer cachedFile;
+        std::list<AssetUtils::AssetHash>::iterator lruPosition;
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _fileMapped;
+
+    QDir _filesDirectory;
+    qint64 _maxSize;
+    qint64 _size { 0 };
+
+    QHash<AssetUtils::AssetHash, Entry> _files;
+    std::list<AssetUtils::AssetHash> _leastRecentlyUsed; // most recently used first
+    QSet<AssetUtils::AssetHash> _filesBeingMapped;
+
+    friend class ::AssetFileCacheTests;
+};
+
+#endif // hifi_AssetFileCache_h
@@ -19,29 +19,58 @@
 #include <cassert>
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(HMAC_CTX_new())
-    , _authMethod(authMethod) { }
+static HMAC_CTX* newContext() {
+    return HMAC_CTX_new();
+}
 
-HMACAuth::~HMACAuth()
-{
-    HMAC_CTX_free(_hmacContext);
+static void freeContext(HMAC_CTX* context) {
+    HMAC_CTX_free(context);
+}
+
+static bool copyContext(HMAC_CTX* destination, HMAC_CTX* source) {
+    return (bool) HMAC_CTX_copy(destination, source);
 }
 
 #else
 
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(new HMAC_CTX())
-    , _authMethod(authMethod) {
-    HMAC_CTX_init(_hmacContext);
+static HMAC_CTX* newContext() {
+    auto context = new HMAC_CTX();
+    HMAC_CTX_init(context);
+    return context;
 }
 
-HMACAuth::~HMACAuth() {
-    HMAC_CTX_cleanup(_hmacContext);
-    delete _hmacContext;
+static void freeContext(HMAC_CTX* context) {
+    HMAC_CTX_cleanup(context);
+    delete context;
+}
+
+static bool copyContext(HMAC_CTX* destination, HMAC_CTX* source) {
+    // older versions don't release the destination state before copying over it
+    HMAC_CTX_cleanup(destination);
+    HMAC_CTX_init(destination);
+    return (bool) HMAC_CTX_copy(destination, source);
 }
 #endif
 
+class HMACAuth::KeyContext {
+public:
+    KeyContext() : context(newContext()) { }
+    ~KeyContext() { freeContext(context); }
+
+    HMAC_CTX* context;
+};
+
+// Each thread hashes in its own context, whatever the key
+static HMAC_CTX* threadContext() {
+    static thread_local std::unique_ptr<HMAC_CTX, void(*)(HMAC_CTX*)> context { newContext(), &freeContext };
+    return context.get();
+}
+
+HMACAuth::HMACAuth(AuthMethod authMethod)
+    : _authMethod(authMethod) { }
+
+HMACAuth::~HMACAuth() { }
+
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
     const EVP_MD* sslStruct = nullptr;
 
@@ -70,8 +99,14 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
         return false;
     }
 
-    QMutexLocker lock(&_lock);
-    return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+    auto keyContext = std::make_shared<KeyContext>();
+    if (!HMAC_Init_ex(keyContext->context, keyValue, keyLen, sslStruct, nullptr)) {
+        return false;
+    }
+
+    // hashes already running finish with the previous key
+    std::atomic_store(&_keyContext, std::shared_ptr<const KeyContext>(keyContext));
+    return true;
 }
 
 bool HMACAuth::setKey(const QUuid& uidKey) {
@@ -79,39 +114,31 @@ bool HMACAuth::setKey(const QUuid& uidKey) {
     return setKey(rfcBytes.constData(), rfcBytes.length());
 }
 
-bool HMACAuth::addData(const char* data, int dataLen) {
-    QMutexLocker lock(&_lock);
-    return (bool) HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
-}
+bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) const {
+    auto keyContext = std::atomic_load(&_keyContext);
+    if (!keyContext) {
+        qCWarning(networking) << "HMACAuth::calculateHash() called before setting a key";
+        return false;
+    }
 
-HMACAuth::HMACHash HMACAuth::result() {
-    HMACHash hashValue(EVP_MAX_MD_SIZE);
+    auto context = threadContext();
+    if (!copyContext(context, keyContext->context) ||
+        !HMAC_Update(context, reinterpret_cast<const unsigned char*>(data), dataLen)) {
+        qCWarning(networking) << "Error occured calling HMAC_Update";
+        assert(false);
+        return false;
+    }
+
+    hashResult.resize(EVP_MAX_MD_SIZE);
     unsigned int hashLen;
-    QMutexLocker lock(&_lock);
-    
-    auto hmacResult = HMAC_Final(_hmacContext, &hashValue[0], &hashLen);
-    
+    auto hmacResult = HMAC_Final(context, &hashResult[0], &hashLen);
+
     if (hmacResult) {
-        hashValue.resize((size_t)hashLen);
+        hashResult.resize((size_t)hashLen);
     } else {
         // the HMAC_FINAL call failed - should not be possible to get into this state
         qCWarning(networking) << "Error occured calling HMAC_Final";
         assert(hmacResult);
     }
-
-    // Clear state for possible reuse.
-    HMAC_Init_ex(_hmacContext, nullptr, 0, nullptr, nullptr);
-    return hashValue;
-}
-
-bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
-    QMutexLocker lock(&_lock);
-    if (!addData(data, dataLen)) {
-        qCWarning(networking) << "Error occured calling HMACAuth::addData()";
-        assert(false);
-        return false;
-    }
-
-    hashResult = result();
-    return true;
+    return (bool) hmacResult;
 }
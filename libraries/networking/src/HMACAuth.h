@@ -12,9 +12,8 @@
 #ifndef hifi_HMACAuth_h
 #define hifi_HMACAuth_h
 
-#include <vector>
 #include <memory>
-#include <QtCore/QMutex>
+#include <vector>
 
 class QUuid;
 
@@ -29,18 +28,14 @@ public:
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
     // Calculate complete hash in one.
-    bool calculateHash(HMACHash& hashResult, const char* data, int dataLen);
-
-    // Append to data to be hashed.
-    bool addData(const char* data, int dataLen);
-    // Get the resulting hash from calls to addData().
-    // Note that only one hash may be calculated at a time for each
-    // HMACAuth instance if this interface is used.
-    HMACHash result();
+    // Thread safe, concurrent hashes with the same key run in parallel on per-thread contexts.
+    bool calculateHash(HMACHash& hashResult, const char* data, int dataLen) const;
 
 private:
-    QMutex _lock { QMutex::Recursive };
-    struct hmac_ctx_st* _hmacContext;
+    // The HMAC state right after the key was set, copied to start each hash
+    // rather than running the key schedule again.
+    class KeyContext;
+    std::shared_ptr<const KeyContext> _keyContext; // only accessed with std::atomic_load and std::atomic_store
     AuthMethod _authMethod;
 };
 
@@ -115,6 +115,11 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
 
+    // audio and avatar data are the unreliable streams worth protecting with forward error correction
+    _nodeSocket.setFECPacketFilterOperator([](const udt::Packet& packet) {
+        return PacketTypeEnum::getForwardErrorCorrectedPackets().contains(NLPacket::typeInHeader(packet));
+    });
+
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
 
@@ -71,7 +71,7 @@ public:
     
     static LocalID sourceIDInHeader(const udt::Packet& packet);
     static QByteArray verificationHashInHeader(const udt::Packet& packet);
-    static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash);
+    static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, const HMACAuth& hash);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -82,7 +82,7 @@ public:
     LocalID getSourceID() const { return _sourceID; }
     
     void writeSourceID(LocalID sourceID) const;
-    void writeVerificationHash(HMACAuth& hmacAuth) const;
+    void writeVerificationHash(const HMACAuth& hmacAuth) const;
 
 protected:
     
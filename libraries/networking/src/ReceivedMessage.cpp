@@ -12,6 +12,8 @@
 
 #include "ReceivedMessage.h"
 
+#include <algorithm>
+
 #include "QSharedPointer"
 
 int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
@@ -22,6 +24,7 @@ static const int HEAD_DATA_SIZE = 512;
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
     : _data(packetList.getMessage()),
       _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _size(_data.size()),
       _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
@@ -33,6 +36,7 @@ ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
     : _data(packet.readAll()),
       _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _size(_data.size()),
       _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
@@ -46,6 +50,7 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
                 const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID) :
     _data(byteArray),
     _headData(_data.mid(0, HEAD_DATA_SIZE)),
+    _size(_data.size()),
     _numPackets(1),
     _sourceID(sourceID),
     _packetType(packetType),
@@ -61,7 +66,45 @@ void ReceivedMessage::setFailed() {
     emit completed();
 }
 
-void ReceivedMessage::appendPacket(NLPacket& packet) {
+QByteArray ReceivedMessage::getMessage() const {
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    if (_segmentPackets.empty()) {
+        return _data;
+    }
+
+    return flatten();
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    if (_segmentPackets.empty()) {
+        return _data.constData();
+    }
+
+    // the segments stay around, so that what was read from them without a copy stays valid
+    if (_flattenedData.size() != _size) {
+        _flattenedData = flatten();
+    }
+    return _flattenedData.constData();
+}
+
+std::vector<QByteArray> ReceivedMessage::getSegments() const {
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+
+    std::vector<QByteArray> segments;
+    segments.reserve(_segmentPackets.size() + 1);
+
+    if (!_data.isEmpty()) {
+        segments.push_back(QByteArray::fromRawData(_data.constData(), _data.size()));
+    }
+    for (const auto& packet : _segmentPackets) {
+        segments.push_back(QByteArray::fromRawData(packet->getPayload(), packet->getPayloadSize()));
+    }
+
+    return segments;
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
@@ -70,27 +113,100 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    bool isLastPacket = packet->getPacketPosition() == NLPacket::PacketPosition::LAST;
+
+    if (packet->getPayloadSize() > 0) {
+        // the packet is kept as is, without touching _data - a reader can be going through it on another thread
+        std::lock_guard<std::mutex> lock(_segmentsMutex);
+        _segmentPositions.push_back(_size);
+        _size += packet->getPayloadSize();
+        _segmentPackets.push_back(std::move(packet));
+    }
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
 
-    if (packet.getPacketPosition() == NLPacket::PacketPosition::LAST) {
+    if (isLastPacket) {
         _isComplete = true;
         emit completed();
     }
 }
 
+qint64 ReceivedMessage::copyData(qint64 position, char* data, qint64 size) const {
+    size = std::max(std::min(size, _size - position), (qint64)0);
+
+    // _data never changes once the message is created, only segments get appended
+    if (position + size <= _data.size()) {
+        memcpy(data, _data.constData() + position, size);
+        return size;
+    }
+
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+
+    qint64 bytesCopied = 0;
+    if (position < _data.size()) {
+        bytesCopied = _data.size() - position;
+        memcpy(data, _data.constData() + position, bytesCopied);
+    }
+
+    // find the segment the rest starts in, then copy segment by segment
+    auto it = std::upper_bound(_segmentPositions.begin(), _segmentPositions.end(), position + bytesCopied);
+    size_t index = std::distance(_segmentPositions.begin(), it) - 1;
+
+    while (bytesCopied < size && index < _segmentPackets.size()) {
+        const auto& packet = _segmentPackets[index];
+        qint64 offset = position + bytesCopied - _segmentPositions[index];
+        qint64 bytesToCopy = std::min(packet->getPayloadSize() - offset, size - bytesCopied);
+
+        memcpy(data + bytesCopied, packet->getPayload() + offset, bytesToCopy);
+        bytesCopied += bytesToCopy;
+        ++index;
+    }
+
+    return bytesCopied;
+}
+
+const char* ReceivedMessage::contiguousData(qint64 position, qint64 size) const {
+    if (position + size <= _data.size()) {
+        return _data.constData() + position;
+    }
+
+    {
+        // no need to flatten the message if the data is all in one segment
+        std::lock_guard<std::mutex> lock(_segmentsMutex);
+        auto it = std::upper_bound(_segmentPositions.begin(), _segmentPositions.end(), position);
+        if (it != _segmentPositions.begin()) {
+            size_t index = std::distance(_segmentPositions.begin(), it) - 1;
+            qint64 offset = position - _segmentPositions[index];
+            const auto& packet = _segmentPackets[index];
+            if (offset + size <= packet->getPayloadSize()) {
+                return packet->getPayload() + offset;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+QByteArray ReceivedMessage::flatten() const {
+    QByteArray data;
+    data.reserve((int)_size);
+    data.append(_data);
+    for (const auto& packet : _segmentPackets) {
+        data.append(packet->getPayload(), packet->getPayloadSize());
+    }
+    return data;
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
-    return size;
+    return copyData(_position, data, size);
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
-    _position += size;
-    return size;
+    auto bytesRead = copyData(_position, data, size);
+    _position += bytesRead;
+    return bytesRead;
 }
 
 qint64 ReceivedMessage::readHead(char* data, qint64 size) {
@@ -100,12 +216,18 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    if (_position + size <= _data.size()) {
+        return _data.mid(_position, size);
+    }
+
+    QByteArray data(std::max(std::min(size, getBytesLeftToRead()), (qint64)0), Qt::Uninitialized);
+    copyData(_position, data.data(), data.size());
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
-    _position += size;
+    auto data = peek(size);
+    _position += data.size();
     return data;
 }
 
@@ -123,15 +245,24 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
-    _position += size;
-    return string;
+    if (auto data = contiguousData(_position, size)) {
+        auto string = QString::fromUtf8(data, size);
+        _position += size;
+        return string;
+    }
+
+    return QString::fromUtf8(read(size));
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    auto data = contiguousData(_position, size);
+    if (!data) {
+        // the data spans segments, it can only be returned as a copy
+        return read(size);
+    }
+
     _position += size;
-    return data;
+    return QByteArray::fromRawData(data, size);
 }
 
 void ReceivedMessage::onComplete() {
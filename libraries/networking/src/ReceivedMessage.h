@@ -16,6 +16,9 @@
 #include <QObject>
 
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
@@ -27,15 +30,21 @@ public:
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // These copy a multi-packet message into a single buffer, getRawMessage keeps it until more packets come in
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
+
+    // The message in the segments it came in, one per packet, to parse it without flattening it first.
+    // Like readWithoutCopy, the segments reference the message's data: they must not outlive it.
+    std::vector<QByteArray> getSegments() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
 
     void setFailed();
 
-    void appendPacket(NLPacket& packet);
+    // Keeps the packet as a segment of the message, its payload is not copied
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -48,9 +57,9 @@ public:
     // Get the number of packets that were used to send this message
     qint64 getNumPackets() const { return _numPackets; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size - _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -71,7 +80,7 @@ public:
 
     // This will return a QByteArray referencing the underlying data _without_ refcounting that data.
     // Be careful when using this method, only use it when the lifetime of the returned QByteArray will not
-    // exceed that of the ReceivedMessage.
+    // exceed that of the ReceivedMessage. Data that spans two packets of the message is returned as a copy.
     QByteArray readWithoutCopy(qint64 size);
 
     template<typename T> qint64 peekPrimitive(T* data);
@@ -87,8 +96,19 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    qint64 copyData(qint64 position, char* data, qint64 size) const;
+    const char* contiguousData(qint64 position, qint64 size) const; // nullptr if the data spans segments
+    QByteArray flatten() const; // must hold _segmentsMutex
+
+    QByteArray _data; // the payload of the first packet
     QByteArray _headData;
+    mutable QByteArray _flattenedData; // the whole message, for getRawMessage
+    std::atomic<qint64> _size { 0 };
+
+    // packets appended after the first one, with the position each one starts at
+    mutable std::mutex _segmentsMutex;
+    mutable std::vector<std::unique_ptr<NLPacket>> _segmentPackets;
+    mutable std::vector<qint64> _segmentPositions;
 
     std::atomic<qint64> _position { 0 };
     std::atomic<qint64> _numPackets { 0 };
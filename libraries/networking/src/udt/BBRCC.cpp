@@ -0,0 +1,404 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include <QtCore/QtGlobal>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2 / ln(2), the smallest gain that doubles the sending rate every round trip during startup
+static const double HIGH_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / HIGH_GAIN;
+static const double PROBE_BANDWIDTH_WINDOW_GAIN = 2.0;
+
+// probe for more bandwidth for one min RTT, drain the queue that may have built for another, then cruise
+static const double PACING_GAIN_CYCLE[] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+static const int PACING_GAIN_CYCLE_LENGTH = sizeof(PACING_GAIN_CYCLE) / sizeof(PACING_GAIN_CYCLE[0]);
+
+static const int BANDWIDTH_FILTER_ROUNDS = 10;
+static const microseconds MIN_RTT_FILTER_WINDOW = seconds(10);
+static const microseconds PROBE_RTT_DURATION = milliseconds(200);
+
+// the pipe is considered full once the bandwidth grew by less than 25% for three rounds in a row
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int INITIAL_WINDOW_PACKETS = 16;
+static const int MIN_WINDOW_PACKETS = 4;
+// extra packets allowed in flight to absorb delayed and aggregated ACKs
+static const int WINDOW_ALLOWANCE_PACKETS = 3;
+
+static const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+// timeout until the first RTT sample, as TCP's initial retransmission timeout -
+// re-sending everything after DEFAULT_SYN_INTERVAL on a long RTT path would leave no unambiguous RTT sample
+static const int INITIAL_TIMEOUT_MICROSECONDS = 1000000;
+
+BBRCC::BBRCC() {
+    // unpaced until the first bandwidth sample comes in
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_WINDOW_PACKETS;
+    _windowSize = INITIAL_WINDOW_PACKETS;
+
+    // we can't do this as a member initializer until our VS has support for constexpr
+    _minRTT = std::numeric_limits<int>::max();
+
+    enterStartup();
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+    _lastACK = ack;
+
+    bool wasDuplicateACK = (ack == previousAck);
+
+    if (!wasDuplicateACK) {
+        int numACKed = seqlen(previousAck, ack) - 1;
+
+        // packets already counted from duplicate ACKs are not delivered again
+        int numNewlyDelivered = std::max(numACKed - _numDuplicateDeliveries, 0);
+        _numDuplicateDeliveries = std::max(_numDuplicateDeliveries - numACKed, 0);
+
+        _delivered += numNewlyDelivered;
+        _deliveredTime = receiveTime;
+
+        bool isNewRound = false;
+
+        // this ACK covers every sent packet up to its sequence number
+        auto firstUnACKed = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& sentPacketData) {
+            return sentPacketData.sequenceNumber > ack;
+        });
+
+        if (firstUnACKed != _sentPacketDatas.begin() && (firstUnACKed - 1)->sequenceNumber == ack) {
+            // the RTT is ambiguous if any of the packets this ACK covers was re-sent
+            bool canBeUsedForRTT = std::none_of(_sentPacketDatas.begin(), firstUnACKed, [](SentPacketData& sentPacketData) {
+                return sentPacketData.wasResent;
+            });
+
+            SentPacketData sent = *(firstUnACKed - 1);
+
+            int rtt = (int)duration_cast<microseconds>(receiveTime - sent.timePoint).count();
+            if (canBeUsedForRTT && rtt >= 0) {
+                rtt = std::min(std::max(rtt, 1), MAX_RTT_SAMPLE_MICROSECONDS);
+                updateRTT(rtt);
+                updateMinRTT(rtt, receiveTime);
+            }
+
+            // a round trip ends when a packet sent after the previous round ended is delivered
+            if (sent.delivered >= _nextRoundDelivered) {
+                ++_roundCount;
+                _nextRoundDelivered = _delivered;
+                isNewRound = true;
+            }
+
+            // the delivery rate is measured over the longer of the send and the ACK intervals,
+            // so that ACK compression cannot inflate it
+            auto sendElapsed = sent.timePoint - sent.firstSentTime;
+            auto ackElapsed = receiveTime - sent.deliveredTime;
+            auto interval = duration_cast<microseconds>(std::max(sendElapsed, ackElapsed)).count();
+
+            _firstSentTime = sent.timePoint;
+
+            // a re-sent packet carries the delivery state of its first send, which would underestimate the rate
+            if (!sent.wasResent && interval > 0 && (!_hasMinRTT || interval >= _minRTT)) {
+                updateBottleneckBandwidth((_delivered - sent.delivered) * USECS_PER_SECOND / interval);
+            }
+        }
+
+        _sentPacketDatas.erase(_sentPacketDatas.begin(), firstUnACKed);
+
+        if (isNewRound && !_isPipeFull) {
+            checkFullPipe();
+        }
+
+        updateMode(receiveTime, isNewRound);
+        updatePacingAndWindow(numNewlyDelivered);
+    } else if (_numDuplicateDeliveries < std::min(seqoff(_lastACK, _sendCurrSeqNum), _windowSize)) {
+        // ACKs are cumulative, so a duplicate ACK means a packet after a lost one was delivered -
+        // count it now so that the delivery rate and the window don't stall until the loss is recovered.
+        // The window at most doubles this way, so that a loss that is not recovered still times out.
+        ++_delivered;
+        ++_numDuplicateDeliveries;
+        _deliveredTime = receiveTime;
+
+        updatePacingAndWindow(0);
+    }
+
+    ++_numACKSinceFastRetransmit;
+
+    // perform the fast re-transmit check if this is a duplicate ACK or if this is the first or second ACK
+    // after a previous fast re-transmit
+    if (wasDuplicateACK || _numACKSinceFastRetransmit < 3) {
+        if (needsFastRetransmit(ack, wasDuplicateACK)) {
+            onLoss(receiveTime);
+            return true;
+        }
+        return false;
+    } else {
+        _duplicateACKCount = 0;
+    }
+
+    // ACK processed, no fast re-transmit required
+    return false;
+}
+
+void BBRCC::updateRTT(int rtt) {
+    if (_ewmaRTT == -1) {
+        // first RTT sample - set _ewmaRTT to the value and set the variance to half the value
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        // same Jacobson's estimation as TCPVegasCC, only used for the timeout
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+}
+
+void BBRCC::updateMinRTT(int rtt, p_high_resolution_clock::time_point now) {
+    bool hasExpired = _hasMinRTT && (now - _minRTTTime) > MIN_RTT_FILTER_WINDOW;
+
+    if (!_hasMinRTT || rtt <= _minRTT || hasExpired) {
+        _minRTT = rtt;
+        _minRTTTime = now;
+        _hasMinRTT = true;
+    }
+
+    _minRTTExpired = hasExpired;
+}
+
+void BBRCC::updateBottleneckBandwidth(double deliveryRate) {
+    // windowed max filter - samples are kept oldest first, in decreasing order of bandwidth
+    while (!_bandwidthSamples.empty() && _bandwidthSamples.back().bandwidth <= deliveryRate) {
+        _bandwidthSamples.pop_back();
+    }
+    _bandwidthSamples.push_back({ _roundCount, deliveryRate });
+
+    while (_bandwidthSamples.front().round + BANDWIDTH_FILTER_ROUNDS <= _roundCount) {
+        _bandwidthSamples.pop_front();
+    }
+
+    _bottleneckBandwidth = _bandwidthSamples.front().bandwidth;
+}
+
+void BBRCC::checkFullPipe() {
+    if (_bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+        // still growing, keep searching
+        _fullBandwidth = _bottleneckBandwidth;
+        _fullBandwidthCount = 0;
+    } else if (++_fullBandwidthCount >= FULL_BANDWIDTH_ROUNDS) {
+        _isPipeFull = true;
+    }
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now, bool isNewRound) {
+    if (_mode == Mode::Startup && _isPipeFull) {
+        enterDrain();
+    }
+
+    if (_mode == Mode::Drain && packetsInFlight() <= targetWindowSize(1.0) - WINDOW_ALLOWANCE_PACKETS) {
+        enterProbeBandwidth();
+    }
+
+    if (_mode == Mode::ProbeBandwidth) {
+        // move to the next phase after a min RTT, or as soon as the queue is drained when below a gain of one
+        bool isFullLength = (now - _cycleTime) > microseconds(_minRTT);
+        bool isDrained = _pacingGain < 1.0 && packetsInFlight() <= targetWindowSize(1.0) - WINDOW_ALLOWANCE_PACKETS;
+
+        if (isFullLength || isDrained) {
+            _cycleIndex = (_cycleIndex + 1) % PACING_GAIN_CYCLE_LENGTH;
+            _cycleTime = now;
+            _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+        }
+    }
+
+    if (_minRTTExpired && _mode != Mode::ProbeRTT) {
+        enterProbeRTT();
+    }
+    _minRTTExpired = false;
+
+    if (_mode == Mode::ProbeRTT) {
+        if (!_isProbeRTTDoneTimeSet && packetsInFlight() <= MIN_WINDOW_PACKETS) {
+            // the window has drained, hold it there for a while and at least a round trip
+            _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+            _isProbeRTTDoneTimeSet = true;
+            _isProbeRTTRoundDone = false;
+            _nextRoundDelivered = _delivered;
+        } else if (_isProbeRTTDoneTimeSet) {
+            if (isNewRound) {
+                _isProbeRTTRoundDone = true;
+            }
+
+            if (_isProbeRTTRoundDone && now >= _probeRTTDoneTime) {
+                _minRTTTime = now;
+                _windowSize = std::max(_windowSize, _priorWindowSize);
+
+                if (_isPipeFull) {
+                    enterProbeBandwidth();
+                } else {
+                    enterStartup();
+                }
+            }
+        }
+    }
+}
+
+void BBRCC::updatePacingAndWindow(int numDelivered) {
+    if (_bottleneckBandwidth > 0.0) {
+        setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        _windowSize = std::min(_windowSize, MIN_WINDOW_PACKETS);
+    } else {
+        int targetWindow = targetWindowSize(_windowGain);
+
+        if (_isPipeFull) {
+            _windowSize = std::min(_windowSize + numDelivered, targetWindow);
+        } else if (_windowSize < targetWindow || _delivered < INITIAL_WINDOW_PACKETS) {
+            // still searching for the bandwidth, grow the window by the number of delivered packets
+            _windowSize += numDelivered;
+        }
+
+        _windowSize = std::max(std::min(_windowSize, udt::MAX_PACKETS_IN_FLIGHT), MIN_WINDOW_PACKETS);
+    }
+
+    // the send queue counts every packet after the last ACK as in flight, including those delivered after a loss
+    _congestionWindowSize = std::min(_windowSize + _numDuplicateDeliveries, udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+void BBRCC::onLoss(p_high_resolution_clock::time_point now) {
+    // Without selective ACKs the send queue recovers a single loss per round trip, so the burst of losses
+    // that follows overshooting the queue during startup or a probe takes long to recover.
+    // Stop growing on the first loss instead - random losses then only slow the search for the bandwidth down.
+    if (_mode == Mode::Startup) {
+        _isPipeFull = true;
+        enterDrain();
+    } else if (_mode == Mode::ProbeBandwidth && _pacingGain > 1.0) {
+        _cycleIndex = (_cycleIndex + 1) % PACING_GAIN_CYCLE_LENGTH;
+        _cycleTime = now;
+        _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+    }
+}
+
+void BBRCC::enterStartup() {
+    _mode = Mode::Startup;
+    _pacingGain = HIGH_GAIN;
+    _windowGain = HIGH_GAIN;
+}
+
+void BBRCC::enterDrain() {
+    _mode = Mode::Drain;
+    _pacingGain = DRAIN_GAIN;
+    _windowGain = HIGH_GAIN;
+}
+
+void BBRCC::enterProbeBandwidth() {
+    _mode = Mode::ProbeBandwidth;
+    _windowGain = PROBE_BANDWIDTH_WINDOW_GAIN;
+
+    // start at a random phase other than the one draining below the bandwidth
+    _cycleIndex = (2 + rand() % (PACING_GAIN_CYCLE_LENGTH - 1)) % PACING_GAIN_CYCLE_LENGTH;
+    _cycleTime = _deliveredTime;
+    _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+}
+
+void BBRCC::enterProbeRTT() {
+    _mode = Mode::ProbeRTT;
+    _pacingGain = 1.0;
+    _windowGain = 1.0;
+
+    _priorWindowSize = _windowSize;
+    _isProbeRTTDoneTimeSet = false;
+}
+
+bool BBRCC::needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK) {
+    // we may need to re-send ackNum + 1 if it has been more than our estimated timeout since it was sent
+
+    auto nextIt = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& packetTime){
+        return packetTime.sequenceNumber == ack + 1;
+    });
+
+    if (nextIt != _sentPacketDatas.end()) {
+        auto sinceSend = duration_cast<microseconds>(p_high_resolution_clock::now() - nextIt->timePoint).count();
+
+        if (sinceSend >= estimatedTimeout()) {
+            _numACKSinceFastRetransmit = 0;
+            return true;
+        }
+    }
+
+    // if this is the 3rd duplicate ACK, we fallback to Reno's fast re-transmit
+    static const int RENO_FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+    ++_duplicateACKCount;
+
+    if (wasDuplicateACK && _duplicateACKCount == RENO_FAST_RETRANSMIT_DUPLICATE_COUNT) {
+        // unlike TCPVegasCC the loss does not change the sending rate
+        _numACKSinceFastRetransmit = 0;
+        _duplicateACKCount = 0;
+        return true;
+    }
+
+    return false;
+}
+
+int BBRCC::packetsInFlight() const {
+    return std::max(seqoff(_lastACK, _sendCurrSeqNum) - _numDuplicateDeliveries, 0);
+}
+
+int BBRCC::targetWindowSize(double gain) const {
+    if (!_hasMinRTT || _bottleneckBandwidth <= 0.0) {
+        return INITIAL_WINDOW_PACKETS;
+    }
+
+    double bandwidthDelayProduct = _bottleneckBandwidth * _minRTT / USECS_PER_SECOND;
+    double targetWindow = std::ceil(gain * bandwidthDelayProduct) + WINDOW_ALLOWANCE_PACKETS;
+
+    return (int)std::min(targetWindow, (double)udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? INITIAL_TIMEOUT_MICROSECONDS : _ewmaRTT + _rttVariance * 4;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // nothing in flight, don't count the idle time in the next delivery rate sample
+        _firstSentTime = timePoint;
+        _deliveredTime = timePoint;
+    }
+
+    _sentPacketDatas.emplace_back(seqNum, timePoint, _delivered, _deliveredTime, _firstSentTime);
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](SentPacketData& sentPacketData){
+        return sentPacketData.sequenceNumber == seqNum;
+    });
+
+    // mark it as re-sent so we know it cannot be used for RTT calculations
+    if (it != _sentPacketDatas.end()) {
+        it->wasResent = true;
+    }
+}
@@ -0,0 +1,134 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <deque>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Congestion control modelled on BBR (https://queue.acm.org/detail.cfm?id=3022184).
+// Rather than reacting to loss or to growing delay, it keeps an estimate of the bottleneck bandwidth
+// (windowed max of the delivery rate) and of the round trip propagation time (windowed min of the RTT),
+// paces packets out at that bandwidth and keeps about one bandwidth-delay product in flight.
+// Random loss, as seen on Wi-Fi, therefore does not cut the sending rate down the way it does for TCPVegasCC.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+    virtual int estimatedRTT() const override { return _ewmaRTT == -1 ? 0 : _ewmaRTT; }
+    virtual int estimatedBandwidth() const override { return (int)_bottleneckBandwidth; }
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup, // exponential search for the bottleneck bandwidth
+        Drain, // drain the queue built during startup
+        ProbeBandwidth, // cruise at the bottleneck bandwidth, periodically probing for more
+        ProbeRTT // briefly shrink the window to measure the round trip propagation time again
+    };
+
+    struct SentPacketData {
+        SentPacketData(SequenceNumber seqNum, p_high_resolution_clock::time_point tPoint, int64_t delivered,
+                       p_high_resolution_clock::time_point deliveredTime, p_high_resolution_clock::time_point firstSentTime)
+            : sequenceNumber(seqNum), timePoint(tPoint), delivered(delivered),
+              deliveredTime(deliveredTime), firstSentTime(firstSentTime) {};
+
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point timePoint;
+        int64_t delivered; // number of packets delivered when this packet was sent
+        p_high_resolution_clock::time_point deliveredTime; // time of the last delivery when this packet was sent
+        p_high_resolution_clock::time_point firstSentTime; // send time of the last delivered packet when this one was sent
+        bool wasResent { false };
+    };
+
+    void updateRTT(int rtt);
+    void updateMinRTT(int rtt, p_high_resolution_clock::time_point now);
+    void updateBottleneckBandwidth(double deliveryRate);
+    void checkFullPipe();
+    void updateMode(p_high_resolution_clock::time_point now, bool isNewRound);
+    void updatePacingAndWindow(int numDelivered);
+    void onLoss(p_high_resolution_clock::time_point now);
+
+    void enterStartup();
+    void enterDrain();
+    void enterProbeBandwidth();
+    void enterProbeRTT();
+
+    bool needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK);
+
+    int packetsInFlight() const;
+    int targetWindowSize(double gain) const;
+
+    std::deque<SentPacketData> _sentPacketDatas; // sent packets not yet ACKed, in sequence order
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain { 1.0 };
+    double _windowGain { 1.0 };
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    int _numACKSinceFastRetransmit { 3 }; // Number of ACKs received since fast re-transmit, default avoids immediate re-transmit
+    int _duplicateACKCount { 0 }; // Counter for duplicate ACKs received
+
+    int64_t _delivered { 0 }; // number of packets delivered during the connection
+    int _numDuplicateDeliveries { 0 }; // packets counted as delivered from duplicate ACKs, not yet covered by an ACK
+    p_high_resolution_clock::time_point _deliveredTime; // time of the last delivery
+    p_high_resolution_clock::time_point _firstSentTime; // send time of the last delivered packet
+
+    int64_t _roundCount { 0 }; // number of round trips during the connection
+    int64_t _nextRoundDelivered { 0 }; // delivered count that marks the end of the current round trip
+
+    struct BandwidthSample {
+        int64_t round;
+        double bandwidth;
+    };
+    std::deque<BandwidthSample> _bandwidthSamples; // decreasing bandwidth samples for the windowed max filter
+    double _bottleneckBandwidth { 0.0 }; // windowed max of the delivery rate, in packets per second
+
+    int _minRTT; // windowed min RTT, in microseconds
+    p_high_resolution_clock::time_point _minRTTTime; // when the min RTT was last sampled
+    bool _hasMinRTT { false };
+    bool _minRTTExpired { false };
+
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT
+    int _rttVariance { 0 }; // Variance in collected RTT values
+
+    bool _isPipeFull { false }; // set once the bandwidth stops growing during startup
+    double _fullBandwidth { 0.0 }; // bandwidth at the last significant growth during startup
+    int _fullBandwidthCount { 0 }; // number of rounds without significant growth
+
+    int _cycleIndex { 0 }; // current phase of the probe bandwidth pacing gain cycle
+    p_high_resolution_clock::time_point _cycleTime; // when the current phase started
+
+    p_high_resolution_clock::time_point _probeRTTDoneTime; // when to leave probe RTT, once the window has drained
+    bool _isProbeRTTDoneTimeSet { false };
+    bool _isProbeRTTRoundDone { false };
+    int _windowSize; // window from the model, the congestion window adds the packets delivered after a loss
+    int _priorWindowSize { 0 }; // window to restore after probe RTT
+};
+
+}
+
+#endif // hifi_BBRCC_h
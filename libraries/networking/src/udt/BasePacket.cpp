@@ -12,6 +12,7 @@
 #include "BasePacket.h"
 
 #include "../NetworkLogging.h"
+#include "PacketBufferPool.h"
 
 using namespace udt;
 
@@ -77,9 +78,16 @@ BasePacket::BasePacket(std::unique_ptr<char[]> data, qint64 size, const HifiSock
     
 }
 
+BasePacket::~BasePacket() {
+    if (_hasPooledBuffer) {
+        PacketBufferPool::release(std::move(_packet));
+    }
+}
+
 BasePacket& BasePacket::operator=(const BasePacket& other) {
     _packetSize = other._packetSize;
     _packet = std::unique_ptr<char[]>(new char[_packetSize]);
+    _hasPooledBuffer = false;
     memcpy(_packet.get(), other._packet.get(), _packetSize);
     
     _payloadStart = _packet.get() + (other._payloadStart - other._packet.get());
@@ -105,6 +113,8 @@ BasePacket::BasePacket(BasePacket&& other) {
 BasePacket& BasePacket::operator=(BasePacket&& other) {
     _packetSize = other._packetSize;
     _packet = std::move(other._packet);
+    _hasPooledBuffer = other._hasPooledBuffer;
+    other._hasPooledBuffer = false;
     
     _payloadStart = other._payloadStart;
     _payloadCapacity = other._payloadCapacity;
@@ -49,6 +49,11 @@ public:
 
     virtual int estimatedTimeout() const = 0;
 
+    // current estimates of the round trip time (in microseconds) and of the bandwidth (in packets per second),
+    // zero if the congestion control does not estimate them
+    virtual int estimatedRTT() const { return 0; }
+    virtual int estimatedBandwidth() const { return 0; }
+
 protected:
     void setMSS(int mss) { _mss = mss; }
     virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) = 0;
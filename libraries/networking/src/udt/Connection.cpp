@@ -68,8 +68,8 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
+        // grab the send queue thread so we can wait on it, a queue paced by the shared sender doesn't have one
+        QThread* sendQueueThread = sendQueue->isPacedBySharedSender() ? nullptr : sendQueue->thread();
         
         // tell the send queue to stop and be deleted
         
@@ -80,8 +80,10 @@ void Connection::stopSendQueue() {
         sendQueue->deleteLater();
         
         // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
+        if (sendQueueThread) {
+            sendQueueThread->quit();
+            sendQueueThread->wait();
+        }
     }
 }
 
@@ -318,6 +320,10 @@ void Connection::processControl(ControlPacketPointer controlPacket) {
                 stopSendQueue();
             }
             break;
+        case ControlPacket::FECRequest:
+        case ControlPacket::FECParity:
+            // forward error correction is handled by the Socket, outside of the connection
+            break;
     }
 }
 
@@ -444,6 +450,8 @@ void Connection::updateCongestionControlAndSendQueue(std::function<void ()> cong
     // record connection stats
     _stats.recordPacketSendPeriod(_congestionControl->_packetSendPeriod);
     _stats.recordCongestionWindowSize(_congestionControl->_congestionWindowSize);
+    _stats.recordRTT(_congestionControl->estimatedRTT());
+    _stats.recordEstimatedBandwidth(_congestionControl->estimatedBandwidth());
 }
 
 void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
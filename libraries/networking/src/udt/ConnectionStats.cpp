@@ -90,6 +90,14 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
 }
 
+void ConnectionStats::recordRTT(int sample) {
+    _currentSample.rtt = sample;
+}
+
+void ConnectionStats::recordEstimatedBandwidth(int sample) {
+    _currentSample.estimatedBandwith = sample;
+}
+
 QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "Connection stats:\n";
 #define HIFI_LOG_EVENT(x) << "    " #x " events: " << stats.events[ConnectionStats::Stats::Event::x] << "\n"
@@ -64,8 +64,8 @@ public:
         // the following stats are trailing averages in the result, not totals
         int sendRate { 0 };
         int receiveRate { 0 };
-        int estimatedBandwith { 0 };
-        int rtt { 0 };
+        int estimatedBandwith { 0 }; // packets per second
+        int rtt { 0 }; // microseconds
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
         
@@ -93,6 +93,8 @@ public:
 
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+    void recordRTT(int sample);
+    void recordEstimatedBandwidth(int sample);
     
 private:
     Stats _currentSample;
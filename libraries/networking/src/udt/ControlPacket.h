@@ -30,7 +30,9 @@ public:
         ACK,
         Handshake,
         HandshakeACK,
-        HandshakeRequest
+        HandshakeRequest,
+        FECRequest, // asks the peer to protect its unreliable packets with parity packets
+        FECParity
     };
     
     static std::unique_ptr<ControlPacket> create(Type type, qint64 size = -1);
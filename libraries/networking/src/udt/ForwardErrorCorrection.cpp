@@ -0,0 +1,173 @@
+//
+//  ForwardErrorCorrection.cpp
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ForwardErrorCorrection.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const int MAX_PROTECTED_PAYLOAD_SIZE = ControlPacket::maxPayloadSize() - FEC_HEADER_SIZE;
+static const seconds PARITY_REQUEST_INTERVAL { 1 };
+static const int MAX_UNANSWERED_PARITY_REQUESTS = 3; // the peer has forward error correction turned off, stop asking
+
+static void xorInto(char* destination, const char* source, int size) {
+    for (int i = 0; i < size; ++i) {
+        destination[i] ^= source[i];
+    }
+}
+
+bool FECEncoder::canProtect(const Packet& packet) {
+    return !packet.isReliable() && !packet.isPartOfMessage() &&
+        packet.getDataSize() - Packet::localHeaderSize() <= MAX_PROTECTED_PAYLOAD_SIZE;
+}
+
+std::unique_ptr<ControlPacket> FECEncoder::addPacket(const Packet& packet) {
+    Q_ASSERT(canProtect(packet));
+
+    std::unique_ptr<ControlPacket> parityPacket;
+
+    auto sequenceNumber = packet.getSequenceNumber();
+    if (_numPackets > 0) {
+        int offset = seqoff(_firstSequenceNumber, sequenceNumber);
+        if (offset < 0 || offset >= FEC_MAX_GROUP_SPAN) {
+            // too many unprotected packets went out since the group started, close it early
+            parityPacket = createParityPacket();
+        }
+    }
+
+    if (_numPackets == 0) {
+        _firstSequenceNumber = sequenceNumber;
+    }
+
+    const char* payload = packet.getData() + Packet::localHeaderSize();
+    int payloadSize = (int)packet.getDataSize() - Packet::localHeaderSize();
+
+    xorInto(_parityPayload.data(), payload, payloadSize);
+    _parityPayloadSize = std::max(_parityPayloadSize, payloadSize);
+    _payloadSizeParity ^= (FECPayloadSize)payloadSize;
+    _groupMask |= FECGroupMask(1) << seqoff(_firstSequenceNumber, sequenceNumber);
+    ++_numPackets;
+
+    if (_numPackets == _groupSize) {
+        Q_ASSERT(!parityPacket);
+        parityPacket = createParityPacket();
+    }
+
+    return parityPacket;
+}
+
+std::unique_ptr<ControlPacket> FECEncoder::createParityPacket() {
+    auto parityPacket = ControlPacket::create(ControlPacket::FECParity, FEC_HEADER_SIZE + _parityPayloadSize);
+    parityPacket->writePrimitive(_firstSequenceNumber);
+    parityPacket->writePrimitive(_groupMask);
+    parityPacket->writePrimitive(_payloadSizeParity);
+    parityPacket->write(_parityPayload.data(), _parityPayloadSize);
+
+    // start the next group
+    std::memset(_parityPayload.data(), 0, _parityPayloadSize);
+    _parityPayloadSize = 0;
+    _payloadSizeParity = 0;
+    _groupMask = 0;
+    _numPackets = 0;
+
+    return parityPacket;
+}
+
+bool FECDecoder::addPacket(const Packet& packet) {
+    auto sequenceNumber = packet.getSequenceNumber();
+    auto& entry = entryFor(sequenceNumber);
+
+    if (entry.isValid && entry.sequenceNumber == sequenceNumber) {
+        return false;
+    }
+
+    const char* payload = packet.getData() + Packet::localHeaderSize();
+    entry.isValid = true;
+    entry.sequenceNumber = sequenceNumber;
+    entry.payload.assign(payload, packet.getData() + packet.getDataSize());
+
+    return true;
+}
+
+std::unique_ptr<Packet> FECDecoder::recoverPacket(ControlPacket& parityPacket) {
+    _lastParityTime = parityPacket.getReceiveTime();
+    _numUnansweredRequests = 0;
+
+    SequenceNumber firstSequenceNumber;
+    FECGroupMask groupMask;
+    FECPayloadSize payloadSize;
+
+    if (parityPacket.getPayloadSize() < FEC_HEADER_SIZE || parityPacket.getPayloadSize() > ControlPacket::maxPayloadSize()) {
+        return nullptr;
+    }
+    parityPacket.readPrimitive(&firstSequenceNumber);
+    parityPacket.readPrimitive(&groupMask);
+    parityPacket.readPrimitive(&payloadSize);
+
+    int parityPayloadSize = (int)parityPacket.bytesLeftToRead();
+    std::array<char, MAX_PACKET_SIZE> payload;
+    parityPacket.read(payload.data(), parityPayloadSize);
+
+    SequenceNumber lostSequenceNumber;
+    int numLost = 0;
+
+    for (int i = 0; i < FEC_MAX_GROUP_SPAN; ++i) {
+        if (!(groupMask & (FECGroupMask(1) << i))) {
+            continue;
+        }
+
+        auto sequenceNumber = firstSequenceNumber + i;
+        auto& entry = entryFor(sequenceNumber);
+
+        if (entry.isValid && entry.sequenceNumber == sequenceNumber) {
+            int entrySize = std::min((int)entry.payload.size(), parityPayloadSize);
+            xorInto(payload.data(), entry.payload.data(), entrySize);
+            payloadSize ^= (FECPayloadSize)entry.payload.size();
+        } else if (entry.isValid && sequenceNumber < entry.sequenceNumber) {
+            // the group is older than the history, it is too late to recover anything from it
+            return nullptr;
+        } else {
+            lostSequenceNumber = sequenceNumber;
+            ++numLost;
+        }
+    }
+
+    if (numLost != 1 || payloadSize > parityPayloadSize) {
+        return nullptr;
+    }
+
+    // rebuild the datagram as it would have come in, the header of a protected packet is only its sequence number
+    auto size = Packet::localHeaderSize() + payloadSize;
+    auto data = std::unique_ptr<char[]>(new char[size]);
+    *reinterpret_cast<Packet::SequenceNumberAndBitField*>(data.get()) = (SequenceNumber::Type)lostSequenceNumber;
+    std::memcpy(data.get() + Packet::localHeaderSize(), payload.data(), payloadSize);
+
+    auto packet = Packet::fromReceivedPacket(std::move(data), size, parityPacket.getSenderSockAddr());
+    packet->setReceiveTime(parityPacket.getReceiveTime());
+    return packet;
+}
+
+bool FECDecoder::shouldRequestParity(p_high_resolution_clock::time_point now) {
+    if (now - std::max(_lastParityTime, _lastRequestTime) < PARITY_REQUEST_INTERVAL) {
+        return false;
+    }
+
+    if (_numUnansweredRequests >= MAX_UNANSWERED_PARITY_REQUESTS) {
+        return false;
+    }
+
+    _lastRequestTime = now;
+    ++_numUnansweredRequests;
+    return true;
+}
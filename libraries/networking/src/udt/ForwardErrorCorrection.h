@@ -0,0 +1,108 @@
+//
+//  ForwardErrorCorrection.h
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ForwardErrorCorrection_h
+#define hifi_ForwardErrorCorrection_h
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Constants.h"
+#include "ControlPacket.h"
+#include "Packet.h"
+#include "SequenceNumber.h"
+
+namespace udt {
+
+// XOR forward error correction for unreliable packets.
+// The sender follows every group of protected packets with a parity packet, the XOR of their payloads.
+// The receiver can rebuild one packet lost from each group right away, instead of waiting for a re-send that
+// unreliable packets never get.
+//
+//                        Parity Packet Payload
+//
+//     0                   1                   2                   3
+//     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |                  First Sequence Number                        |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |                  Group Mask                                   |  bit i set if first + i is in the group
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |       Payload Size XOR        |     Payload XOR ...           |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+using FECGroupMask = uint32_t;
+using FECPayloadSize = uint16_t;
+
+static const int FEC_MAX_GROUP_SPAN = 8 * sizeof(FECGroupMask); // a group can only cover that many sequence numbers
+static const int FEC_HEADER_SIZE = sizeof(SequenceNumber) + sizeof(FECGroupMask) + sizeof(FECPayloadSize);
+
+// Adds the packets sent to one peer to parity groups.
+class FECEncoder {
+public:
+    FECEncoder(int groupSize) : _groupSize(groupSize) {}
+
+    // unreliable packets that are not part of a message and leave room for the parity header
+    static bool canProtect(const Packet& packet);
+
+    // returns the parity packet to send after this one, once its group is complete
+    std::unique_ptr<ControlPacket> addPacket(const Packet& packet);
+
+private:
+    std::unique_ptr<ControlPacket> createParityPacket();
+
+    int _groupSize;
+    int _numPackets { 0 };
+    SequenceNumber _firstSequenceNumber;
+    FECGroupMask _groupMask { 0 };
+    FECPayloadSize _payloadSizeParity { 0 };
+    int _parityPayloadSize { 0 }; // size of the largest payload in the group
+    std::array<char, MAX_PACKET_SIZE> _parityPayload {{ 0 }}; // XOR of the payloads in the group, zero padded
+};
+
+// Keeps the protected packets recently received from one peer, to rebuild a lost one from a parity packet.
+class FECDecoder {
+public:
+    // false if this packet was received or recovered already
+    bool addPacket(const Packet& packet);
+
+    // the packet that was lost from the group of this parity packet, if it was the only one
+    std::unique_ptr<Packet> recoverPacket(ControlPacket& parityPacket);
+
+    // whether the peer should be asked for parity packets again - none came in for a while,
+    // gives up after a few requests that got no answer
+    bool shouldRequestParity(p_high_resolution_clock::time_point now);
+
+private:
+    // a ring of recent sequence numbers, two groups worth so that a parity packet can come in late
+    static const int HISTORY_SIZE = 2 * FEC_MAX_GROUP_SPAN;
+
+    struct Entry {
+        bool isValid { false };
+        SequenceNumber sequenceNumber;
+        std::vector<char> payload;
+    };
+
+    Entry& entryFor(SequenceNumber sequenceNumber) { return _history[(SequenceNumber::Type)sequenceNumber % HISTORY_SIZE]; }
+
+    std::array<Entry, HISTORY_SIZE> _history;
+
+    p_high_resolution_clock::time_point _lastParityTime;
+    p_high_resolution_clock::time_point _lastRequestTime;
+    int _numUnansweredRequests { 0 };
+};
+
+}
+
+#endif // hifi_ForwardErrorCorrection_h
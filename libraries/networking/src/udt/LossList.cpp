@@ -16,6 +16,12 @@
 using namespace udt;
 using namespace std;
 
+std::deque<LossList::Range>::iterator LossList::findRange(SequenceNumber seq) {
+    return lower_bound(_lossList.begin(), _lossList.end(), seq, [](const Range& range, const SequenceNumber& seq) {
+        return range.second < seq;
+    });
+}
+
 void LossList::append(SequenceNumber seq) {
     Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
@@ -47,9 +53,7 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    auto it = findRange(start);
     
     if (it == _lossList.end() || end < it->first) {
         // No overlap, simply insert
@@ -71,26 +75,28 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
         auto it2 = it;
         ++it2;
         // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
+        auto last = it2;
+        while (last != _lossList.end() && it->second >= last->first - 1) {
             // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
+            if (it->second < last->second) {
+                _length += seqlen(it->second + 1, last->second);
+                it->second = last->second;
             }
             
-            // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            // Overlapping range will be removed
+            _length -= seqlen(last->first, last->second);
+            ++last;
         }
+
+        // Remove the overlapping ranges at once
+        _lossList.erase(it2, last);
     }
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    auto it = findRange(seq);
     
-    if (it != end(_lossList)) {
+    if (it != end(_lossList) && it->first <= seq) {
         if (it->first == it->second) {
             _lossList.erase(it);
         } else if (seq == it->first) {
@@ -116,12 +122,10 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    auto it = findRange(start);
     
     // If we found one
-    if (it != _lossList.end()) {
+    if (it != _lossList.end() && it->first <= end) {
         
         // While the end of the current segment is contained, either shorten it (first one only - sometimes)
         // or remove it altogether since it is fully contained it the range
@@ -163,7 +167,14 @@ SequenceNumber LossList::getFirstSequenceNumber() const {
 
 SequenceNumber LossList::popFirstSequenceNumber() {
     auto front = getFirstSequenceNumber();
-    remove(front);
+
+    if (_lossList.front().first == _lossList.front().second) {
+        _lossList.pop_front();
+    } else {
+        ++_lossList.front().first;
+    }
+    _length -= 1;
+
     return front;
 }
 
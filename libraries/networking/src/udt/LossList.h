@@ -12,7 +12,7 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <deque>
 
 #include "SequenceNumber.h"
 
@@ -30,7 +30,7 @@ public:
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere - slower, the ranges after it have to move
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,7 +44,13 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+
+    // first range that ends at or after this sequence number, found with a binary search
+    std::deque<Range>::iterator findRange(SequenceNumber seq);
+
+    std::deque<Range> _lossList; // sorted, non-overlapping ranges
+
     int _length { 0 };
 };
     
@@ -0,0 +1,139 @@
+//
+//  PacedSender.cpp
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacedSender.h"
+
+#include <algorithm>
+
+#include "SendQueue.h"
+
+using namespace udt;
+
+PacedSender::PacedSender(int numThreads) :
+    _numThreads(std::max(numThreads, 1))
+{
+    for (int i = 0; i < _numThreads; ++i) {
+        _threads.emplace_back(&PacedSender::run, this);
+    }
+}
+
+PacedSender::~PacedSender() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopped = true;
+    }
+    _scheduleChanged.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void PacedSender::add(SendQueue* queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queues[queue];
+    schedule(queue, p_high_resolution_clock::now());
+}
+
+void PacedSender::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _stepFinished.wait(lock, [&] {
+        auto it = _queues.find(queue);
+        return it == _queues.end() || !it->second.isStepping;
+    });
+
+    // its entry left in the schedule is dropped when it comes up
+    _queues.erase(queue);
+}
+
+void PacedSender::wake(SendQueue* queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _queues.find(queue);
+    if (it == _queues.end()) {
+        return;
+    }
+
+    if (it->second.isStepping) {
+        // it will be scheduled again right after its step
+        it->second.wasWoken = true;
+        return;
+    }
+
+    auto now = p_high_resolution_clock::now();
+    if (it->second.scheduledTime > now) {
+        schedule(queue, now);
+    }
+}
+
+void PacedSender::schedule(SendQueue* queue, TimePoint time) {
+    auto& state = _queues[queue];
+    state.scheduledTime = time;
+    if (time == TimePoint::max()) {
+        // only a wake up will bring it back
+        ++state.generation;
+        return;
+    }
+
+    bool isNextInSchedule = _schedule.empty() || time < _schedule.top().time;
+    _schedule.push({ time, queue, ++state.generation });
+
+    if (isNextInSchedule) {
+        _scheduleChanged.notify_one();
+    }
+}
+
+void PacedSender::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_isStopped) {
+        if (_schedule.empty()) {
+            _scheduleChanged.wait(lock);
+            continue;
+        }
+
+        auto next = _schedule.top();
+        auto it = _queues.find(next.queue);
+        if (it == _queues.end() || it->second.generation != next.generation) {
+            // the queue was removed or re-scheduled since
+            _schedule.pop();
+            continue;
+        }
+
+        if (next.time > p_high_resolution_clock::now()) {
+            _scheduleChanged.wait_until(lock, next.time);
+            continue;
+        }
+
+        _schedule.pop();
+        it->second.isStepping = true;
+        it->second.wasWoken = false;
+        it->second.scheduledTime = TimePoint::max();
+
+        lock.unlock();
+        auto nextTime = next.queue->step();
+        lock.lock();
+
+        it = _queues.find(next.queue);
+        if (it != _queues.end()) {
+            it->second.isStepping = false;
+            if (it->second.wasWoken && nextTime != TimePoint::max()) {
+                nextTime = std::min(nextTime, p_high_resolution_clock::now());
+            }
+            schedule(next.queue, nextTime);
+        }
+        _stepFinished.notify_all();
+
+        if (_numThreads > 1) {
+            // another thread may be waiting on a later queue than the one now at the top of the schedule
+            _scheduleChanged.notify_one();
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//
+//  PacedSender.h
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacedSender_h
+#define hifi_PacedSender_h
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+// Services the SendQueues of every reliable connection of a socket from a few threads, rather than a thread
+// per queue. The queues are kept in a schedule ordered by the next time each of them wants to send,
+// which follows their own packet send period and flow window.
+class PacedSender {
+public:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    PacedSender(int numThreads);
+    ~PacedSender();
+
+    // Start servicing a queue right away
+    void add(SendQueue* queue);
+
+    // Stop servicing a queue, waits for it to be done with any step in progress
+    // Must not be called from a step of the queue
+    void remove(SendQueue* queue);
+
+    // Service a queue now rather than at its scheduled time, when it has something new to send
+    void wake(SendQueue* queue);
+
+private:
+    void run();
+    void schedule(SendQueue* queue, TimePoint time);
+
+    struct ScheduledQueue {
+        TimePoint time;
+        SendQueue* queue;
+        uint64_t generation;
+
+        bool operator>(const ScheduledQueue& other) const { return time > other.time; }
+    };
+
+    struct QueueState {
+        uint64_t generation { 0 }; // only the schedule entry of the current generation is live
+        TimePoint scheduledTime { TimePoint::max() };
+        bool isStepping { false };
+        bool wasWoken { false };
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _scheduleChanged;
+    std::condition_variable _stepFinished;
+    bool _isStopped { false };
+
+    std::priority_queue<ScheduledQueue, std::vector<ScheduledQueue>, std::greater<ScheduledQueue>> _schedule;
+    std::unordered_map<SendQueue*, QueueState> _queues;
+
+    const int _numThreads;
+    std::vector<std::thread> _threads;
+};
+
+}
+
+#endif // hifi_PacedSender_h
@@ -0,0 +1,48 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+using namespace udt;
+
+// past this many idle buffers we let them go back to the allocator
+static const size_t MAX_FREE_BUFFERS = 8192;
+
+PacketBufferPool& PacketBufferPool::instance() {
+    static PacketBufferPool pool;
+    return pool;
+}
+
+std::unique_ptr<char[]> PacketBufferPool::acquire() {
+    auto& pool = instance();
+    {
+        Lock lock(pool._mutex);
+        if (!pool._freeBuffers.empty()) {
+            auto buffer = std::move(pool._freeBuffers.back());
+            pool._freeBuffers.pop_back();
+            return buffer;
+        }
+    }
+
+    return std::unique_ptr<char[]>(new char[BUFFER_SIZE]);
+}
+
+void PacketBufferPool::release(std::unique_ptr<char[]> buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    auto& pool = instance();
+    Lock lock(pool._mutex);
+    if (pool._freeBuffers.size() < MAX_FREE_BUFFERS) {
+        pool._freeBuffers.push_back(std::move(buffer));
+    }
+}
@@ -0,0 +1,45 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace udt {
+
+// Recycles the fixed size receive buffers that udt::Socket reads datagrams into.
+// A received BasePacket adopts its buffer without a copy and hands it back here when it is destroyed.
+class PacketBufferPool {
+    using Mutex = std::mutex;
+    using Lock = std::lock_guard<Mutex>;
+
+public:
+    // large enough for any datagram that fits in an ethernet MTU
+    static const int BUFFER_SIZE = 1500;
+
+    static std::unique_ptr<char[]> acquire();
+    static void release(std::unique_ptr<char[]> buffer);
+
+private:
+    static PacketBufferPool& instance();
+
+    Mutex _mutex;
+    std::vector<std::unique_ptr<char[]>> _freeBuffers;
+};
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
@@ -188,6 +188,16 @@ public:
         return NON_SOURCED_PACKETS;
     }
 
+    const static QSet<PacketTypeEnum::Value> getForwardErrorCorrectedPackets() {
+        const static QSet<PacketTypeEnum::Value> FORWARD_ERROR_CORRECTED_PACKETS = QSet<PacketTypeEnum::Value>()
+            << PacketTypeEnum::Value::MixedAudio
+            << PacketTypeEnum::Value::MicrophoneAudioNoEcho
+            << PacketTypeEnum::Value::MicrophoneAudioWithEcho
+            << PacketTypeEnum::Value::SilentAudioFrame
+            << PacketTypeEnum::Value::BulkAvatarData;
+        return FORWARD_ERROR_CORRECTED_PACKETS;
+    }
+
     const static QSet<PacketTypeEnum::Value> getDomainSourcedPackets() {
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
@@ -25,6 +25,7 @@
 
 #include "../NetworkLogging.h"
 #include "ControlPacket.h"
+#include "PacedSender.h"
 #include "Packet.h"
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
@@ -64,6 +65,9 @@ private:
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
 
+static const auto HANDSHAKE_RESEND_INTERVAL = milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = seconds(5);
+
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
@@ -71,6 +75,13 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
+    if (auto pacedSender = socket->getPacedSender()) {
+        // the queue is serviced by the socket's paced sender and stays on the thread of its connection
+        queue->_pacedSender = pacedSender;
+        pacedSender->add(queue.get());
+        return queue;
+    }
+
     // Setup queue private thread
     QThread* thread = new QThread;
     thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
@@ -103,6 +114,9 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSe
 }
 
 SendQueue::~SendQueue() {
+    if (_pacedSender) {
+        _pacedSender->remove(this);
+    }
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
@@ -111,7 +125,9 @@ void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
     _emptyCondition.notify_one();
     
-    if (!thread()->isRunning() && _state == State::NotStarted) {
+    if (_pacedSender) {
+        _pacedSender->wake(this);
+    } else if (!thread()->isRunning() && _state == State::NotStarted) {
         thread()->start();
     }
 }
@@ -122,7 +138,9 @@ void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
     _emptyCondition.notify_one();
     
-    if (!thread()->isRunning() && _state == State::NotStarted) {
+    if (_pacedSender) {
+        _pacedSender->wake(this);
+    } else if (!thread()->isRunning() && _state == State::NotStarted) {
         thread()->start();
     }
 }
@@ -130,6 +148,13 @@ void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
 void SendQueue::stop() {
     
     _state = State::Stopped;
+
+    if (_pacedSender) {
+        _pacedSender->remove(this);
+
+        // the deferred delete of a stopped queue can run after the socket is gone, along with its paced sender
+        _pacedSender = nullptr;
+    }
     
     // Notify all conditions in case we're waiting somewhere
     _handshakeACKCondition.notify_one();
@@ -149,9 +174,7 @@ void SendQueue::ack(SequenceNumber ack) {
     {
         // remove any ACKed packets from the map of sent packets
         QWriteLocker locker(&_sentLock);
-        for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
-            _sentPackets.erase(seq);
-        }
+        _sentPackets.removeUpTo(ack);
     }
     
     {   // remove any sequence numbers equal to or lower than this ACK in the loss list
@@ -166,6 +189,10 @@ void SendQueue::ack(SequenceNumber ack) {
 
     // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
     _emptyCondition.notify_one();
+
+    if (_pacedSender) {
+        _pacedSender->wake(this);
+    }
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -176,25 +203,32 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
 
     // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
     _emptyCondition.notify_one();
+
+    if (_pacedSender) {
+        _pacedSender->wake(this);
+    }
 }
 
 void SendQueue::sendHandshake() {
     std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
     if (!_hasReceivedHandshakeACK) {
         // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
+        writeHandshake();
         
         // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
         _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
     }
 }
 
+void SendQueue::writeHandshake() {
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
+}
+
 void SendQueue::handshakeACK() {
     {
         std::lock_guard<std::mutex> locker { _handshakeMutex };
@@ -203,6 +237,10 @@ void SendQueue::handshakeACK() {
 
     // Notify on the handshake ACK condition
     _handshakeACKCondition.notify_one();
+
+    if (_pacedSender) {
+        _pacedSender->wake(this);
+    }
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -225,11 +263,8 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     {
         // Insert the packet we have just sent in the sent list
         QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
-        entry.first = 0; // No resend
-        entry.second.swap(newPacket);
+        _sentPackets.add(sequenceNumber, std::move(newPacket));
     }
-    Q_ASSERT_X(!newPacket, "SendQueue::sendNewPacketAndAddToSentList()", "Overriden packet in sent list");
 
     if (bytesWritten < 0) {
         // this is a short-circuit loss - we failed to put this packet on the wire
@@ -355,6 +390,118 @@ void SendQueue::run() {
     }
 }
 
+p_high_resolution_clock::time_point SendQueue::step() {
+    auto now = p_high_resolution_clock::now();
+
+    auto notStarted = State::NotStarted;
+    _state.compare_exchange_strong(notStarted, State::Running);
+    if (_state != State::Running) {
+        return p_high_resolution_clock::time_point::max();
+    }
+
+    if (!_hasReceivedHandshakeACK) {
+        // keep sending handshakes until we get the ACK, which wakes us up
+        _nextPacketTimestamp = p_high_resolution_clock::time_point();
+        if (now >= _nextHandshakeTimestamp) {
+            std::lock_guard<std::mutex> handshakeLock { _handshakeMutex };
+            if (!_hasReceivedHandshakeACK) {
+                writeHandshake();
+            }
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
+        }
+        return _nextHandshakeTimestamp;
+    }
+
+    bool attemptedToSendPacket = maybeResendPacket();
+
+    // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+    // (this is according to the current flow window size) then we send out a new packet
+    auto newPacketCount = 0;
+    if (!attemptedToSendPacket) {
+        newPacketCount = maybeSendNewPacket();
+        attemptedToSendPacket = (newPacketCount > 0);
+    }
+
+    if (_state != State::Running) {
+        return p_high_resolution_clock::time_point::max();
+    }
+
+    if (!attemptedToSendPacket) {
+        return nextStepWhenIdle(now);
+    }
+    _emptySince = p_high_resolution_clock::time_point();
+    _waitingForACKSince = p_high_resolution_clock::time_point();
+
+    if (_packetSendPeriod > 0) {
+        if (_nextPacketTimestamp == p_high_resolution_clock::time_point()) {
+            _nextPacketTimestamp = now;
+        }
+
+        // push the next packet timestamp forwards by the current packet send period
+        auto nextPacketDelta = microseconds((newPacketCount == 2 ? 2 : 1) * _packetSendPeriod);
+        _nextPacketTimestamp += nextPacketDelta;
+
+        // like the send thread, never wait for more than nextPacketDelta
+        if (_nextPacketTimestamp - now > nextPacketDelta) {
+            _nextPacketTimestamp = now + nextPacketDelta;
+        }
+        return _nextPacketTimestamp;
+    }
+    return now;
+}
+
+// The same checks as isInactive, but rather than waiting on the condition returns when they should be made again
+p_high_resolution_clock::time_point SendQueue::nextStepWhenIdle(p_high_resolution_clock::time_point now) {
+    using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
+    DoubleLock doubleLock(_packets.getLock(), _naksLock);
+    DoubleLock::Lock locker(doubleLock, std::try_to_lock);
+
+    if (!locker.owns_lock() || !((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        // there is something to send after all, try again right away
+        return now;
+    }
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        _waitingForACKSince = p_high_resolution_clock::time_point();
+        if (_emptySince == p_high_resolution_clock::time_point()) {
+            _emptySince = now;
+        }
+
+        if (now - _emptySince >= EMPTY_QUEUES_INACTIVE_TIMEOUT) {
+            locker.unlock();
+            deactivate();
+            return p_high_resolution_clock::time_point::max();
+        }
+        return _emptySince + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+    }
+
+    // We think the client is still waiting for data (based on the sequence number gap)
+    // Let's wait either for a response from the client or until the estimated timeout has elapsed
+    _emptySince = p_high_resolution_clock::time_point();
+    if (_waitingForACKSince == p_high_resolution_clock::time_point()) {
+        _waitingForACKSince = now;
+    }
+
+    auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
+    estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+    if (now - _waitingForACKSince >= estimatedTimeout ||
+        std::chrono::high_resolution_clock::now() - _lastPacketSentAt > estimatedTimeout) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+        _waitingForACKSince = p_high_resolution_clock::time_point();
+
+        locker.unlock();
+
+        emit timeout();
+        return now;
+    }
+    return _waitingForACKSince + estimatedTimeout;
+}
+
 int SendQueue::maybeSendNewPacket() {
     if (!isFlowWindowFull()) {
         // we didn't re-send a packet, so time to send a new one
@@ -395,20 +542,18 @@ bool SendQueue::maybeResendPacket() {
             QReadLocker sentLocker(&_sentLock);
             
             // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
-
-            if (it != _sentPackets.end()) {
+            auto entry = _sentPackets.find(resendNumber);
 
-                auto& entry = it->second;
+            if (entry) {
                 // we found the packet - grab it
-                auto& resendPacket = *(entry.second);
-                ++entry.first; // Add 1 resend
+                auto& resendPacket = *(entry->packet);
+                ++entry->numResends; // Add 1 resend
 
-                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry.first < 2 ? 0 : (entry.first - 2) % 4);
+                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry->numResends < 2 ? 0 : (entry->numResends - 2) % 4);
 
                 auto wireSize = resendPacket.getWireSize();
                 auto payloadSize = resendPacket.getPayloadSize();
-                auto sequenceNumber = it->first;
+                auto sequenceNumber = resendNumber;
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -481,8 +626,6 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
             if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
                 // we've sent the client as much data as we have (and they've ACKed it)
                 // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
                 // use our condition_variable_any to wait
                 auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
                 
@@ -18,7 +18,6 @@
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -31,6 +30,7 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SentPacketWindow.h"
 
 namespace udt {
     
@@ -38,6 +38,7 @@ class BasePacket;
 class ControlPacket;
 class Packet;
 class PacketList;
+class PacedSender;
 class Socket;
     
 class SendQueue : public QObject {
@@ -68,6 +69,9 @@ public:
     void setPacketSendPeriod(int newPeriod) { _packetSendPeriod = newPeriod; }
     
     void setEstimatedTimeout(int estimatedTimeout) { _estimatedTimeout = estimatedTimeout; }
+
+    // Whether the queue is serviced by the shared paced sender of its socket rather than its own thread
+    bool isPacedBySharedSender() const { return _pacedSender != nullptr; }
     
 public slots:
     void stop();
@@ -94,6 +98,12 @@ private:
     SendQueue(SendQueue&& other) = delete;
     
     void sendHandshake();
+    void writeHandshake();
+
+    // Does the work of one iteration of run() without blocking, for the paced sender.
+    // Returns when the queue should be serviced next, time_point::max() once it is stopped.
+    p_high_resolution_clock::time_point step();
+    p_high_resolution_clock::time_point nextStepWhenIdle(p_high_resolution_clock::time_point now);
     
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
@@ -130,8 +140,7 @@ private:
     LossList _naks; // Sequence numbers of packets to resend
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    SentPacketWindow _sentPackets; // Packets waiting for ACK.
     
     std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
@@ -141,8 +150,17 @@ private:
 
     std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
 
+    // Only used when paced by a shared sender, in place of the waits of the send thread - cleared once stopped
+    PacedSender* _pacedSender { nullptr };
+    p_high_resolution_clock::time_point _nextPacketTimestamp;
+    p_high_resolution_clock::time_point _nextHandshakeTimestamp;
+    p_high_resolution_clock::time_point _emptySince;
+    p_high_resolution_clock::time_point _waitingForACKSince;
+
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
+
+    friend class PacedSender;
 };
     
 }
@@ -0,0 +1,98 @@
+//
+//  SentPacketWindow.cpp
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindow.h"
+
+#include <algorithm>
+
+#include <QtCore/QtGlobal>
+
+using namespace udt;
+
+static const int MIN_CAPACITY = 64;
+
+void SentPacketWindow::add(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet) {
+    if (_length == 0) {
+        _firstSequenceNumber = sequenceNumber;
+    }
+
+    int offset = seqoff(_firstSequenceNumber, sequenceNumber);
+    Q_ASSERT_X(offset >= _length, "SentPacketWindow::add", "Sequence number added out of order");
+    if (offset < _length) {
+        return;
+    }
+
+    if (offset >= (int)_entries.size()) {
+        grow(offset + 1);
+    }
+
+    // the skipped entries are already empty, they were reset when removed
+    _length = offset + 1;
+
+    auto& entry = entryAt(offset);
+    entry.numResends = 0;
+    entry.packet = std::move(packet);
+}
+
+SentPacketWindow::Entry* SentPacketWindow::find(SequenceNumber sequenceNumber) {
+    if (_length == 0) {
+        return nullptr;
+    }
+
+    int offset = seqoff(_firstSequenceNumber, sequenceNumber);
+    if (offset < 0 || offset >= _length) {
+        return nullptr;
+    }
+
+    auto& entry = entryAt(offset);
+    return entry.packet ? &entry : nullptr;
+}
+
+void SentPacketWindow::removeUpTo(SequenceNumber sequenceNumber) {
+    if (_length == 0) {
+        return;
+    }
+
+    int numToRemove = std::min(seqoff(_firstSequenceNumber, sequenceNumber) + 1, _length);
+    for (int i = 0; i < numToRemove; ++i) {
+        entryAt(i).packet.reset();
+    }
+
+    if (numToRemove > 0) {
+        _head = (_head + numToRemove) & (_entries.size() - 1);
+        _length -= numToRemove;
+        _firstSequenceNumber += numToRemove;
+    }
+}
+
+void SentPacketWindow::clear() {
+    for (int i = 0; i < _length; ++i) {
+        entryAt(i).packet.reset();
+    }
+    _head = 0;
+    _length = 0;
+}
+
+void SentPacketWindow::grow(int minimumCapacity) {
+    size_t capacity = std::max(_entries.size(), (size_t)MIN_CAPACITY);
+    while (capacity < (size_t)minimumCapacity) {
+        capacity *= 2;
+    }
+
+    // move the entries to the front of the new buffer, in order
+    std::vector<Entry> entries(capacity);
+    for (int i = 0; i < _length; ++i) {
+        entries[i] = std::move(entryAt(i));
+    }
+
+    _entries.swap(entries);
+    _head = 0;
+}
@@ -0,0 +1,62 @@
+//
+//  SentPacketWindow.h
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SentPacketWindow_h
+#define hifi_SentPacketWindow_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Packet.h"
+#include "SequenceNumber.h"
+
+namespace udt {
+
+// Packets sent by a SendQueue that are waiting for an ACK.
+// They are added in sequence number order and ACKed from the front, so they are kept in a ring buffer
+// indexed by their offset from the oldest one - no hashing and no allocation per packet.
+class SentPacketWindow {
+public:
+    struct Entry {
+        uint8_t numResends { 0 };
+        std::unique_ptr<Packet> packet;
+    };
+
+    // sequence numbers must be added in increasing order - any skipped sequence number is left empty
+    void add(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet);
+
+    // nullptr if the packet is not in the window (never sent, or already ACKed)
+    Entry* find(SequenceNumber sequenceNumber);
+
+    // removes the packets up to and including this sequence number
+    void removeUpTo(SequenceNumber sequenceNumber);
+
+    void clear();
+
+    int getLength() const { return _length; }
+    bool isEmpty() const { return _length == 0; }
+
+private:
+    Entry& entryAt(int offset) { return _entries[(_head + offset) & (_entries.size() - 1)]; }
+    void grow(int minimumCapacity);
+
+    std::vector<Entry> _entries; // size is zero or a power of two
+    size_t _head { 0 }; // index of the entry for _firstSequenceNumber
+    int _length { 0 }; // number of entries from _head, including empty ones
+    SequenceNumber _firstSequenceNumber;
+};
+
+}
+
+#endif // hifi_SentPacketWindow_h
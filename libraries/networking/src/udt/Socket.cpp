@@ -11,10 +11,15 @@
 
 #include "Socket.h"
 
-#ifdef Q_OS_ANDROID
+#if defined(Q_OS_ANDROID) || defined(Q_OS_LINUX)
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -27,10 +32,18 @@
 #include "../NLPacket.h"
 #include "../NLPacketList.h"
 #include "PacketList.h"
+#include "PacketBufferPool.h"
 #include <Trace.h>
 
 using namespace udt;
 
+static const char* BATCHED_IO_ENVIRONMENT_VARIABLE = "HIFI_UDT_BATCHED_IO";
+static const size_t DATAGRAM_BATCH_SIZE = 64;
+static const char* PACED_SENDER_ENVIRONMENT_VARIABLE = "HIFI_UDT_PACED_SENDER";
+static const char* CONGESTION_CONTROL_ENVIRONMENT_VARIABLE = "HIFI_UDT_CONGESTION_CONTROL";
+static const char* FEC_ENVIRONMENT_VARIABLE = "HIFI_UDT_FEC";
+static const int MIN_FEC_GROUP_SIZE = 2;
+
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _readyReadBackupTimer(new QTimer(this)),
@@ -47,6 +60,38 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    if (qEnvironmentVariableIsSet(BATCHED_IO_ENVIRONMENT_VARIABLE)) {
+        setBatchedIOEnabled(true);
+    }
+
+    if (qEnvironmentVariableIsSet(PACED_SENDER_ENVIRONMENT_VARIABLE)) {
+        int numThreads = std::max(qEnvironmentVariableIntValue(PACED_SENDER_ENVIRONMENT_VARIABLE), 1);
+        _pacedSender.reset(new PacedSender(numThreads));
+        qCDebug(networking) << "udt::Socket SendQueues are paced by" << numThreads << "shared threads";
+    }
+
+    if (qgetenv(CONGESTION_CONTROL_ENVIRONMENT_VARIABLE).toLower() == "bbr") {
+        setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>()));
+        qCDebug(networking) << "udt::Socket connections use BBR congestion control";
+    }
+
+    if (qEnvironmentVariableIsSet(FEC_ENVIRONMENT_VARIABLE)) {
+        int groupSize = std::max(qEnvironmentVariableIntValue(FEC_ENVIRONMENT_VARIABLE), MIN_FEC_GROUP_SIZE);
+        setFECGroupSize(groupSize);
+        qCDebug(networking) << "udt::Socket protects unreliable packets with a parity packet every" << groupSize;
+    }
+}
+
+void Socket::setBatchedIOEnabled(bool enabled) {
+#if defined(Q_OS_LINUX)
+    _isBatchedIOEnabled = enabled;
+    qCDebug(networking) << "udt::Socket batched I/O is" << (enabled ? "enabled" : "disabled");
+#else
+    if (enabled) {
+        qCWarning(networking) << "udt::Socket batched I/O is only supported on Linux - using one datagram per call";
+    }
+#endif
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
@@ -123,6 +168,19 @@ qint64 Socket::writeBasePacket(const udt::BasePacket& packet, const HifiSockAddr
 qint64 Socket::writePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
     Q_ASSERT_X(!packet.isReliable(), "Socket::writePacket", "Cannot send a reliable packet unreliably");
 
+    prepareUnreliablePacket(packet, sockAddr);
+
+    auto bytesWritten = writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
+
+    auto parityPacket = protectUnreliablePacket(packet, sockAddr);
+    if (parityPacket) {
+        writeBasePacket(*parityPacket, sockAddr);
+    }
+
+    return bytesWritten;
+}
+
+void Socket::prepareUnreliablePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
     SequenceNumber sequenceNumber;
     {
         Lock lock(_unreliableSequenceNumbersMutex);
@@ -137,8 +195,25 @@ qint64 Socket::writePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
 
     // write the correct sequence number to the Packet here
     packet.writeSequenceNumber(sequenceNumber);
+}
 
-    return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
+bool Socket::isFECProtected(const Packet& packet) const {
+    return _fecGroupSize > 0 && _fecPacketFilterOperator && FECEncoder::canProtect(packet) && _fecPacketFilterOperator(packet);
+}
+
+std::unique_ptr<ControlPacket> Socket::protectUnreliablePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
+    if (!isFECProtected(packet)) {
+        return nullptr;
+    }
+
+    Lock lock(_fecEncodersMutex);
+    auto it = _fecEncoders.find(sockAddr);
+    if (it == _fecEncoders.end()) {
+        // the peer did not ask for parity packets
+        return nullptr;
+    }
+
+    return it->second.addPacket(packet);
 }
 
 qint64 Socket::writePacket(std::unique_ptr<Packet> packet, const HifiSockAddr& sockAddr) {
@@ -185,6 +260,27 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Hif
     }
 
     // Unerliable and Unordered
+    if (_isBatchedIOEnabled) {
+        // hand all of the packets to the socket at once
+        std::vector<std::pair<const char*, qint64>> datagrams;
+        datagrams.reserve(packetList->_packets.size());
+        std::vector<std::unique_ptr<ControlPacket>> parityPackets;
+
+        for (const auto& packet : packetList->_packets) {
+            Q_ASSERT_X(!packet->isReliable(), "Socket::writePacketList", "Cannot send a reliable packet unreliably");
+            prepareUnreliablePacket(*packet, sockAddr);
+            datagrams.emplace_back(packet->getData(), packet->getDataSize());
+
+            auto parityPacket = protectUnreliablePacket(*packet, sockAddr);
+            if (parityPacket) {
+                datagrams.emplace_back(parityPacket->getData(), parityPacket->getDataSize());
+                parityPackets.push_back(std::move(parityPacket));
+            }
+        }
+
+        return writeDatagrams(datagrams, sockAddr);
+    }
+
     qint64 totalBytesSent = 0;
     while (!packetList->_packets.empty()) {
         totalBytesSent += writePacket(packetList->takeFront<Packet>(), sockAddr);
@@ -234,6 +330,62 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+qint64 Socket::writeDatagrams(const std::vector<std::pair<const char*, qint64>>& datagrams,
+                              const HifiSockAddr& sockAddr) {
+#if defined(Q_OS_LINUX)
+    if (_isBatchedIOEnabled && sockAddr.getAddress().protocol() == QAbstractSocket::IPv4Protocol) {
+        sockaddr_in destination;
+        memset(&destination, 0, sizeof(destination));
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(sockAddr.getPort());
+        destination.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+
+        std::array<mmsghdr, DATAGRAM_BATCH_SIZE> headers;
+        std::array<iovec, DATAGRAM_BATCH_SIZE> iovecs;
+
+        auto sd = _udpSocket.socketDescriptor();
+        qint64 bytesWritten = 0;
+        size_t numWritten = 0;
+
+        while (numWritten < datagrams.size()) {
+            auto batchSize = std::min(datagrams.size() - numWritten, DATAGRAM_BATCH_SIZE);
+
+            for (size_t i = 0; i < batchSize; ++i) {
+                const auto& datagram = datagrams[numWritten + i];
+                iovecs[i].iov_base = const_cast<char*>(datagram.first);
+                iovecs[i].iov_len = datagram.second;
+
+                memset(&headers[i], 0, sizeof(mmsghdr));
+                headers[i].msg_hdr.msg_name = &destination;
+                headers[i].msg_hdr.msg_namelen = sizeof(destination);
+                headers[i].msg_hdr.msg_iov = &iovecs[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int numSent = sendmmsg(sd, headers.data(), (unsigned int)batchSize, 0);
+            if (numSent <= 0) {
+                // same as writeDatagram, this isn't uncommon when saturating a link - drop the rest of the batch
+                HIFI_FCDEBUG(networking(), "Socket::writeDatagrams failed -" << strerror(errno));
+                break;
+            }
+
+            for (int i = 0; i < numSent; ++i) {
+                bytesWritten += headers[i].msg_len;
+            }
+            numWritten += numSent;
+        }
+
+        return bytesWritten;
+    }
+#endif
+
+    qint64 totalBytesSent = 0;
+    for (const auto& datagram : datagrams) {
+        totalBytesSent += writeDatagram(datagram.first, datagram.second, sockAddr);
+    }
+    return totalBytesSent;
+}
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreate) {
     auto it = _connectionsHash.find(sockAddr);
 
@@ -281,11 +433,23 @@ void Socket::clearConnections() {
         qCDebug(networking) << "Clearing all remaining connections in Socket.";
         _connectionsHash.clear();
     }
+
+    {
+        Lock lock(_fecEncodersMutex);
+        _fecEncoders.clear();
+    }
+    _fecDecoders.clear();
 }
 
 void Socket::cleanupConnection(HifiSockAddr sockAddr) {
     auto numErased = _connectionsHash.erase(sockAddr);
 
+    {
+        Lock lock(_fecEncodersMutex);
+        _fecEncoders.erase(sockAddr);
+    }
+    _fecDecoders.erase(sockAddr);
+
     if (numErased > 0) {
 #ifdef UDT_CONNECTION_DEBUG
         qCDebug(networking) << "Socket::cleanupConnection called for UDT connection to" << sockAddr;
@@ -324,6 +488,11 @@ void Socket::checkForReadyReadBackup() {
 }
 
 void Socket::readPendingDatagrams() {
+    if (_isBatchedIOEnabled) {
+        readPendingDatagramsBatched();
+        return;
+    }
+
     using namespace std::chrono;
     static const auto MAX_PROCESS_TIME { 100ms };
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
@@ -363,73 +532,223 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime, false);
+    }
+}
+
+void Socket::readPendingDatagramsBatched() {
+#if defined(Q_OS_LINUX)
+    using namespace std::chrono;
+    static const auto MAX_PROCESS_TIME { 100ms };
+    const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
+
+    {
+        // QUdpSocket only re-enables its read notifier once a datagram has been read through it,
+        // so the first datagram of each readyRead always goes through QUdpSocket
+        auto pendingSize = _udpSocket.pendingDatagramSize();
+        bool usePooledBuffer = pendingSize <= PacketBufferPool::BUFFER_SIZE;
+        auto bufferSize = usePooledBuffer ? PacketBufferPool::BUFFER_SIZE : pendingSize;
+        auto buffer = usePooledBuffer ? PacketBufferPool::acquire() : std::unique_ptr<char[]>(new char[bufferSize]);
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+        auto receiveTime = p_high_resolution_clock::now();
+        HifiSockAddr senderSockAddr;
+        auto sizeRead = _udpSocket.readDatagram(buffer.get(), bufferSize,
+                                                senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
+
+        if (sizeRead > 0) {
+            _readyReadBackupTimer->start();
+
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
+            processDatagram(std::move(buffer), sizeRead, senderSockAddr, receiveTime, usePooledBuffer);
+        } else if (usePooledBuffer) {
+            PacketBufferPool::release(std::move(buffer));
+        }
+    }
+
+    // buffers that were not consumed by a packet stay here for the next batch
+    _batchReceiveBuffers.resize(DATAGRAM_BATCH_SIZE);
+
+    std::array<mmsghdr, DATAGRAM_BATCH_SIZE> headers;
+    std::array<iovec, DATAGRAM_BATCH_SIZE> iovecs;
+    std::array<sockaddr_storage, DATAGRAM_BATCH_SIZE> senderAddresses;
+
+    auto sd = _udpSocket.socketDescriptor();
+
+    while (system_clock::now() < abortTime) {
+        for (size_t i = 0; i < DATAGRAM_BATCH_SIZE; ++i) {
+            auto& buffer = _batchReceiveBuffers[i];
+            if (!buffer) {
+                buffer = PacketBufferPool::acquire();
             }
 
-            continue;
+            iovecs[i].iov_base = buffer.get();
+            iovecs[i].iov_len = PacketBufferPool::BUFFER_SIZE;
+
+            memset(&headers[i], 0, sizeof(mmsghdr));
+            headers[i].msg_hdr.msg_name = &senderAddresses[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        int numReceived = recvmmsg(sd, headers.data(), DATAGRAM_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (numReceived <= 0) {
+            // the socket is drained (EAGAIN) or errored, either way we're done for this readyRead
+            break;
+        }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        // we're reading packets so re-start the readyRead backup timer
+        _readyReadBackupTimer->start();
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+        auto receiveTime = p_high_resolution_clock::now();
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+        for (int i = 0; i < numReceived; ++i) {
+            qint64 sizeRead = headers[i].msg_len;
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
+
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
+            if (sizeRead <= 0 || (headers[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+                // empty or larger than any packet we send, drop it and keep the buffer
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            processDatagram(std::move(_batchReceiveBuffers[i]), sizeRead, senderSockAddr, receiveTime, true);
+        }
+
+        if (numReceived < (int)DATAGRAM_BATCH_SIZE) {
+            // nothing else was queued when we read this batch
+            break;
+        }
+    }
+#endif
+}
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+void Socket::processDatagram(std::unique_ptr<char[]> buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime, bool isPooledBuffer) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+            basePacket->setHasPooledBuffer(isPooledBuffer);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        controlPacket->setHasPooledBuffer(isPooledBuffer);
+        controlPacket->setReceiveTime(receiveTime);
+
+        if (controlPacket->getType() == ControlPacket::FECRequest || controlPacket->getType() == ControlPacket::FECParity) {
+            processFECControl(std::move(controlPacket));
+            return;
+        }
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        packet->setHasPooledBuffer(isPooledBuffer);
+        packet->setReceiveTime(receiveTime);
+
+        processPacket(std::move(packet));
+    }
+}
+
+void Socket::processPacket(std::unique_ptr<Packet> packet) {
+    auto senderSockAddr = packet->getSenderSockAddr();
+
+    // save the sequence number in case this is the packet that sticks readyRead
+    _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+    // call our verification operator to see if this packet is verified
+    if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+        if (isFECProtected(*packet)) {
+            auto& decoder = _fecDecoders[senderSockAddr];
+            if (!decoder.addPacket(*packet)) {
+                // this packet was recovered from a parity packet before it came in
+                return;
+            }
+
+            if (decoder.shouldRequestParity(packet->getReceiveTime())) {
+                auto requestPacket = ControlPacket::create(ControlPacket::FECRequest, 0);
+                writeBasePacket(*requestPacket, senderSockAddr);
+            }
+        }
+
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (packet->isReliable()) {
+            // if this was a reliable packet then signal the matching connection with the sequence number
+
+            if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                          packet->getDataSize(),
+                                                                          packet->getPayloadSize())) {
+                // the connection could not be created or indicated that we should not continue processing this packet
+#ifdef UDT_CONNECTION_DEBUG
+                qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                    << ", type" << NLPacket::typeInHeader(*packet);
+#endif
+                return;
+            }
+        } else if (connection) {
+            connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                        packet->getPayloadSize());
+        }
+
+        if (packet->isPartOfMessage()) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+            if (connection) {
+                connection->queueReceivedMessagePacket(std::move(packet));
+            }
+        } else if (_packetHandler) {
+            // call the verified packet callback to let it handle this packet
+            _packetHandler(std::move(packet));
+        }
+    }
+}
+
+void Socket::processFECControl(std::unique_ptr<ControlPacket> controlPacket) {
+    auto senderSockAddr = controlPacket->getSenderSockAddr();
+
+    // only keep state for the peers we would create a connection for
+    if (_fecGroupSize == 0 || (_connectionCreationFilterOperator && !_connectionCreationFilterOperator(senderSockAddr))) {
+        return;
+    }
+
+    if (controlPacket->getType() == ControlPacket::FECRequest) {
+        Lock lock(_fecEncodersMutex);
+        if (_fecEncoders.find(senderSockAddr) == _fecEncoders.end()) {
+            _fecEncoders.emplace(senderSockAddr, FECEncoder(_fecGroupSize));
+        }
+    } else {
+        auto it = _fecDecoders.find(senderSockAddr);
+        if (it != _fecDecoders.end()) {
+            auto packet = it->second.recoverPacket(*controlPacket);
+            if (packet) {
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                qCDebug(networking) << "Recovered packet" << (uint32_t)packet->getSequenceNumber() << "from" << senderSockAddr;
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
-
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
+                processPacket(std::move(packet));
             }
         }
     }
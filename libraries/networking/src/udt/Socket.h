@@ -18,14 +18,18 @@
 #include <unordered_map>
 #include <mutex>
 #include <list>
+#include <vector>
 
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include <QtNetwork/QUdpSocket>
 
 #include "../HifiSockAddr.h"
+#include "BBRCC.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "ForwardErrorCorrection.h"
+#include "PacedSender.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -66,6 +70,23 @@ public:
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+    qint64 writeDatagrams(const std::vector<std::pair<const char*, qint64>>& datagrams, const HifiSockAddr& sockAddr);
+
+    // Batched I/O reads and writes several datagrams per system call (recvmmsg/sendmmsg), only available on Linux.
+    // Defaults to on when the HIFI_UDT_BATCHED_IO environment variable is set.
+    void setBatchedIOEnabled(bool enabled);
+    bool isBatchedIOEnabled() const { return _isBatchedIOEnabled; }
+
+    // With a paced sender, a few threads service the SendQueues of all the reliable connections rather than
+    // a thread each. Enabled when the HIFI_UDT_PACED_SENDER environment variable is set, to its number of threads.
+    PacedSender* getPacedSender() const { return _pacedSender.get(); }
+
+    // Forward error correction follows every group of unreliable packets picked by the filter with a parity packet,
+    // so that the receiving end can rebuild one lost packet per group. Each peer asks for parity packets when it
+    // receives such packets and has it enabled too. Enabled when the HIFI_UDT_FEC environment variable is set,
+    // to the number of packets per group.
+    void setFECGroupSize(int groupSize) { _fecGroupSize = groupSize; }
+    void setFECPacketFilterOperator(PacketFilterOperator filterOperator) { _fecPacketFilterOperator = filterOperator; }
     
     void bind(const QHostAddress& address, quint16 port = 0);
     void rebind(quint16 port);
@@ -81,6 +102,8 @@ public:
     void addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler)
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
+    // Congestion control for the connections created from now on. Defaults to TCPVegasCC, or to BBRCC when the
+    // HIFI_UDT_CONGESTION_CONTROL environment variable is set to "bbr".
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
@@ -109,6 +132,14 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void readPendingDatagramsBatched();
+    void processDatagram(std::unique_ptr<char[]> buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime, bool isPooledBuffer);
+    void processPacket(std::unique_ptr<Packet> packet);
+    void processFECControl(std::unique_ptr<ControlPacket> controlPacket);
+    bool isFECProtected(const Packet& packet) const;
+    std::unique_ptr<ControlPacket> protectUnreliablePacket(const Packet& packet, const HifiSockAddr& sockAddr);
+    void prepareUnreliablePacket(const Packet& packet, const HifiSockAddr& sockAddr);
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
     bool socketMatchesNodeOrDomain(const HifiSockAddr& sockAddr);
    
@@ -129,9 +160,13 @@ private:
     ConnectionCreationFilterOperator _connectionCreationFilterOperator;
 
     Mutex _unreliableSequenceNumbersMutex;
+    Mutex _fecEncodersMutex;
 
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
+    std::unordered_map<HifiSockAddr, FECEncoder> _fecEncoders; // peers that asked for parity packets
+    std::unordered_map<HifiSockAddr, FECDecoder> _fecDecoders;
+    std::unique_ptr<PacedSender> _pacedSender; // must outlive the connections
     std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
 
     QTimer* _readyReadBackupTimer { nullptr };
@@ -141,6 +176,10 @@ private:
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
 
     bool _shouldChangeSocketOptions { true };
+    bool _isBatchedIOEnabled { false };
+    int _fecGroupSize { 0 }; // zero when forward error correction is disabled
+    PacketFilterOperator _fecPacketFilterOperator;
+    std::vector<std::unique_ptr<char[]>> _batchReceiveBuffers;
 
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
@@ -15,6 +15,8 @@
 #include <cstdio>
 #include <cmath>
 #include <fstream> // to load voxels from file
+#include <limits>
+#include <vector>
 
 #include <QDataStream>
 #include <QDebug>
@@ -52,7 +54,7 @@
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -672,8 +674,26 @@ OctreeElementPointer Octree::getElementEnclosingPoint(const glm::vec3& point, Oc
 bool Octree::readFromFile(const char* fileName) {
     QString qFileName = findMostRecentFileExtension(fileName, PERSIST_EXTENSIONS);
 
+    if (qFileName.endsWith(".bin")) {
+        return readBinaryFromFile(qFileName);
+    }
+
+    QVariantMap entityDescription;
+    return parseJSONFromFile(fileName, entityDescription) && readFromMap(entityDescription);
+}
+
+bool Octree::isBinaryFile(const char* fileName) {
+    return findMostRecentFileExtension(fileName, PERSIST_EXTENSIONS).endsWith(".bin");
+}
+
+bool Octree::parseJSONFromFile(const char* fileName, QVariantMap& entityDescription) {
+    QString qFileName = findMostRecentFileExtension(fileName, PERSIST_EXTENSIONS);
+
     if (qFileName.endsWith(".json.gz")) {
-        return readJSONFromGzippedFile(qFileName);
+        return parseJSONFromGzippedFile(qFileName, entityDescription);
+    }
+    if (qFileName.endsWith(".bin")) {
+        return false;
     }
 
     QFile file(qFileName);
@@ -686,7 +706,16 @@ bool Octree::readFromFile(const char* fileName) {
     QFileInfo fileInfo(qFileName);
     uint64_t fileLength = fileInfo.size();
 
-    bool success = readFromStream(fileLength, fileInputStream);
+    // decide if this is binary SVO or JSON-formatted SVO
+    char firstChar;
+    file.getChar(&firstChar);
+    file.ungetChar(firstChar);
+    if (firstChar == (char) PacketType::EntityData) {
+        qCWarning(octree) << "Reading from binary SVO no longer supported";
+        return false;
+    }
+
+    bool success = parseJSONFromStream(fileLength, fileInputStream, entityDescription);
 
     file.close();
 
@@ -694,6 +723,11 @@ bool Octree::readFromFile(const char* fileName) {
 }
 
 bool Octree::readJSONFromGzippedFile(QString qFileName) {
+    QVariantMap entityDescription;
+    return parseJSONFromGzippedFile(qFileName, entityDescription) && readFromMap(entityDescription);
+}
+
+bool Octree::parseJSONFromGzippedFile(QString qFileName, QVariantMap& entityDescription) {
     QFile file(qFileName);
     if (!file.open(QIODevice::ReadOnly)) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
@@ -708,7 +742,27 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
     }
 
     QDataStream jsonStream(jsonData);
-    return readJSONFromStream(-1, jsonStream);
+    return parseJSONFromStream(-1, jsonStream, entityDescription);
+}
+
+bool Octree::readBinaryFromFile(QString qFileName) {
+    QFile file(qFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open binary octree file for reading: " << qFileName;
+        return false;
+    }
+
+    // decode straight from the page cache when we can
+    qint64 size = file.size();
+    const unsigned char* data = file.map(0, size);
+    if (data) {
+        bool success = readFromBinary(data, size);
+        file.unmap(const_cast<unsigned char*>(data));
+        return success;
+    }
+
+    QByteArray contents = file.readAll();
+    return readFromBinary(reinterpret_cast<const unsigned char*>(contents.constData()), contents.size());
 }
 
 // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
@@ -812,34 +866,45 @@ QVariantMap addMarketplaceIDToDocumentEntities(QVariantMap& doc, const QString&
 }
 
 }  // Unnamed namepsace
-const int READ_JSON_BUFFER_SIZE = 2048;
+const int READ_JSON_BUFFER_SIZE = 64 * 1024;
 
 bool Octree::readJSONFromStream(
     uint64_t streamLength,
     QDataStream& inputStream,
     const QString& marketplaceID /*=""*/
+) {
+    QVariantMap asMap;
+    return parseJSONFromStream(streamLength, inputStream, asMap, marketplaceID) && readFromMap(asMap);
+}
+
+bool Octree::parseJSONFromStream(
+    uint64_t streamLength,
+    QDataStream& inputStream,
+    QVariantMap& asMap,
+    const QString& marketplaceID /*=""*/
 ) {
     // if the data is gzipped we may not have a useful bytesAvailable() result, so just keep reading until
     // we get an eof.  Leave streamLength parameter for consistency.
 
     QByteArray jsonBuffer;
-    char* rawData = new char[READ_JSON_BUFFER_SIZE];
+    if (streamLength > 0 && streamLength < (uint64_t)std::numeric_limits<int>::max()) {
+        jsonBuffer.reserve((int)streamLength);
+    }
+    std::vector<char> rawData(READ_JSON_BUFFER_SIZE);
     while (!inputStream.atEnd()) {
-        int got = inputStream.readRawData(rawData, READ_JSON_BUFFER_SIZE - 1);
+        int got = inputStream.readRawData(rawData.data(), READ_JSON_BUFFER_SIZE);
         if (got < 0) {
             qCritical() << "error while reading from json stream";
-            delete[] rawData;
             return false;
         }
         if (got == 0) {
             break;
         }
-        jsonBuffer += QByteArray(rawData, got);
+        jsonBuffer.append(rawData.data(), got);
     }
 
     OctreeEntitiesFileParser octreeParser;
     octreeParser.setEntitiesString(jsonBuffer);
-    QVariantMap asMap;
     if (!octreeParser.parseEntities(asMap)) {
         qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
         return false;
@@ -849,9 +914,7 @@ bool Octree::readJSONFromStream(
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
 
-    bool success = readFromMap(asMap);
-    delete[] rawData;
-    return success;
+    return true;
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -865,6 +928,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin") {
+        success = writeToBinaryFile(cFileName, element);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -970,6 +1035,33 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToBinaryFile(const char* fileName, const OctreeElementPointer& element) {
+    qCDebug(octree, "Saving binary octree to file %s...", fileName);
+
+    QByteArray binaryDataForFile;
+    if (!writeToBinary(binaryDataForFile, element)) {
+        qCritical("Failed to convert octree to binary.");
+        return false;
+    }
+
+    QSaveFile persistFile(fileName);
+    bool success = false;
+    if (persistFile.open(QIODevice::WriteOnly)) {
+        if (persistFile.write(binaryDataForFile) != -1) {
+            success = persistFile.commit();
+            if (!success) {
+                qCritical() << "Failed to commit to binary save file:" << persistFile.errorString();
+            }
+        } else {
+            qCritical("Failed to write to binary file.");
+        }
+    } else {
+        qCritical("Failed to open binary file for writing.");
+    }
+
+    return success;
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
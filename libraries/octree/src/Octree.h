@@ -207,9 +207,12 @@ public:
     bool toJSON(QByteArray* data, const OctreeElementPointer& element = nullptr, bool doGzip = false);
     bool writeToFile(const char* filename, const OctreeElementPointer& element = nullptr, QString persistAsFileType = "json.gz");
     bool writeToJSONFile(const char* filename, const OctreeElementPointer& element = nullptr, bool doGzip = false);
+    bool writeToBinaryFile(const char* filename, const OctreeElementPointer& element = nullptr);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    // binary snapshot of the tree, see OctreeUtils::BinaryOctreeHeader
+    virtual bool writeToBinary(QByteArray& data, const OctreeElementPointer& element) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -218,7 +221,23 @@ public:
     bool readSVOFromStream(uint64_t streamLength, QDataStream& inputStream);
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readBinaryFromFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    virtual bool readFromBinary(const unsigned char* data, qint64 size) { return false; }
+
+    // The reading and parsing half of the JSON importers, which doesn't touch the tree and so can be done before
+    // taking its lock, readFromMap then adds the entities. Binary files are decoded as they are added by readFromFile.
+    static bool isBinaryFile(const char* fileName);
+    static bool parseJSONFromFile(const char* fileName, QVariantMap& entityDescription);
+    static bool parseJSONFromGzippedFile(QString qFileName, QVariantMap& entityDescription);
+    static bool parseJSONFromStream(uint64_t streamLength, QDataStream& inputStream, QVariantMap& entityDescription,
+                                    const QString& marketplaceID = "");
+
+    // Journal of the changes between snapshots, see OctreePersistThread. Once started, the tree tracks what
+    // changed and writeJournalRecords appends the records of everything changed since it was last called.
+    virtual bool startJournal() { return false; }
+    virtual bool writeJournalRecords(QByteArray& records) { return false; }
+    virtual bool readJournalRecords(const unsigned char* data, qint64 size) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -247,6 +266,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
+    int getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
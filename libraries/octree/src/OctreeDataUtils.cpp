@@ -60,6 +60,19 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromFile(QString path) {
     return readOctreeDataInfoFromData(data);
 }
 
+bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromBinary(const QByteArray& data) {
+    BinaryOctreeHeader header;
+    if (!readBinaryOctreeHeader(reinterpret_cast<const unsigned char*>(data.constData()), data.size(), header)) {
+        return false;
+    }
+
+    // same fields as the JSON "Id", "DataVersion" and "Version"
+    id = header.getID();
+    dataVersion = header.dataVersion;
+    version = header.dataPacketVersion;
+    return true;
+}
+
 QByteArray OctreeUtils::RawOctreeData::toByteArray() {
     QByteArray jsonString;
 
@@ -114,3 +127,62 @@ void OctreeUtils::RawEntityData::writeSubclassData(QByteArray& root) const {
 }
 
 PacketType OctreeUtils::RawEntityData::dataPacketType() const { return PacketType::EntityData; }
+
+static void writeHeaderID(uint8_t* id, const QUuid& uuid) {
+    QByteArray bytes = uuid.toRfc4122();
+    memcpy(id, bytes.constData(), NUM_BYTES_RFC4122_UUID);
+}
+
+static QUuid readHeaderID(const uint8_t* id) {
+    return QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(id), NUM_BYTES_RFC4122_UUID));
+}
+
+void OctreeUtils::BinaryOctreeHeader::setID(const QUuid& uuid) {
+    writeHeaderID(id, uuid);
+}
+
+QUuid OctreeUtils::BinaryOctreeHeader::getID() const {
+    return readHeaderID(id);
+}
+
+bool OctreeUtils::readBinaryOctreeHeader(const unsigned char* data, qint64 size, BinaryOctreeHeader& header) {
+    if (size < (qint64)sizeof(BinaryOctreeHeader)) {
+        return false;
+    }
+
+    BinaryOctreeHeader expected;
+    memcpy(&header, data, sizeof(BinaryOctreeHeader));
+    if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) {
+        return false;
+    }
+    if (header.formatVersion != BINARY_OCTREE_FORMAT_VERSION) {
+        qWarning() << "Unsupported binary octree format version" << header.formatVersion;
+        return false;
+    }
+    return true;
+}
+
+void OctreeUtils::OctreeJournalHeader::setID(const QUuid& uuid) {
+    writeHeaderID(id, uuid);
+}
+
+QUuid OctreeUtils::OctreeJournalHeader::getID() const {
+    return readHeaderID(id);
+}
+
+bool OctreeUtils::readOctreeJournalHeader(const unsigned char* data, qint64 size, OctreeJournalHeader& header) {
+    if (size < (qint64)sizeof(OctreeJournalHeader)) {
+        return false;
+    }
+
+    OctreeJournalHeader expected;
+    memcpy(&header, data, sizeof(OctreeJournalHeader));
+    if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) {
+        return false;
+    }
+    if (header.formatVersion != BINARY_OCTREE_FORMAT_VERSION) {
+        qWarning() << "Unsupported octree journal format version" << header.formatVersion;
+        return false;
+    }
+    return true;
+}
@@ -12,6 +12,7 @@
 #define hifi_OctreeDataUtils_h
 
 #include <udt/PacketHeaders.h>
+#include <UUID.h>
 
 #include <QJsonObject>
 #include <QUuid>
@@ -24,6 +25,48 @@ constexpr Version INITIAL_VERSION = 0;
 
 //using PacketType = uint8_t;
 
+constexpr uint32_t BINARY_OCTREE_FORMAT_VERSION = 1;
+
+// Binary octree files start with this header, followed by numRecords records in the format of the octree
+// subclass (see Octree::writeToBinary). Everything is stored in native byte order, like the edit packets.
+struct BinaryOctreeHeader {
+    char magic[4] { 'H', 'F', 'O', 'B' };
+    uint32_t formatVersion { BINARY_OCTREE_FORMAT_VERSION };
+    uint32_t dataPacketVersion { 0 };
+    uint32_t numRecords { 0 };
+    uint8_t id[NUM_BYTES_RFC4122_UUID] { };
+    int64_t dataVersion { 0 };
+
+    void setID(const QUuid& uuid);
+    QUuid getID() const;
+};
+
+// returns false if the data doesn't start with a header this version can read
+bool readBinaryOctreeHeader(const unsigned char* data, qint64 size, BinaryOctreeHeader& header);
+
+// Octree journals hold the changes made since the snapshot with the same id and dataVersion. They start with
+// this header, followed by a block for each persist, each block being a JournalBlockHeader and the records in
+// the format of the octree subclass (see Octree::writeJournalRecords).
+struct OctreeJournalHeader {
+    char magic[4] { 'H', 'F', 'O', 'J' };
+    uint32_t formatVersion { BINARY_OCTREE_FORMAT_VERSION };
+    uint32_t dataPacketVersion { 0 };
+    uint32_t reserved { 0 };
+    uint8_t id[NUM_BYTES_RFC4122_UUID] { };
+    int64_t dataVersion { 0 };
+
+    void setID(const QUuid& uuid);
+    QUuid getID() const;
+};
+
+struct JournalBlockHeader {
+    uint32_t size { 0 };
+    uint32_t checksum { 0 }; // qChecksum of the records, a block cut short by a crash doesn't match it
+};
+
+// returns false if the data doesn't start with a header this version can read
+bool readOctreeJournalHeader(const unsigned char* data, qint64 size, OctreeJournalHeader& header);
+
 // RawOctreeData is an intermediate format between JSON and a fully deserialized Octree.
 class RawOctreeData {
 public:
@@ -41,6 +84,7 @@ public:
     QByteArray toGzippedByteArray();
 
     bool readOctreeDataInfoFromData(QByteArray data);
+    bool readOctreeDataInfoFromBinary(const QByteArray& data);
     bool readOctreeDataInfoFromFile(QString path);
     bool readOctreeDataInfoFromMap(const QVariantMap& map);
 };
@@ -11,6 +11,7 @@
 
 #include "OctreeEntitiesFileParser.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cctype>
 
@@ -18,6 +19,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 
+#include <ThreadHelpers.h>
 
 using std::string;
 
@@ -145,6 +147,7 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
             }
 
             parsedEntities["Paths"] = pathsObject.object();
+            _line += (int)std::count(_entitiesContents.constData() + _position, _entitiesContents.constData() + matchingBrace, '\n');
             _position = matchingBrace;
         } else {
             _errorString = "Unrecognized key name: " + key;
@@ -212,6 +215,9 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
         return false;
     }
 
+    // Finding where each entity ends is a quick scan, parsing them is not. The entities are found
+    // first and then parsed on as many threads as there are cores.
+    std::vector<EntityText> entityTexts;
     while (true) {
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
@@ -223,23 +229,51 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
-            return false;
-        }
-
-        entitiesArray.append(entity.object());
+        entityTexts.push_back({ _position - 1, matchingBrace - _position + 1, _line });
+        _line += (int)std::count(_entitiesContents.constData() + _position, _entitiesContents.constData() + matchingBrace, '\n');
         _position = matchingBrace;
         char c = nextToken();
         if (c == ']') {
-            return true;
+            break;
         } else if (c != ',') {
             _errorString = "Entity array item incorrectly terminated";
             return false;
         }
     }
+
+    return parseEntityTexts(entityTexts, entitiesArray);
+}
+
+bool OctreeEntitiesFileParser::parseEntityTexts(const std::vector<EntityText>& entityTexts, QVariantList& entitiesArray) {
+    const int MIN_ENTITIES_PER_THREAD = 256;
+    int numEntities = (int)entityTexts.size();
+    std::vector<QJsonObject> entities(numEntities);
+    std::vector<uint8_t> parsed(numEntities);
+
+    auto parseRange = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const EntityText& text = entityTexts[i];
+            QJsonDocument entity = QJsonDocument::fromJson(
+                QByteArray::fromRawData(_entitiesContents.constData() + text.position, text.length));
+            parsed[i] = !entity.isNull();
+            if (parsed[i]) {
+                entities[i] = entity.object();
+            }
+        }
+    };
+
+    forEachRangeInParallel(numEntities, MIN_ENTITIES_PER_THREAD, parseRange);
+
+    entitiesArray.reserve(numEntities);
+    for (int i = 0; i < numEntities; ++i) {
+        if (!parsed[i]) {
+            _position = entityTexts[i].position + 1;
+            _line = entityTexts[i].line;
+            _errorString = "Ill-formed entity";
+            return false;
+        }
+        entitiesArray.append(entities[i]);
+    }
     return true;
 }
 
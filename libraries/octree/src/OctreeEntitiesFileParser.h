@@ -14,6 +14,8 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <vector>
+
 #include <QByteArray>
 #include <QVariant>
 
@@ -24,10 +26,17 @@ public:
     std::string getErrorString() const;
 
 private:
+    struct EntityText {
+        int position;
+        int length;
+        int line;
+    };
+
     int nextToken();
     std::string readString();
     int readInteger();
     bool readEntitiesArray(QVariantList& entitiesArray);
+    bool parseEntityTexts(const std::vector<EntityText>& entityTexts, QVariantList& entitiesArray);
     int findMatchingBrace() const;
 
     QByteArray _entitiesContents;
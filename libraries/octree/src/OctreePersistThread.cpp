@@ -15,6 +15,7 @@
 #include <thread>
 
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <time.h>
 
@@ -40,11 +41,14 @@
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
+constexpr std::chrono::minutes JOURNAL_COMPACTION_INTERVAL { 10 };
+constexpr qint64 MAX_JOURNAL_SIZE_BYTES { 16 * 1000 * 1000 };
+
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
-                                         bool debugTimestampNow, QString persistAsFileType) :
+                                         bool debugTimestampNow, QString persistAsFileType, bool wantJournal) :
     _tree(tree),
     _filename(filename),
     _persistInterval(persistInterval),
@@ -53,11 +57,14 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _loadTimeUSecs(0),
     _debugTimestampNow(debugTimestampNow),
     _lastTimeDebug(0),
-    _persistAsFileType(persistAsFileType)
+    _persistAsFileType(persistAsFileType),
+    _wantJournal(wantJournal),
+    _lastSnapshot(std::chrono::steady_clock::now())
 {
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+    _jsonFilename = _filename;
 }
 
 void OctreePersistThread::start() {
@@ -72,8 +79,29 @@ void OctreePersistThread::start() {
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    QFile file(_filename);
+    if (isBinary()) {
+        // only the header is needed now, the entities are read straight from the file once the DS replies
+        QFile file(_filename);
+        if (file.open(QIODevice::ReadOnly) && data.readOctreeDataInfoFromBinary(file.read(sizeof(OctreeUtils::BinaryOctreeHeader))) &&
+            data.version == versionForPacketType(_tree->expectedDataPacketType())) {
+            qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.version << ")";
+            packet->writePrimitive(true);
+            auto id = data.id.toRfc4122();
+            packet->write(id);
+            packet->writePrimitive(data.version);
+
+            qCDebug(octree) << "Sending OctreeDataFileRequest to DS";
+            nodeList->sendPacket(std::move(packet), domainHandler.getSockAddr());
+            return;
+        }
+
+        // fall back to the JSON file, either from before switching to the binary format or for a different version
+        qCDebug(octree) << "No binary octree data in" << _filename;
+        _jsonFilename = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS) + ".json.gz";
+    }
+
+    qCDebug(octree) << "Reading octree data from" << _jsonFilename;
+    QFile file(_jsonFilename);
     if (file.open(QIODevice::ReadOnly)) {
         QByteArray jsonData(file.readAll());
         file.close();
@@ -93,7 +121,7 @@ void OctreePersistThread::start() {
             packet->writePrimitive(false);
         }
     } else {
-        qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
+        qCWarning(octree) << "Couldn't access file" << _jsonFilename << file.errorString();
         packet->writePrimitive(false);
     }
 
@@ -115,9 +143,21 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     if (includesNewData) {
         _cachedJSONData.clear();
         replacementData = message->readAll();
-        replaceData(replacementData);
-        hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        if (isBinary()) {
+            // the DS always sends JSON, load it from memory and save it in the binary format once loaded
+            backupCurrentFile();
+            if (!gunzip(replacementData, _cachedJSONData)) {
+                _cachedJSONData = replacementData;
+            }
+            hasValidOctreeData = data.readOctreeDataInfoFromData(_cachedJSONData);
+        } else {
+            replaceData(replacementData);
+            hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        }
         qDebug() << "Got OctreeDataFileReply, new data sent";
+    } else if (isBinary() && _cachedJSONData.isEmpty()) {
+        qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
+        hasValidOctreeData = data.readOctreeDataInfoFromBinary(getPersistFileHeader());
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
@@ -129,7 +169,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
                 qCDebug(octree) << "Current octree data has a null id, updating";
                 data.resetIdAndVersion();
 
-                QFile file(_filename);
+                QFile file(_jsonFilename);
                 if (file.open(QIODevice::WriteOnly)) {
                     auto entityData = data.toGzippedByteArray();
                     file.write(entityData);
@@ -148,26 +188,57 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         _tree->setOctreeVersionInfo(data.id, data.version);
     }
 
-    bool persistentFileRead;
+    bool persistentFileRead = false;
+
+    // read and parse JSON before taking the tree lock, only adding the entities to the tree needs it
+    QByteArray fileName = _filename.toLocal8Bit();
+    bool isBinaryFile = _cachedJSONData.isEmpty() && Octree::isBinaryFile(fileName.constData());
+    QVariantMap entityDescription;
+    if (!_cachedJSONData.isEmpty()) {
+        QDataStream jsonStream(_cachedJSONData);
+        persistentFileRead = Octree::parseJSONFromStream(-1, jsonStream, entityDescription);
+    } else if (!isBinaryFile) {
+        persistentFileRead = Octree::parseJSONFromFile(fileName.constData(), entityDescription);
+    }
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        if (_cachedJSONData.isEmpty()) {
-            persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
-        } else {
-            QDataStream jsonStream(_cachedJSONData);
-            persistentFileRead = _tree->readFromStream(-1, jsonStream);
+        if (isBinaryFile) {
+            // binary snapshots are decoded as their entities are added
+            persistentFileRead = _tree->readFromFile(fileName.constData());
+        } else if (persistentFileRead) {
+            persistentFileRead = _tree->readFromMap(entityDescription);
         }
         _tree->pruneTree();
     });
 
+    // bring the snapshot up to date with the changes journaled since it was written, unless it was just replaced
+    bool replayedJournal = persistentFileRead && replacementData.isNull() && replayJournal();
+
+    // anything that didn't come from the binary file needs to be written to it
+    bool needsBinaryPersist = isBinary() && !_cachedJSONData.isEmpty();
+
     _cachedJSONData.clear();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
+    if (replayedJournal) {
+        // compact the journal right away, the next one starts from the new snapshot
+        writeSnapshot();
+    } else {
+        resetJournal();
+    }
+
+    if (needsBinaryPersist && persistentFileRead && !replayedJournal) {
+        qCDebug(octree) << "Converting octree data to" << _filename;
+        if (!_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
+            qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+        }
+    }
+
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
     unsigned long leafNodeCount = OctreeElement::getLeafNodeCount();
@@ -190,6 +261,16 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
+    if (!replayedJournal) {
+        _lastSnapshot = _lastPersistCheck;
+    }
+
+    if (_wantJournal) {
+        _isJournaling = _tree->startJournal();
+        if (!_isJournaling) {
+            qCWarning(octree) << "Octree can't journal its changes, persisting snapshots instead";
+        }
+    }
 
     if (replacementData.isNull()) {
         sendLatestEntityDataToDS();
@@ -204,12 +285,20 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || isBinary()) {
         return "application/zip";
     }
     return "";
 }
 
+QByteArray OctreePersistThread::getPersistFileHeader() const {
+    QFile file(_filename);
+    if (file.open(QIODevice::ReadOnly)) {
+        return file.read(sizeof(OctreeUtils::BinaryOctreeHeader));
+    }
+    return QByteArray();
+}
+
 void OctreePersistThread::replaceData(QByteArray data) {
     backupCurrentFile();
 
@@ -257,12 +346,22 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
-    persist();
+    // leave a snapshot without a journal behind, another version of the server may not be able to replay it
+    if (_journalFile.isOpen()) {
+        _tree->setDirtyBit();
+    }
+    persist(false);
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (isBinary()) {
+        // the binary format is only for this server, always hand out JSON
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -300,27 +399,146 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
     qDebug() << "Found" << count << "backups";
 }
 
-void OctreePersistThread::persist() {
+void OctreePersistThread::persist(bool allowJournal) {
     if (_tree->isDirty() && _initialLoadComplete) {
+        if (allowJournal && _isJournaling && !needsCompaction() && appendToJournal()) {
+            // the domain server gets the compacted snapshots only
+            return;
+        }
+
+        writeSnapshot();
+        sendLatestEntityDataToDS();
+    }
+}
 
-        _tree->withWriteLock([&] {
-            qCDebug(octree) << "pruning Octree before saving...";
-            _tree->pruneTree();
-            qCDebug(octree) << "DONE pruning Octree before saving...";
-        });
+bool OctreePersistThread::needsCompaction() const {
+    auto timeSinceLastSnapshot = std::chrono::steady_clock::now() - _lastSnapshot;
+    return timeSinceLastSnapshot > JOURNAL_COMPACTION_INTERVAL ||
+        (_journalFile.isOpen() && _journalFile.size() > MAX_JOURNAL_SIZE_BYTES);
+}
 
-        _tree->incrementPersistDataVersion();
+void OctreePersistThread::writeSnapshot() {
+    _tree->withWriteLock([&] {
+        qCDebug(octree) << "pruning Octree before saving...";
+        _tree->pruneTree();
+        qCDebug(octree) << "DONE pruning Octree before saving...";
+    });
 
-        qCDebug(octree) << "Saving Octree data to:" << _filename;
-        if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
-            _tree->clearDirtyBit(); // tree is clean after saving
-            qCDebug(octree) << "DONE persisting Octree data to" << _filename;
-        } else {
-            qCWarning(octree) << "Failed to persist Octree data to" << _filename;
-        }
+    _tree->incrementPersistDataVersion();
 
-        sendLatestEntityDataToDS();
+    // anything changed while saving is left dirty for the next persist
+    _tree->clearDirtyBit();
+
+    qCDebug(octree) << "Saving Octree data to:" << _filename;
+    if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
+        qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+        resetJournal();
+        _lastSnapshot = std::chrono::steady_clock::now();
+    } else {
+        qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+        _tree->setDirtyBit();
+    }
+}
+
+bool OctreePersistThread::appendToJournal() {
+    QByteArray records;
+    bool success = false;
+    _tree->withReadLock([&] {
+        // anything changed after this is in the next records
+        _tree->clearDirtyBit();
+        success = _tree->writeJournalRecords(records);
+    });
+    if (success && records.isEmpty()) {
+        return true;
+    }
+
+    if (success && !_journalFile.isOpen()) {
+        _journalFile.setFileName(getJournalFilename());
+        OctreeUtils::OctreeJournalHeader header;
+        header.dataPacketVersion = versionForPacketType(_tree->expectedDataPacketType());
+        header.setID(_tree->getPersistID());
+        header.dataVersion = _tree->getPersistDataVersion();
+        success = _journalFile.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+            _journalFile.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+    }
+
+    if (success) {
+        OctreeUtils::JournalBlockHeader block;
+        block.size = records.size();
+        block.checksum = qChecksum(records.constData(), records.size());
+        success = _journalFile.write(reinterpret_cast<const char*>(&block), sizeof(block)) == sizeof(block) &&
+            _journalFile.write(records) == records.size() && _journalFile.flush();
+    }
+
+    if (!success) {
+        // the changes that didn't make it to the journal make it to the next snapshot
+        qCWarning(octree) << "Failed to journal Octree changes to" << getJournalFilename() << _journalFile.errorString();
+        _journalFile.close();
+        _tree->setDirtyBit();
+        return false;
+    }
+    return true;
+}
+
+bool OctreePersistThread::replayJournal() {
+    QFile file(getJournalFilename());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray journal = file.readAll();
+    file.close();
+
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(journal.constData());
+    qint64 size = journal.size();
+    OctreeUtils::OctreeJournalHeader header;
+    if (!OctreeUtils::readOctreeJournalHeader(data, size, header)) {
+        qCWarning(octree) << "Ignoring" << file.fileName() << "- not an octree journal";
+        return false;
     }
+    if (header.getID() != _tree->getPersistID() || header.dataVersion != _tree->getPersistDataVersion() ||
+        header.dataPacketVersion != versionForPacketType(_tree->expectedDataPacketType())) {
+        qCWarning(octree) << "Ignoring" << file.fileName() << "- it was journaled for another snapshot:"
+            << header.getID() << header.dataVersion;
+        return false;
+    }
+
+    int numBlocks = 0;
+    _tree->withWriteLock([&] {
+        PerformanceWarning warn(true, "Replaying Octree Journal", true);
+
+        qint64 offset = sizeof(header);
+        while (offset < size) {
+            OctreeUtils::JournalBlockHeader block;
+            if (offset + (qint64)sizeof(block) > size) {
+                break;
+            }
+            memcpy(&block, data + offset, sizeof(block));
+            offset += sizeof(block);
+            if (offset + block.size > size ||
+                qChecksum(reinterpret_cast<const char*>(data + offset), block.size) != block.checksum) {
+                break;
+            }
+
+            if (!_tree->readJournalRecords(data + offset, block.size)) {
+                qCWarning(octree) << "Failed to replay some of the changes journaled in" << file.fileName();
+            }
+            offset += block.size;
+            ++numBlocks;
+        }
+
+        if (offset < size) {
+            // the last persist was cut short, everything before it is still good
+            qCWarning(octree) << "Dropped an incomplete block at the end of" << file.fileName();
+        }
+    });
+
+    qCDebug(octree) << "Replayed" << numBlocks << "persists from" << file.fileName();
+    return numBlocks > 0;
+}
+
+void OctreePersistThread::resetJournal() {
+    _journalFile.close();
+    QFile::remove(getJournalFilename());
 }
 
 void OctreePersistThread::sendLatestEntityDataToDS() {
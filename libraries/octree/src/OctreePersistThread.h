@@ -14,10 +14,13 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <QFile>
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
 
+class OctreeJournalTests;
+
 class OctreePersistThread : public QObject {
     Q_OBJECT
 public:
@@ -36,14 +39,17 @@ public:
                         const QString& filename,
                         std::chrono::milliseconds persistInterval = DEFAULT_PERSIST_INTERVAL,
                         bool debugTimestampNow = false,
-                        QString persistAsFileType = "json.gz");
+                        QString persistAsFileType = "json.gz",
+                        bool wantJournal = false);
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
 
     QString getPersistFilename() const { return _filename; }
+    QString getJournalFilename() const { return _filename + ".journal"; }
     QString getPersistFileMimeType() const;
     QByteArray getPersistFileContents() const;
+    bool isBinary() const { return _persistAsFileType == "bin"; }
 
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
@@ -58,11 +64,17 @@ protected slots:
     void handleOctreeDataFileReply(QSharedPointer<ReceivedMessage> message);
 
 protected:
-    void persist();
+    void persist(bool allowJournal = true);
+    bool needsCompaction() const;
+    void writeSnapshot();
+    bool appendToJournal();
+    bool replayJournal();
+    void resetJournal();
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
     void replaceData(QByteArray data);
+    QByteArray getPersistFileHeader() const;
     void sendLatestEntityDataToDS();
 
 private:
@@ -78,7 +90,17 @@ private:
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
+    QString _jsonFilename; // where the JSON is read from, the persist file unless it is binary
     QByteArray _cachedJSONData;
+
+    // Between snapshots, only the changes are appended to a journal next to the persist file. The journal
+    // is compacted into a new snapshot once in a while, or when it grows too large.
+    bool _wantJournal;
+    bool _isJournaling { false };
+    QFile _journalFile;
+    std::chrono::steady_clock::time_point _lastSnapshot;
+
+    friend class ::OctreeJournalTests;
 };
 
 #endif // hifi_OctreePersistThread_h
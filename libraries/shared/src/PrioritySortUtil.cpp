@@ -0,0 +1,155 @@
+//
+//  PrioritySortUtil.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtil.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace PrioritySortUtil;
+
+void SortableData::resize(size_t num) {
+    _x.resize(num);
+    _y.resize(num);
+    _z.resize(num);
+    _radius.resize(num);
+    _age.resize(num);
+}
+
+const float AVOID_DIVIDE_BY_ZERO = 0.001f; // add 1mm to avoid divide by zero
+const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
+
+static float computePriority(const ConicalViewFrustum& view, float angularWeight, float centerWeight, float ageWeight,
+                             const glm::vec3& position, float thingRadius, float age) {
+    glm::vec3 offset = position - view.getPosition();
+    float distance = glm::length(offset) + AVOID_DIVIDE_BY_ZERO;
+    float radius = glm::max(thingRadius, MIN_RADIUS);
+    // Other item's angle from view centre:
+    float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+    if (cosineAngle > 0.0f) {
+        cosineAngle = std::sqrt(cosineAngle);
+    }
+
+    // the "age" term accumulates at the sum of all weights
+    float angularSize = radius / distance;
+    float priority = (angularWeight * angularSize + centerWeight * cosineAngle) * (age + 1.0f) + ageWeight * age;
+
+    // decrement priority of things outside keyhole
+    if (distance - radius > view.getRadius()) {
+        if (!view.intersects(offset, distance, radius)) {
+            priority += OUT_OF_VIEW_PENALTY;
+        }
+    }
+    return priority;
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// same as computePriority, 4 things at a time, returns the number of things done
+static size_t computePriorities_SSE(const ConicalViewFrustum& view, float angularWeight, float centerWeight, float ageWeight,
+                                    const SortableData& data, float* priorities) {
+    const __m128 viewX = _mm_set1_ps(view.getPosition().x);
+    const __m128 viewY = _mm_set1_ps(view.getPosition().y);
+    const __m128 viewZ = _mm_set1_ps(view.getPosition().z);
+    const __m128 directionX = _mm_set1_ps(view.getDirection().x);
+    const __m128 directionY = _mm_set1_ps(view.getDirection().y);
+    const __m128 directionZ = _mm_set1_ps(view.getDirection().z);
+    const __m128 viewRadius = _mm_set1_ps(view.getRadius());
+    const __m128 farClip = _mm_set1_ps(view.getFarClip());
+    const __m128 cosAngle = _mm_set1_ps(view.getCosAngle());
+    const __m128 sinAngle = _mm_set1_ps(view.getSinAngle());
+    const __m128 angularCoef = _mm_set1_ps(angularWeight);
+    const __m128 centerCoef = _mm_set1_ps(centerWeight);
+    const __m128 ageCoef = _mm_set1_ps(ageWeight);
+    const __m128 penalty = _mm_set1_ps(OUT_OF_VIEW_PENALTY);
+    const __m128 minRadius = _mm_set1_ps(MIN_RADIUS);
+    const __m128 avoidDivideByZero = _mm_set1_ps(AVOID_DIVIDE_BY_ZERO);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const float* x = data.getX();
+    const float* y = data.getY();
+    const float* z = data.getZ();
+    const float* r = data.getRadius();
+    const float* a = data.getAge();
+
+    size_t numThings = data.size() & ~(size_t)3;
+    for (size_t i = 0; i < numThings; i += 4) {
+        __m128 offsetX = _mm_sub_ps(_mm_loadu_ps(&x[i]), viewX);
+        __m128 offsetY = _mm_sub_ps(_mm_loadu_ps(&y[i]), viewY);
+        __m128 offsetZ = _mm_sub_ps(_mm_loadu_ps(&z[i]), viewZ);
+
+        __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, offsetX), _mm_mul_ps(offsetY, offsetY)),
+                                      _mm_mul_ps(offsetZ, offsetZ));
+        __m128 distance = _mm_add_ps(_mm_sqrt_ps(distance2), avoidDivideByZero);
+        __m128 radius = _mm_max_ps(_mm_loadu_ps(&r[i]), minRadius);
+
+        __m128 projection = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, directionX), _mm_mul_ps(offsetY, directionY)),
+                                       _mm_mul_ps(offsetZ, directionZ));
+        __m128 cosineAngle = _mm_div_ps(projection, distance);
+        __m128 isFacing = _mm_cmpgt_ps(cosineAngle, zero);
+        cosineAngle = _mm_or_ps(_mm_and_ps(isFacing, _mm_sqrt_ps(_mm_max_ps(cosineAngle, zero))),
+                                _mm_andnot_ps(isFacing, cosineAngle));
+
+        __m128 age = _mm_loadu_ps(&a[i]);
+        __m128 angularSize = _mm_div_ps(radius, distance);
+        __m128 priority = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(angularCoef, angularSize), _mm_mul_ps(centerCoef, cosineAngle)),
+                                                _mm_add_ps(age, one)),
+                                     _mm_mul_ps(ageCoef, age));
+
+        // outside keyhole and outside the cone, see ConicalViewFrustum::intersects
+        __m128 isOutsideKeyhole = _mm_cmpgt_ps(_mm_sub_ps(distance, radius), viewRadius);
+        __m128 isInsideKeyhole = _mm_cmplt_ps(distance, _mm_add_ps(viewRadius, radius));
+        __m128 isPastFarClip = _mm_cmpgt_ps(distance, _mm_add_ps(farClip, radius));
+        __m128 coneLimit = _mm_sub_ps(_mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_mul_ps(distance, distance), _mm_mul_ps(radius, radius))), cosAngle),
+                                      _mm_mul_ps(radius, sinAngle));
+        __m128 isInCone = _mm_cmpgt_ps(projection, coneLimit);
+        __m128 intersects = _mm_or_ps(isInsideKeyhole, _mm_andnot_ps(isPastFarClip, isInCone));
+        __m128 isOutOfView = _mm_andnot_ps(intersects, isOutsideKeyhole);
+        priority = _mm_add_ps(priority, _mm_and_ps(isOutOfView, penalty));
+
+        __m128 previous = _mm_loadu_ps(&priorities[i]);
+        _mm_storeu_ps(&priorities[i], _mm_max_ps(priority, previous));
+    }
+    return numThings;
+}
+
+#else
+
+static size_t computePriorities_SSE(const ConicalViewFrustum& view, float angularWeight, float centerWeight, float ageWeight,
+                                    const SortableData& data, float* priorities) {
+    return 0;
+}
+
+#endif
+
+void PrioritySortUtil::computePriorities(const ConicalViewFrustums& views, float angularWeight, float centerWeight,
+                                         float ageWeight, const SortableData& data, float* priorities) {
+    size_t numThings = data.size();
+    std::fill(priorities, priorities + numThings, std::numeric_limits<float>::min());
+
+    for (const auto& view : views) {
+        size_t i = computePriorities_SSE(view, angularWeight, centerWeight, ageWeight, data, priorities);
+
+        // remainder
+        for (; i < numThings; ++i) {
+            glm::vec3 position(data.getX()[i], data.getY()[i], data.getZ()[i]);
+            float priority = computePriority(view, angularWeight, centerWeight, ageWeight,
+                                             position, data.getRadius()[i], data.getAge()[i]);
+            priorities[i] = std::max(priorities[i], priority);
+        }
+    }
+}
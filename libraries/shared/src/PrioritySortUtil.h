@@ -11,6 +11,9 @@
 #ifndef hifi_PrioritySortUtil_h
 #define hifi_PrioritySortUtil_h
 
+#include <algorithm>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include "NumericalConstants.h"
@@ -41,10 +44,48 @@ namespace PrioritySortUtil {
         float _priority { 0.0f };
     };
 
+    // Positions, radii and ages of the things to sort, in separate arrays so that
+    // their priorities can be computed several at a time.
+    class SortableData {
+    public:
+        size_t size() const { return _radius.size(); }
+        void resize(size_t num);
+        void set(size_t i, const glm::vec3& position, float radius, float age) {
+            _x[i] = position.x;
+            _y[i] = position.y;
+            _z[i] = position.z;
+            _radius[i] = radius;
+            _age[i] = age;
+        }
+
+        const float* getX() const { return _x.data(); }
+        const float* getY() const { return _y.data(); }
+        const float* getZ() const { return _z.data(); }
+        const float* getRadius() const { return _radius.data(); }
+        const float* getAge() const { return _age.data(); }
+
+    private:
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _z;
+        std::vector<float> _radius;
+        std::vector<float> _age;
+    };
+
+    // priority = max over views of a weighted linear combination of multiple values:
+    //   (a) angular size
+    //   (b) proximity to center of view
+    //   (c) time since last update
+    // where the relative "weights" are tuned to scale the contributing values into units of "priority".
+    void computePriorities(const ConicalViewFrustums& views, float angularWeight, float centerWeight, float ageWeight,
+                           const SortableData& data, float* priorities);
+
+    // The queue can be cleared and refilled without releasing its storage,
+    // so it is worth keeping one around when sorting repeatedly.
     template <typename T>
     class PriorityQueue {
     public:
-        PriorityQueue() = delete;
+        PriorityQueue() = default;
         PriorityQueue(const ConicalViewFrustums& views) : _views(views) { }
         PriorityQueue(const ConicalViewFrustums& views, float angularWeight, float centerWeight, float ageWeight)
             : _views(views), _angularWeight(angularWeight), _centerWeight(centerWeight), _ageWeight(ageWeight)
@@ -62,69 +103,45 @@ namespace PrioritySortUtil {
 
         size_t size() const { return _vector.size(); }
         void push(T thing) {
-            thing.setPriority(computePriority(thing));
             _vector.push_back(thing);
         }
         void reserve(size_t num) {
             _vector.reserve(num);
         }
-        const std::vector<T>& getSortedVector(int numToSort = 0) {
-            if (numToSort == 0 || numToSort >= (int)_vector.size()) {
-                std::sort(_vector.begin(), _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
-            } else {
-                std::partial_sort(_vector.begin(), _vector.begin() + numToSort, _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
-            }
-            return _vector;
+        void clear() {
+            _vector.clear();
         }
-
-    private:
-
-        float computePriority(const T& thing) const {
-            float priority = std::numeric_limits<float>::min();
-
-            for (const auto& view : _views) {
-                priority = std::max(priority, computePriority(view, thing));
+        const std::vector<T>& getSortedVector(int numToSort = 0) {
+            // priorities are computed for all the things at once, just before sorting them
+            size_t numThings = _vector.size();
+            _data.resize(numThings);
+            for (size_t i = 0; i < numThings; ++i) {
+                const T& thing = _vector[i];
+                float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
+                _data.set(i, thing.getPosition(), thing.getRadius(), age);
             }
-
-            return priority;
-        }
-
-        float computePriority(const ConicalViewFrustum& view, const T& thing) const {
-            // priority = weighted linear combination of multiple values:
-            //   (a) angular size
-            //   (b) proximity to center of view
-            //   (c) time since last update
-            // where the relative "weights" are tuned to scale the contributing values into units of "priority".
-
-            glm::vec3 position = thing.getPosition();
-            glm::vec3 offset = position - view.getPosition();
-            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
-            const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
-            float radius = glm::max(thing.getRadius(), MIN_RADIUS);
-            // Other item's angle from view centre:
-            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
-            if (cosineAngle > 0.0f) {
-                cosineAngle = std::sqrt(cosineAngle);
+            _priorities.resize(numThings);
+            computePriorities(_views, _angularWeight, _centerWeight, _ageWeight, _data, _priorities.data());
+            for (size_t i = 0; i < numThings; ++i) {
+                _vector[i].setPriority(_priorities[i]);
             }
-            float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
-
-            // the "age" term accumulates at the sum of all weights
-            float angularSize = radius / distance;
-            float priority = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age + 1.0f) + _ageWeight * age;
 
-            // decrement priority of things outside keyhole
-            if (distance - radius > view.getRadius()) {
-                if (!view.intersects(offset, distance, radius)) {
-                    priority += OUT_OF_VIEW_PENALTY;
-                }
+            // only the things that will be looked at need to be in order
+            auto higherPriority = [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); };
+            if (numToSort == 0 || numToSort >= (int)numThings) {
+                std::sort(_vector.begin(), _vector.end(), higherPriority);
+            } else {
+                std::nth_element(_vector.begin(), _vector.begin() + numToSort, _vector.end(), higherPriority);
+                std::sort(_vector.begin(), _vector.begin() + numToSort, higherPriority);
             }
-            return priority;
+            return _vector;
         }
 
+    private:
         ConicalViewFrustums _views;
         std::vector<T> _vector;
+        SortableData _data;
+        std::vector<float> _priorities;
         float _angularWeight { DEFAULT_ANGULAR_COEF };
         float _centerWeight { DEFAULT_CENTER_COEF };
         float _ageWeight { DEFAULT_AGE_COEF };
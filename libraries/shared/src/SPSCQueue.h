@@ -0,0 +1,191 @@
+//
+//  SPSCQueue.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SPSCQueue_h
+#define hifi_SPSCQueue_h
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+// Bounded single-producer single-consumer queue.
+// push is only called from one thread, and pop from one other thread, neither of them ever blocks.
+template <typename T>
+class SPSCQueue {
+public:
+    // capacity is rounded up to a power of two
+    SPSCQueue(size_t capacity) : _slots(roundUpToPowerOfTwo(capacity)), _mask(_slots.size() - 1) {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    size_t capacity() const { return _slots.size(); }
+
+    // producer only, returns false and leaves item untouched if the queue is full
+    bool push(T&& item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead == _slots.size()) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead == _slots.size()) {
+                return false;
+            }
+        }
+        _slots[tail & _mask] = std::move(item);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& item) {
+        T copy(item);
+        return push(std::move(copy));
+    }
+
+    // consumer only, returns false if the queue is empty
+    bool pop(T& item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail) {
+                return false;
+            }
+        }
+        item = std::move(_slots[head & _mask]);
+        _slots[head & _mask] = T();     // release what the slot holds now, not when it gets overwritten
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // approximate when called concurrently with push or pop
+    bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+    size_t size() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        assert(value > 0);
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<T> _slots;
+    const size_t _mask;
+
+    // each side keeps a copy of the other side's index, to only touch its cache line when it looks full or empty
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head { 0 };
+    size_t _cachedTail { 0 };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail { 0 };
+    size_t _cachedHead { 0 };
+};
+
+// Single-producer single-consumer queue for items that can't all be dropped when the consumer falls behind.
+// Items that don't fit in the bounded queue go on an unbounded overflow list, and the producer keeps adding
+// to that list until the consumer has taken everything off it, so items still come out in the order they went in.
+// Neither side ever blocks, the overflow list is handed over with atomic pointer operations.
+template <typename T>
+class OverflowingSPSCQueue {
+public:
+    OverflowingSPSCQueue(size_t capacity) : _queue(capacity) {}
+    ~OverflowingSPSCQueue() {
+        deleteList(_overflowHead.load(std::memory_order_acquire));
+        deleteList(_consumerOverflow);
+    }
+
+    OverflowingSPSCQueue(const OverflowingSPSCQueue&) = delete;
+    OverflowingSPSCQueue& operator=(const OverflowingSPSCQueue&) = delete;
+
+    // producer only, when the queue is full a droppable item is dropped and false is returned
+    bool push(T&& item, bool isDroppable) {
+        // nothing goes ahead of the items that did not fit earlier
+        if (_numOverflowing.load(std::memory_order_acquire) == 0 && _queue.push(std::move(item))) {
+            return true;
+        }
+
+        if (isDroppable) {
+            return false;
+        }
+
+        _numOverflowing.fetch_add(1, std::memory_order_relaxed);
+        Node* node = new Node { std::move(item), _overflowHead.load(std::memory_order_relaxed) };
+        while (!_overflowHead.compare_exchange_weak(node->next, node,
+                                                    std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return true;
+    }
+
+    bool push(const T& item, bool isDroppable) {
+        T copy(item);
+        return push(std::move(copy), isDroppable);
+    }
+
+    // consumer only, returns false if the queue and the overflow are empty
+    bool pop(T& item) {
+        if (_queue.pop(item)) {
+            return true;
+        }
+
+        if (!_consumerOverflow) {
+            if (!_overflowHead.load(std::memory_order_relaxed)) {
+                return false;
+            }
+
+            // take the whole list at once, it is newest first
+            Node* node = _overflowHead.exchange(nullptr, std::memory_order_acquire);
+            while (node) {
+                Node* next = node->next;
+                node->next = _consumerOverflow;
+                _consumerOverflow = node;
+                node = next;
+            }
+        }
+
+        Node* node = _consumerOverflow;
+        _consumerOverflow = node->next;
+        item = std::move(node->item);
+        delete node;
+
+        // the producer goes back to the bounded queue once this reaches zero
+        _numOverflowing.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _queue.capacity(); }
+
+    // approximate when called concurrently with push or pop
+    size_t numOverflowing() const { return _numOverflowing.load(std::memory_order_acquire); }
+
+private:
+    struct Node {
+        T item;
+        Node* next;
+    };
+
+    static void deleteList(Node* node) {
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    SPSCQueue<T> _queue;
+
+    std::atomic<Node*> _overflowHead { nullptr };   // pushed to by the producer, taken whole by the consumer
+    Node* _consumerOverflow { nullptr };            // consumer only, oldest first
+    std::atomic<size_t> _numOverflowing { 0 };      // items on either list
+};
+
+#endif // hifi_SPSCQueue_h
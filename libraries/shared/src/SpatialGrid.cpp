@@ -0,0 +1,24 @@
+//
+//  SpatialGrid.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatialGrid.h"
+
+glm::ivec3 SpatialGridBase::cellCoordinates(const glm::vec3& position, float cellSize) {
+    // clamp to the 21 bits per axis of the cell key
+    const float MAX_CELL = (float)((1 << 20) - 1);
+    glm::vec3 coordinates = glm::floor(position / cellSize);
+    return glm::ivec3(glm::clamp(coordinates, glm::vec3(-MAX_CELL), glm::vec3(MAX_CELL)));
+}
+
+SpatialGridBase::CellKey SpatialGridBase::cellKey(const glm::ivec3& coordinates) {
+    const CellKey MASK = (1 << 21) - 1;
+    return ((CellKey)coordinates.x & MASK) | (((CellKey)coordinates.y & MASK) << 21) | (((CellKey)coordinates.z & MASK) << 42);
+}
@@ -0,0 +1,105 @@
+//
+//  SpatialGrid.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatialGrid_h
+#define hifi_SpatialGrid_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class SpatialGridBase {
+public:
+    using CellKey = uint64_t;
+
+    // integer coordinates of the cell containing position, clamped to what fits in a CellKey
+    static glm::ivec3 cellCoordinates(const glm::vec3& position, float cellSize);
+    static CellKey cellKey(const glm::ivec3& coordinates);
+};
+
+// Uniform grid of items with a position, meant to be built once per frame
+// and then read concurrently to find the items near a point.
+template <typename T>
+class SpatialGrid : public SpatialGridBase {
+public:
+    // drop all items, and start a new frame with the given cell size (in meters, 0 disables the grid)
+    void reset(float cellSize);
+
+    void insert(const glm::vec3& position, const T& item);
+
+    bool isEnabled() const { return _cellSize > 0.0f; }
+    float getCellSize() const { return _cellSize; }
+
+    // calls functor for every item in the cells touching the cube around center, candidates may be out of range
+    template <typename F>
+    void forEachCandidate(const glm::vec3& center, float range, F functor) const;
+
+private:
+    using Cell = std::vector<T>;
+
+    float _cellSize { 0.0f };
+    std::unordered_map<CellKey, Cell> _cells;
+};
+
+template <typename T>
+void SpatialGrid<T>::reset(float cellSize) {
+    _cellSize = cellSize;
+
+    // keep the cell storage around, most items stay in the same cells from one frame to the next
+    for (auto it = _cells.begin(); it != _cells.end();) {
+        if (it->second.empty()) {
+            it = _cells.erase(it);
+        } else {
+            it->second.clear();
+            ++it;
+        }
+    }
+}
+
+template <typename T>
+void SpatialGrid<T>::insert(const glm::vec3& position, const T& item) {
+    _cells[cellKey(cellCoordinates(position, _cellSize))].push_back(item);
+}
+
+template <typename T>
+template <typename F>
+void SpatialGrid<T>::forEachCandidate(const glm::vec3& center, float range, F functor) const {
+    glm::ivec3 minCell = cellCoordinates(center - glm::vec3(range), _cellSize);
+    glm::ivec3 maxCell = cellCoordinates(center + glm::vec3(range), _cellSize);
+
+    // a huge range touches every cell, walk the items instead of the empty cells
+    if ((int64_t)(maxCell.x - minCell.x + 1) * (maxCell.y - minCell.y + 1) * (maxCell.z - minCell.z + 1) >
+        (int64_t)_cells.size()) {
+        for (const auto& cell : _cells) {
+            for (const auto& item : cell.second) {
+                functor(item);
+            }
+        }
+        return;
+    }
+
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int z = minCell.z; z <= maxCell.z; ++z) {
+                auto it = _cells.find(cellKey({ x, y, z }));
+                if (it != _cells.end()) {
+                    for (const auto& item : it->second) {
+                        functor(item);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif // hifi_SpatialGrid_h
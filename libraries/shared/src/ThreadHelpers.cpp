@@ -8,6 +8,10 @@
 
 #include "ThreadHelpers.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include <QtCore/QDebug>
 
 // Support for viewing the thread name in the debugger.  
@@ -78,3 +82,17 @@ void moveToNewNamedThread(QObject* object, const QString& name, std::function<vo
 void moveToNewNamedThread(QObject* object, const QString& name, QThread::Priority priority) {
     moveToNewNamedThread(object, name, [](QThread*){}, []{}, priority);
 }
+
+void forEachRangeInParallel(int count, int minPerThread, const std::function<void(int, int)>& function) {
+    int maxThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+    int numThreads = std::min(maxThreads, std::max(count / std::max(minPerThread, 1), 1));
+    int perThread = (count + numThreads - 1) / numThreads;
+    std::vector<std::thread> threads;
+    for (int thread = 1; thread < numThreads; ++thread) {
+        threads.emplace_back(function, thread * perThread, std::min((thread + 1) * perThread, count));
+    }
+    function(0, std::min(perThread, count));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
@@ -32,6 +32,10 @@ void withLock(QMutex& lock, F function) {
     function();
 }
 
+// Runs function(begin, end) over ranges covering [0, count), on as many threads as there are cores, the calling one
+// included, but with at least minPerThread items on each thread to make it worth starting.  Returns once all are done.
+void forEachRangeInParallel(int count, int minPerThread, const std::function<void(int, int)>& function);
+
 void moveToNewNamedThread(QObject* object, const QString& name, 
     std::function<void(QThread*)> preStartCallback, 
     std::function<void()> startCallback, 
@@ -40,6 +40,8 @@ public:
     float getAngle() const { return _angle; }
     float getRadius() const { return _radius; }
     float getFarClip() const { return _farClip; }
+    float getCosAngle() const { return _cosAngle; }
+    float getSinAngle() const { return _sinAngle; }
 
     bool isVerySimilar(const ConicalViewFrustum& other) const;
 
@@ -0,0 +1,173 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <AudioHRTF.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AudioHRTFTests)
+
+const int NUM_FRAMES = HRTF_BLOCK;
+const int HRTF_DATASET_INDEX = 1;
+
+// fill the input of each source with a deterministic pseudo-random block
+static void generateInputs(std::vector<int16_t>& samples, std::vector<int16_t*>& inputs, int numSources, int frame) {
+    samples.resize(numSources * NUM_FRAMES);
+    inputs.resize(numSources);
+
+    uint32_t seed = 1 + frame;
+    for (auto& sample : samples) {
+        seed = seed * 1664525 + 1013904223;
+        sample = (int16_t)(seed >> 16);
+    }
+    for (int i = 0; i < numSources; i++) {
+        inputs[i] = &samples[i * NUM_FRAMES];
+    }
+}
+
+// moving and stationary sources, some of them changing gain
+static void computeParameters(std::vector<float>& azimuths, std::vector<float>& distances, std::vector<float>& gains,
+                              int numSources, int frame) {
+    azimuths.resize(numSources);
+    distances.resize(numSources);
+    gains.resize(numSources);
+
+    for (int i = 0; i < numSources; i++) {
+        bool isMoving = (i % 3 == 0);
+        azimuths[i] = (2.0f * PI) * (float)i / numSources - PI;
+        if (isMoving) {
+            azimuths[i] = fmodf(azimuths[i] + PI + 0.05f * frame, 2.0f * PI) - PI;
+        }
+        distances[i] = 0.5f + 0.25f * i;
+        gains[i] = (i % 5 == 0) ? 0.5f + 0.01f * (frame % 10) : 0.5f;
+    }
+}
+
+void AudioHRTFTests::testBatchMatchesSequential() {
+    const int NUM_SOURCES = 21;     // not a multiple of the batch group size
+    const int NUM_BLOCKS = 50;
+
+    std::vector<AudioHRTF> sequentialHRTFs(NUM_SOURCES);
+    std::vector<AudioHRTF> batchHRTFs(NUM_SOURCES);
+    std::vector<AudioHRTF*> batchPointers;
+    for (auto& hrtf : batchHRTFs) {
+        batchPointers.push_back(&hrtf);
+    }
+
+    std::vector<int16_t> samples;
+    std::vector<int16_t*> inputs;
+    std::vector<float> azimuths, distances, gains;
+
+    for (int frame = 0; frame < NUM_BLOCKS; frame++) {
+        generateInputs(samples, inputs, NUM_SOURCES, frame);
+        computeParameters(azimuths, distances, gains, NUM_SOURCES, frame);
+
+        float sequentialOutput[2 * NUM_FRAMES] = {};
+        float batchOutput[2 * NUM_FRAMES] = {};
+
+        for (int i = 0; i < NUM_SOURCES; i++) {
+            sequentialHRTFs[i].render(inputs[i], sequentialOutput, HRTF_DATASET_INDEX,
+                                      azimuths[i], distances[i], gains[i], NUM_FRAMES);
+        }
+        AudioHRTF::renderBatch(batchPointers.data(), inputs.data(), batchOutput, HRTF_DATASET_INDEX,
+                               azimuths.data(), distances.data(), gains.data(), NUM_SOURCES, NUM_FRAMES);
+
+        // each source is accumulated in the same order, so the result is exact
+        for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+            QCOMPARE(batchOutput[i], sequentialOutput[i]);
+        }
+    }
+}
+
+void AudioHRTFTests::testStationaryMatchesLegacy() {
+    const int NUM_BLOCKS = 50;
+    const float AZIMUTH = 0.7f;
+    const float GAIN = 0.5f;
+
+    // distances below HRTF_NEARFIELD_MIN all give the same filters, so a source alternating between two of them
+    // keeps its filters but never looks stationary, and goes through the old/new FIR_1x4 path every block
+    const float STATIONARY_DISTANCE = 0.05f;
+    const float ALTERNATE_DISTANCE = 0.1f;
+    QVERIFY(ALTERNATE_DISTANCE < HRTF_NEARFIELD_MIN);
+
+    AudioHRTF stationaryHRTF;
+    AudioHRTF legacyHRTF;
+
+    std::vector<int16_t> samples;
+    std::vector<int16_t*> inputs;
+
+    for (int frame = 0; frame < NUM_BLOCKS; frame++) {
+        generateInputs(samples, inputs, 1, frame);
+
+        float stationaryOutput[2 * NUM_FRAMES] = {};
+        float legacyOutput[2 * NUM_FRAMES] = {};
+
+        stationaryHRTF.render(inputs[0], stationaryOutput, HRTF_DATASET_INDEX,
+                              AZIMUTH, STATIONARY_DISTANCE, GAIN, NUM_FRAMES);
+        legacyHRTF.render(inputs[0], legacyOutput, HRTF_DATASET_INDEX,
+                          AZIMUTH, (frame % 2 == 0) ? STATIONARY_DISTANCE : ALTERNATE_DISTANCE, GAIN, NUM_FRAMES);
+
+        // the stationary path skips the old filters, which are the new ones, so the result is exact
+        for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+            QCOMPARE(stationaryOutput[i], legacyOutput[i]);
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+void AudioHRTFTests::benchmark() {
+    const int NUM_BLOCKS = 1000;
+    const int sourceCounts[] = { 1, 8, 32, 128 };
+
+    for (int numSources : sourceCounts) {
+        std::vector<AudioHRTF> hrtfs(numSources);
+        std::vector<AudioHRTF> batchHRTFs(numSources);
+        std::vector<AudioHRTF*> hrtfPointers;
+        for (auto& hrtf : batchHRTFs) {
+            hrtfPointers.push_back(&hrtf);
+        }
+
+        std::vector<int16_t> samples;
+        std::vector<int16_t*> inputs;
+        std::vector<float> azimuths, distances, gains;
+        float output[2 * NUM_FRAMES];
+
+        uint64_t sequentialTime = 0;
+        uint64_t batchTime = 0;
+        for (int frame = 0; frame < NUM_BLOCKS; frame++) {
+            generateInputs(samples, inputs, numSources, frame);
+            computeParameters(azimuths, distances, gains, numSources, frame);
+
+            memset(output, 0, sizeof(output));
+            uint64_t start = usecTimestampNow();
+            for (int i = 0; i < numSources; i++) {
+                hrtfs[i].render(inputs[i], output, HRTF_DATASET_INDEX, azimuths[i], distances[i], gains[i], NUM_FRAMES);
+            }
+            uint64_t middle = usecTimestampNow();
+            AudioHRTF::renderBatch(hrtfPointers.data(), inputs.data(), output, HRTF_DATASET_INDEX,
+                                   azimuths.data(), distances.data(), gains.data(), numSources, NUM_FRAMES);
+            uint64_t end = usecTimestampNow();
+
+            sequentialTime += middle - start;
+            batchTime += end - middle;
+        }
+
+        qDebug() << "sources =" << numSources
+                 << "sequential usec/listener =" << (float)sequentialTime / NUM_BLOCKS
+                 << "batch usec/listener =" << (float)batchTime / NUM_BLOCKS;
+    }
+}
+#endif // MANUAL_TEST
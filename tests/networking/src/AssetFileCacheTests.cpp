@@ -0,0 +1,162 @@
+//
+//  AssetFileCacheTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCacheTests.h"
+
+#include <QTemporaryDir>
+
+#include <AssetFileCache.h>
+
+QTEST_MAIN(AssetFileCacheTests)
+
+const qint64 FILE_SIZE = 100;
+
+static void writeAsset(const QTemporaryDir& directory, const QString& hash, char content, qint64 size = FILE_SIZE) {
+    QFile file(directory.filePath(hash));
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(QByteArray(size, content)), size);
+}
+
+static QByteArray getContent(const MappedAssetFilePointer& file) {
+    return QByteArray(file->getData(), file->getSize());
+}
+
+void AssetFileCacheTests::reuseTest() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeAsset(directory, "a", 'a');
+
+    AssetFileCache cache(10 * FILE_SIZE);
+    cache.setFilesDirectory(QDir(directory.path()));
+
+    auto file = cache.getFile("a");
+    QVERIFY(file);
+    QCOMPARE(getContent(file), QByteArray(FILE_SIZE, 'a'));
+
+    // the tasks sending the same asset share its mapping
+    QCOMPARE(cache.getFile("a"), file);
+
+    // and it stays mapped in the cache once they are done
+    const MappedAssetFile* mappedFile = file.get();
+    file.reset();
+    QCOMPARE(cache._size, FILE_SIZE);
+    QCOMPARE(cache._files.value("a").cachedFile.get(), mappedFile);
+    QCOMPARE(cache.getFile("a").get(), mappedFile);
+}
+
+void AssetFileCacheTests::evictionTest() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    for (auto hash : { "a", "b", "c", "d" }) {
+        writeAsset(directory, hash, hash[0]);
+    }
+
+    AssetFileCache cache(3 * FILE_SIZE);
+    cache.setFilesDirectory(QDir(directory.path()));
+
+    QVERIFY(cache.getFile("a"));
+    QVERIFY(cache.getFile("b"));
+    QVERIFY(cache.getFile("c"));
+    QCOMPARE(cache._size, 3 * FILE_SIZE);
+
+    // the least recently used file makes room for the new one
+    QVERIFY(cache.getFile("a"));
+    QVERIFY(cache.getFile("d"));
+    QCOMPARE(cache._size, 3 * FILE_SIZE);
+    QVERIFY(!cache._files.contains("b"));
+    QVERIFY(cache._files.contains("a"));
+    QVERIFY(cache._files.contains("c"));
+    QVERIFY(cache._files.contains("d"));
+    QCOMPARE(cache._leastRecentlyUsed, std::list<AssetUtils::AssetHash>({ "d", "a", "c" }));
+
+    // a file evicted while it is being sent stays mapped until it is released
+    auto file = cache.getFile("c");
+    QVERIFY(cache.getFile("d"));
+    cache.setMaxSize(FILE_SIZE);
+    QCOMPARE(cache._size, FILE_SIZE);
+    QCOMPARE(cache._files.size(), 2);
+    QVERIFY(cache._files.contains("c"));
+    QVERIFY(!cache._files.value("c").cachedFile);
+    QCOMPARE(cache.getFile("c"), file);
+    QCOMPARE(getContent(file), QByteArray(FILE_SIZE, 'c'));
+
+    file.reset();
+    QCOMPARE(cache._files.size(), 1);
+    QVERIFY(cache._files.contains("d"));
+}
+
+void AssetFileCacheTests::uncachedTest() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeAsset(directory, "big", 'b', 2 * FILE_SIZE);
+
+    AssetFileCache cache(FILE_SIZE);
+    cache.setFilesDirectory(QDir(directory.path()));
+
+    // too big to be cached, but still shared while it is being sent
+    auto file = cache.getFile("big");
+    QVERIFY(file);
+    QCOMPARE(cache._size, (qint64)0);
+    QVERIFY(cache._leastRecentlyUsed.empty());
+    QCOMPARE(cache.getFile("big"), file);
+
+    // nothing is left behind once it is released
+    file.reset();
+    QVERIFY(cache._files.isEmpty());
+}
+
+void AssetFileCacheTests::changedFileTest() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeAsset(directory, "a", '1');
+
+    AssetFileCache cache(10 * FILE_SIZE);
+    cache.setFilesDirectory(QDir(directory.path()));
+
+    auto oldFile = cache.getFile("a");
+    QCOMPARE(getContent(oldFile), QByteArray(FILE_SIZE, '1'));
+
+    // the asset server forgets about a file before deleting it, a new file with that name is mapped again
+    cache.removeFile("a");
+    QVERIFY(QFile::remove(directory.filePath("a")));
+    writeAsset(directory, "a", '2', 2 * FILE_SIZE);
+
+    auto newFile = cache.getFile("a");
+    QVERIFY(newFile);
+    QVERIFY(newFile != oldFile);
+    QCOMPARE(getContent(newFile), QByteArray(2 * FILE_SIZE, '2'));
+    QCOMPARE(cache._size, 2 * FILE_SIZE);
+
+    // the tasks still sending the old file keep reading it
+    QCOMPARE(getContent(oldFile), QByteArray(FILE_SIZE, '1'));
+
+    // releasing it doesn't drop the new one
+    oldFile.reset();
+    QCOMPARE(cache._files.value("a").cachedFile, newFile);
+    QCOMPARE(cache.getFile("a"), newFile);
+}
+
+void AssetFileCacheTests::missingFileTest() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    AssetFileCache cache(10 * FILE_SIZE);
+    cache.setFilesDirectory(QDir(directory.path()));
+
+    QVERIFY(!cache.getFile("missing"));
+    QVERIFY(cache._files.isEmpty());
+
+    // an empty file has nothing to map, but it is still an asset
+    writeAsset(directory, "empty", 'e', 0);
+    auto file = cache.getFile("empty");
+    QVERIFY(file);
+    QCOMPARE(file->getSize(), (qint64)0);
+}
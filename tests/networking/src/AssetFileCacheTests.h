@@ -0,0 +1,27 @@
+//
+//  AssetFileCacheTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCacheTests_h
+#define hifi_AssetFileCacheTests_h
+
+#include <QtTest/QtTest>
+
+class AssetFileCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void reuseTest();
+    void evictionTest();
+    void uncachedTest();
+    void changedFileTest();
+    void missingFileTest();
+};
+
+#endif // hifi_AssetFileCacheTests_h
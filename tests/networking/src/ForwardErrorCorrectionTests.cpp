@@ -0,0 +1,176 @@
+//
+//  ForwardErrorCorrectionTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ForwardErrorCorrectionTests.h"
+
+#include <cstring>
+#include <vector>
+
+#include <udt/ForwardErrorCorrection.h>
+
+QTEST_MAIN(ForwardErrorCorrectionTests)
+
+using namespace udt;
+
+static const int GROUP_SIZE = 4;
+static const std::vector<int> PAYLOAD_SIZES { 100, 300, 50, 1000 };
+
+static std::unique_ptr<Packet> createPacket(SequenceNumber sequenceNumber, int payloadSize) {
+    auto packet = Packet::create(payloadSize);
+    for (int i = 0; i < payloadSize; ++i) {
+        packet->writePrimitive((char)(i + (SequenceNumber::Type)sequenceNumber));
+    }
+    packet->writeSequenceNumber(sequenceNumber);
+    return packet;
+}
+
+// the parity packet as the receiving end reads it
+static std::unique_ptr<ControlPacket> receiveControlPacket(const ControlPacket& controlPacket) {
+    auto data = std::unique_ptr<char[]>(new char[controlPacket.getDataSize()]);
+    std::memcpy(data.get(), controlPacket.getData(), controlPacket.getDataSize());
+    return ControlPacket::fromReceivedPacket(std::move(data), controlPacket.getDataSize(), HifiSockAddr());
+}
+
+static QByteArray datagram(const Packet& packet) {
+    return QByteArray(packet.getData(), packet.getDataSize());
+}
+
+// sends a group of packets, returns them and the parity packet sent after the last one
+static std::unique_ptr<ControlPacket> sendGroup(FECEncoder& encoder, SequenceNumber firstSequenceNumber,
+                                                std::vector<std::unique_ptr<Packet>>& packets) {
+    std::unique_ptr<ControlPacket> parityPacket;
+    for (int i = 0; i < GROUP_SIZE; ++i) {
+        packets.push_back(createPacket(firstSequenceNumber + i, PAYLOAD_SIZES[i]));
+        parityPacket = encoder.addPacket(*packets.back());
+    }
+    return parityPacket ? receiveControlPacket(*parityPacket) : nullptr;
+}
+
+void ForwardErrorCorrectionTests::canProtectTest() {
+    QVERIFY(FECEncoder::canProtect(*Packet::create(100)));
+    QVERIFY(!FECEncoder::canProtect(*Packet::create(100, true)));
+    QVERIFY(!FECEncoder::canProtect(*Packet::create(100, false, true)));
+
+    // no room left for the parity header
+    auto fullPacket = Packet::create();
+    QByteArray payload(Packet::maxPayloadSize(), 'x');
+    fullPacket->write(payload);
+    QVERIFY(!FECEncoder::canProtect(*fullPacket));
+}
+
+void ForwardErrorCorrectionTests::recoverTest() {
+    FECEncoder encoder(GROUP_SIZE);
+
+    // lose each packet of a group in turn
+    for (int lostIndex = 0; lostIndex < GROUP_SIZE; ++lostIndex) {
+        FECDecoder decoder;
+        std::vector<std::unique_ptr<Packet>> packets;
+        auto parityPacket = sendGroup(encoder, SequenceNumber(1 + lostIndex * GROUP_SIZE), packets);
+        QVERIFY(parityPacket);
+
+        for (int i = 0; i < GROUP_SIZE; ++i) {
+            if (i != lostIndex) {
+                QVERIFY(decoder.addPacket(*packets[i]));
+            }
+        }
+
+        auto recoveredPacket = decoder.recoverPacket(*parityPacket);
+        QVERIFY(recoveredPacket);
+        QCOMPARE(recoveredPacket->getSequenceNumber(), packets[lostIndex]->getSequenceNumber());
+        QCOMPARE(datagram(*recoveredPacket), datagram(*packets[lostIndex]));
+    }
+}
+
+void ForwardErrorCorrectionTests::noRecoveryTest() {
+    FECEncoder encoder(GROUP_SIZE);
+    std::vector<std::unique_ptr<Packet>> packets;
+
+    // nothing lost
+    FECDecoder decoder;
+    auto parityPacket = sendGroup(encoder, SequenceNumber(1), packets);
+    for (auto& packet : packets) {
+        decoder.addPacket(*packet);
+    }
+    QVERIFY(!decoder.recoverPacket(*parityPacket));
+
+    // more lost than XOR can rebuild
+    FECDecoder otherDecoder;
+    packets.clear();
+    parityPacket = sendGroup(encoder, SequenceNumber(1 + GROUP_SIZE), packets);
+    otherDecoder.addPacket(*packets[0]);
+    otherDecoder.addPacket(*packets[1]);
+    QVERIFY(!otherDecoder.recoverPacket(*parityPacket));
+}
+
+void ForwardErrorCorrectionTests::duplicateTest() {
+    FECEncoder encoder(GROUP_SIZE);
+    FECDecoder decoder;
+    std::vector<std::unique_ptr<Packet>> packets;
+
+    auto parityPacket = sendGroup(encoder, SequenceNumber(1), packets);
+    for (int i = 1; i < GROUP_SIZE; ++i) {
+        QVERIFY(decoder.addPacket(*packets[i]));
+        QVERIFY(!decoder.addPacket(*packets[i]));
+    }
+
+    // the Socket hands the recovered packet to the decoder like any other
+    auto recoveredPacket = decoder.recoverPacket(*parityPacket);
+    QVERIFY(recoveredPacket);
+    QVERIFY(decoder.addPacket(*recoveredPacket));
+
+    // so that the lost packet is dropped if it comes in late after all
+    QVERIFY(!decoder.addPacket(*packets[0]));
+}
+
+void ForwardErrorCorrectionTests::groupSpanTest() {
+    FECEncoder encoder(GROUP_SIZE);
+    FECDecoder decoder;
+
+    auto firstPacket = createPacket(SequenceNumber(1), 100);
+    QVERIFY(!encoder.addPacket(*firstPacket));
+
+    // too far from the start of the group, it closes the group instead
+    auto farPacket = createPacket(SequenceNumber(1 + FEC_MAX_GROUP_SPAN), 100);
+    auto parityPacket = encoder.addPacket(*farPacket);
+    QVERIFY(parityPacket);
+
+    // the group only has the first packet, so its parity is enough to rebuild it
+    auto recoveredPacket = decoder.recoverPacket(*receiveControlPacket(*parityPacket));
+    QVERIFY(recoveredPacket);
+    QCOMPARE(datagram(*recoveredPacket), datagram(*firstPacket));
+}
+
+void ForwardErrorCorrectionTests::parityRequestTest() {
+    using namespace std::chrono;
+
+    FECEncoder encoder(GROUP_SIZE);
+    FECDecoder decoder;
+    auto now = p_high_resolution_clock::now();
+
+    QVERIFY(decoder.shouldRequestParity(now));
+    QVERIFY(!decoder.shouldRequestParity(now + milliseconds(500)));
+    QVERIFY(decoder.shouldRequestParity(now + seconds(1)));
+    QVERIFY(decoder.shouldRequestParity(now + seconds(2)));
+
+    // a peer that never answers is not asked forever
+    QVERIFY(!decoder.shouldRequestParity(now + seconds(3)));
+    QVERIFY(!decoder.shouldRequestParity(now + seconds(10)));
+
+    // until it sends parity packets after all
+    std::vector<std::unique_ptr<Packet>> packets;
+    auto parityPacket = sendGroup(encoder, SequenceNumber(1), packets);
+    QVERIFY(parityPacket);
+    parityPacket->setReceiveTime(now + seconds(10));
+    decoder.recoverPacket(*parityPacket);
+
+    QVERIFY(!decoder.shouldRequestParity(now + seconds(10)));
+    QVERIFY(decoder.shouldRequestParity(now + seconds(11)));
+}
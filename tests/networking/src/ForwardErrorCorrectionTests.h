@@ -0,0 +1,30 @@
+//
+//  ForwardErrorCorrectionTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ForwardErrorCorrectionTests_h
+#define hifi_ForwardErrorCorrectionTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ForwardErrorCorrectionTests : public QObject {
+    Q_OBJECT
+private slots:
+    void canProtectTest();
+    void recoverTest();
+    void noRecoveryTest();
+    void duplicateTest();
+    void groupSpanTest();
+    void parityRequestTest();
+};
+
+#endif // hifi_ForwardErrorCorrectionTests_h
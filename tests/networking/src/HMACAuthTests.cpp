@@ -0,0 +1,90 @@
+//
+//  HMACAuthTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HMACAuthTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <HMACAuth.h>
+
+QTEST_MAIN(HMACAuthTests)
+
+static QByteArray hashData(const HMACAuth& hmacAuth, const QByteArray& data) {
+    HMACAuth::HMACHash hash;
+    if (!hmacAuth.calculateHash(hash, data.constData(), data.size())) {
+        return QByteArray();
+    }
+    return QByteArray((const char*)hash.data(), (int)hash.size());
+}
+
+void HMACAuthTests::knownHashTest() {
+    HMACAuth hmacAuth;
+    QByteArray key = "Jefe";
+    QVERIFY(hmacAuth.setKey(key.constData(), key.size()));
+    QCOMPARE(hashData(hmacAuth, "what do ya want for nothing?").toHex(), QByteArray("750c783e6ab0b503eaa86e310a5db738"));
+
+    // the key is kept from one hash to the next
+    QCOMPARE(hashData(hmacAuth, "what do ya want for nothing?").toHex(), QByteArray("750c783e6ab0b503eaa86e310a5db738"));
+
+    QByteArray longKey(16, (char)0x0b);
+    QVERIFY(hmacAuth.setKey(longKey.constData(), longKey.size()));
+    QCOMPARE(hashData(hmacAuth, "Hi There").toHex(), QByteArray("9294727a3638bb1c13f48ef8158bfc9d"));
+}
+
+void HMACAuthTests::setKeyTest() {
+    HMACAuth hmacAuth;
+    QByteArray data = "some packet payload";
+    QCOMPARE(hashData(hmacAuth, data), QByteArray());
+
+    QUuid firstKey = QUuid::createUuid();
+    QVERIFY(hmacAuth.setKey(firstKey));
+    QByteArray firstHash = hashData(hmacAuth, data);
+    QCOMPARE(firstHash.size(), 16);
+
+    QVERIFY(hmacAuth.setKey(QUuid::createUuid()));
+    QVERIFY(hashData(hmacAuth, data) != firstHash);
+
+    QVERIFY(hmacAuth.setKey(firstKey));
+    QCOMPARE(hashData(hmacAuth, data), firstHash);
+}
+
+void HMACAuthTests::concurrentHashTest() {
+    const int NUM_THREADS = 8;
+    const int NUM_HASHES_PER_THREAD = 10000;
+
+    HMACAuth hmacAuth;
+    QVERIFY(hmacAuth.setKey(QUuid::createUuid()));
+
+    // a second key, hashed on the same threads, must not disturb the first
+    HMACAuth otherHMACAuth;
+    QVERIFY(otherHMACAuth.setKey(QUuid::createUuid()));
+
+    QByteArray data(1200, 'x');
+    QByteArray expectedHash = hashData(hmacAuth, data);
+    QByteArray otherExpectedHash = hashData(otherHMACAuth, data);
+
+    std::atomic<int> numMismatches { 0 };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < NUM_HASHES_PER_THREAD; ++j) {
+                if (hashData(hmacAuth, data) != expectedHash || hashData(otherHMACAuth, data) != otherExpectedHash) {
+                    ++numMismatches;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    QCOMPARE(numMismatches.load(), 0);
+}
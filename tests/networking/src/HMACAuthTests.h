@@ -0,0 +1,32 @@
+//
+//  HMACAuthTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HMACAuthTests_h
+#define hifi_HMACAuthTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class HMACAuthTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test against the HMAC-MD5 test vectors of RFC 2202
+    void knownHashTest();
+
+    // Test that a new key replaces the previous one
+    void setKeyTest();
+
+    // Test hashing with the same key from several threads at once
+    void concurrentHashTest();
+};
+
+#endif // hifi_HMACAuthTests_h
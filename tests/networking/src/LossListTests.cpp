@@ -0,0 +1,162 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <vector>
+
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+static const int NUM_IN_FLIGHT = 10000;
+static const int LOSS_INTERVAL = 10;
+
+// pops every sequence number out of a copy of the list
+static std::vector<SequenceNumber::Type> toVector(LossList lossList) {
+    std::vector<SequenceNumber::Type> sequenceNumbers;
+    while (!lossList.isEmpty()) {
+        sequenceNumbers.push_back((SequenceNumber::Type)lossList.popFirstSequenceNumber());
+    }
+    return sequenceNumbers;
+}
+
+void LossListTests::appendTest() {
+    LossList lossList;
+    QVERIFY(lossList.isEmpty());
+
+    lossList.append(SequenceNumber(1));
+    lossList.append(SequenceNumber(2));
+    lossList.append(SequenceNumber(5), SequenceNumber(7));
+
+    QCOMPARE(lossList.getLength(), 5);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(1));
+    QCOMPARE(toVector(lossList), std::vector<SequenceNumber::Type>({ 1, 2, 5, 6, 7 }));
+}
+
+void LossListTests::insertTest() {
+    LossList lossList;
+    lossList.append(SequenceNumber(10), SequenceNumber(12));
+    lossList.append(SequenceNumber(20), SequenceNumber(22));
+
+    // before, between and overlapping ranges
+    lossList.insert(SequenceNumber(1), SequenceNumber(1));
+    lossList.insert(SequenceNumber(15), SequenceNumber(15));
+    lossList.insert(SequenceNumber(11), SequenceNumber(13));
+    QCOMPARE(toVector(lossList), std::vector<SequenceNumber::Type>({ 1, 10, 11, 12, 13, 15, 20, 21, 22 }));
+    QCOMPARE(lossList.getLength(), 9);
+
+    // merging every range together
+    lossList.insert(SequenceNumber(2), SequenceNumber(19));
+    QCOMPARE(lossList.getLength(), 22);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(1));
+    QCOMPARE(toVector(lossList).back(), 22);
+}
+
+void LossListTests::removeTest() {
+    LossList lossList;
+    lossList.append(SequenceNumber(1), SequenceNumber(5));
+    lossList.append(SequenceNumber(8));
+
+    QVERIFY(!lossList.remove(SequenceNumber(6)));
+    QVERIFY(!lossList.remove(SequenceNumber(9)));
+
+    QVERIFY(lossList.remove(SequenceNumber(3)));
+    QVERIFY(lossList.remove(SequenceNumber(1)));
+    QVERIFY(lossList.remove(SequenceNumber(8)));
+    QVERIFY(!lossList.remove(SequenceNumber(3)));
+
+    QCOMPARE(lossList.getLength(), 3);
+    QCOMPARE(toVector(lossList), std::vector<SequenceNumber::Type>({ 2, 4, 5 }));
+}
+
+void LossListTests::removeRangeTest() {
+    LossList lossList;
+    lossList.append(SequenceNumber(1), SequenceNumber(5));
+    lossList.append(SequenceNumber(10), SequenceNumber(15));
+    lossList.append(SequenceNumber(20), SequenceNumber(25));
+
+    // nothing to remove
+    lossList.remove(SequenceNumber(6), SequenceNumber(9));
+    QCOMPARE(lossList.getLength(), 17);
+
+    // cut a range in half
+    lossList.remove(SequenceNumber(12), SequenceNumber(13));
+    QCOMPARE(toVector(lossList), std::vector<SequenceNumber::Type>({ 1, 2, 3, 4, 5, 10, 11, 14, 15, 20, 21, 22, 23, 24, 25 }));
+
+    // across several ranges
+    lossList.remove(SequenceNumber(4), SequenceNumber(21));
+    QCOMPARE(toVector(lossList), std::vector<SequenceNumber::Type>({ 1, 2, 3, 22, 23, 24, 25 }));
+    QCOMPARE(lossList.getLength(), 7);
+
+    // as an ACK does
+    lossList.remove(lossList.getFirstSequenceNumber(), SequenceNumber(30));
+    QVERIFY(lossList.isEmpty());
+}
+
+void LossListTests::rolloverTest() {
+    LossList lossList;
+    lossList.append(SequenceNumber(SequenceNumber::MAX - 1), SequenceNumber(SequenceNumber::MAX));
+    lossList.append(SequenceNumber(1), SequenceNumber(2));
+
+    lossList.insert(SequenceNumber(0), SequenceNumber(0));
+    QCOMPARE(lossList.getLength(), 5);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(SequenceNumber::MAX - 1));
+
+    QVERIFY(lossList.remove(SequenceNumber(1)));
+    QCOMPARE(toVector(lossList), std::vector<SequenceNumber::Type>({ SequenceNumber::MAX - 1, SequenceNumber::MAX, 0, 2 }));
+}
+
+void LossListTests::receiverLossBenchmark() {
+    QBENCHMARK {
+        LossList lossList;
+        for (int i = LOSS_INTERVAL; i < NUM_IN_FLIGHT; i += LOSS_INTERVAL) {
+            lossList.append(SequenceNumber(i));
+        }
+
+        // the re-sent packets don't necessarily come in order
+        for (int i = LOSS_INTERVAL; i < NUM_IN_FLIGHT; i += 2 * LOSS_INTERVAL) {
+            lossList.remove(SequenceNumber(NUM_IN_FLIGHT - i));
+            lossList.remove(SequenceNumber(i));
+        }
+    }
+}
+
+void LossListTests::senderNAKBenchmark() {
+    QBENCHMARK {
+        LossList lossList;
+        for (int i = LOSS_INTERVAL; i < NUM_IN_FLIGHT / 2; i += LOSS_INTERVAL) {
+            lossList.insert(SequenceNumber(NUM_IN_FLIGHT - i), SequenceNumber(NUM_IN_FLIGHT - i));
+            lossList.insert(SequenceNumber(i), SequenceNumber(i));
+        }
+
+        while (!lossList.isEmpty()) {
+            lossList.popFirstSequenceNumber();
+        }
+    }
+}
+
+void LossListTests::senderACKBenchmark() {
+    QBENCHMARK {
+        LossList lossList;
+        for (int i = LOSS_INTERVAL; i < NUM_IN_FLIGHT; i += LOSS_INTERVAL) {
+            lossList.append(SequenceNumber(i));
+        }
+
+        for (int i = 0; i < NUM_IN_FLIGHT && !lossList.isEmpty(); ++i) {
+            if (lossList.getFirstSequenceNumber() <= SequenceNumber(i)) {
+                lossList.remove(lossList.getFirstSequenceNumber(), SequenceNumber(i));
+            }
+        }
+    }
+}
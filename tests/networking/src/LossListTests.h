@@ -0,0 +1,34 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    void appendTest();
+    void insertTest();
+    void removeTest();
+    void removeRangeTest();
+    void rolloverTest();
+
+    // Benchmarks with 10k packets in flight and every 10th one lost
+    void receiverLossBenchmark(); // losses detected, then removed as the re-sent packets come in
+    void senderNAKBenchmark(); // fast re-transmits inserted out of order, then popped for re-sending
+    void senderACKBenchmark(); // losses cleaned up by increasing ACKs
+};
+
+#endif // hifi_LossListTests_h
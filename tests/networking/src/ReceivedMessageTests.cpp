@@ -0,0 +1,167 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <cstring>
+#include <vector>
+
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+static const std::vector<int> PAYLOAD_SIZES { 100, 200, 50 };
+
+static QByteArray createPayload(int size, char first) {
+    QByteArray payload(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        payload[i] = (char)(first + i);
+    }
+    return payload;
+}
+
+// a packet of a message as it comes in from the network
+static std::unique_ptr<NLPacket> createReceivedPacket(const QByteArray& payload, udt::Packet::PacketPosition position,
+                                                      udt::Packet::MessagePartNumber messagePartNumber) {
+    auto packet = NLPacket::create(PacketType::AssetGetReply, -1, true, true);
+    packet->write(payload);
+    packet->writeMessageNumber(1, position, messagePartNumber);
+
+    auto size = packet->getDataSize();
+    auto data = std::unique_ptr<char[]>(new char[size]);
+    memcpy(data.get(), packet->getData(), size);
+    return NLPacket::fromReceivedPacket(std::move(data), size, HifiSockAddr());
+}
+
+// the message and its payloads, received in as many packets
+static QSharedPointer<ReceivedMessage> createMessage(std::vector<QByteArray>& payloads) {
+    QSharedPointer<ReceivedMessage> message;
+
+    for (size_t i = 0; i < PAYLOAD_SIZES.size(); ++i) {
+        payloads.push_back(createPayload(PAYLOAD_SIZES[i], (char)(i * 64)));
+
+        auto position = i == 0 ? udt::Packet::FIRST : (i + 1 == PAYLOAD_SIZES.size() ? udt::Packet::LAST : udt::Packet::MIDDLE);
+        auto packet = createReceivedPacket(payloads.back(), position, (udt::Packet::MessagePartNumber)i);
+
+        if (!message) {
+            message = QSharedPointer<ReceivedMessage>::create(*packet);
+        } else {
+            message->appendPacket(std::move(packet));
+        }
+    }
+
+    return message;
+}
+
+static QByteArray join(const std::vector<QByteArray>& payloads) {
+    QByteArray data;
+    for (const auto& payload : payloads) {
+        data.append(payload);
+    }
+    return data;
+}
+
+void ReceivedMessageTests::segmentsTest() {
+    std::vector<QByteArray> payloads;
+    auto message = createMessage(payloads);
+
+    QVERIFY(message->isComplete());
+    QCOMPARE(message->getNumPackets(), (qint64)PAYLOAD_SIZES.size());
+    QCOMPARE(message->getSize(), (qint64)join(payloads).size());
+
+    auto segments = message->getSegments();
+    QCOMPARE(segments.size(), payloads.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        QCOMPARE(segments[i], payloads[i]);
+    }
+}
+
+void ReceivedMessageTests::readAcrossSegmentsTest() {
+    std::vector<QByteArray> payloads;
+    auto message = createMessage(payloads);
+    auto data = join(payloads);
+
+    // odd sized reads, so that some of them straddle two segments
+    static const int READ_SIZE = 7;
+    QByteArray readData;
+    while (message->getBytesLeftToRead() > 0) {
+        char buffer[READ_SIZE];
+        auto bytesRead = message->read(buffer, READ_SIZE);
+        QVERIFY(bytesRead > 0);
+        readData.append(buffer, bytesRead);
+    }
+    QCOMPARE(readData, data);
+
+    message->seek(PAYLOAD_SIZES[0] - 3);
+    QCOMPARE(message->peek(10), data.mid(PAYLOAD_SIZES[0] - 3, 10));
+    QCOMPARE(message->readAll(), data.mid(PAYLOAD_SIZES[0] - 3));
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+
+    // reads past the end stop at the end of the message
+    message->seek(data.size() - 2);
+    QCOMPARE(message->read(5), data.right(2));
+}
+
+void ReceivedMessageTests::readWithoutCopyTest() {
+    std::vector<QByteArray> payloads;
+    auto message = createMessage(payloads);
+    auto data = join(payloads);
+
+    // within the second segment, it references the packet
+    message->seek(PAYLOAD_SIZES[0] + 10);
+    QCOMPARE(message->readWithoutCopy(20), data.mid(PAYLOAD_SIZES[0] + 10, 20));
+    QCOMPARE(message->getSegments().size(), payloads.size());
+
+    // across segments, it is a copy and the segments are left alone
+    message->seek(PAYLOAD_SIZES[0] - 10);
+    QCOMPARE(message->readWithoutCopy(20), data.mid(PAYLOAD_SIZES[0] - 10, 20));
+    QCOMPARE(message->getPosition(), (qint64)PAYLOAD_SIZES[0] + 10);
+    QCOMPARE(message->getSegments().size(), payloads.size());
+}
+
+void ReceivedMessageTests::readWithoutCopyLifetimeTest() {
+    std::vector<QByteArray> payloads;
+    auto message = createMessage(payloads);
+    auto data = join(payloads);
+
+    auto firstView = message->readWithoutCopy(20);
+    message->seek(PAYLOAD_SIZES[0] + 10);
+    auto secondView = message->readWithoutCopy(20);
+    const char* firstViewData = firstView.constData();
+    const char* secondViewData = secondView.constData();
+
+    // neither a read across segments nor flattening the message moves the data the views reference
+    message->seek(PAYLOAD_SIZES[0] + PAYLOAD_SIZES[1] - 5);
+    QCOMPARE(message->readWithoutCopy(10), data.mid(PAYLOAD_SIZES[0] + PAYLOAD_SIZES[1] - 5, 10));
+    QCOMPARE(message->getMessage(), data);
+    QVERIFY(memcmp(message->getRawMessage(), data.constData(), data.size()) == 0);
+
+    QVERIFY(memcmp(firstViewData, data.constData(), 20) == 0);
+    QVERIFY(memcmp(secondViewData, data.constData() + PAYLOAD_SIZES[0] + 10, 20) == 0);
+    QCOMPARE(firstView, data.mid(0, 20));
+    QCOMPARE(secondView, data.mid(PAYLOAD_SIZES[0] + 10, 20));
+}
+
+void ReceivedMessageTests::flattenTest() {
+    std::vector<QByteArray> payloads;
+    auto message = createMessage(payloads);
+    auto data = join(payloads);
+
+    QCOMPARE(message->getMessage(), data);
+    QVERIFY(memcmp(message->getRawMessage(), data.constData(), data.size()) == 0);
+
+    auto segments = message->getSegments();
+    QCOMPARE(segments.size(), payloads.size());
+    QCOMPARE(join(segments), data);
+
+    message->seek(0);
+    QCOMPARE(message->readAll(), data);
+}
@@ -0,0 +1,29 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    void segmentsTest();
+    void readAcrossSegmentsTest();
+    void readWithoutCopyTest();
+    void readWithoutCopyLifetimeTest();
+    void flattenTest();
+};
+
+#endif // hifi_ReceivedMessageTests_h
@@ -0,0 +1,174 @@
+//
+//  SentPacketWindowTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindowTests.h"
+
+#include <vector>
+
+#include <udt/LossList.h>
+#include <udt/SentPacketWindow.h>
+
+QTEST_MAIN(SentPacketWindowTests)
+
+using namespace udt;
+
+static const int NUM_IN_FLIGHT = 10000;
+static const int RESEND_INTERVAL = 10;
+
+void SentPacketWindowTests::addFindTest() {
+    SentPacketWindow window;
+    QVERIFY(window.isEmpty());
+    QVERIFY(!window.find(SequenceNumber(1)));
+
+    auto packet = Packet::create();
+    auto packetPointer = packet.get();
+    window.add(SequenceNumber(1), std::move(packet));
+    window.add(SequenceNumber(2), Packet::create());
+    // 3 and 4 are skipped
+    window.add(SequenceNumber(5), Packet::create());
+
+    QCOMPARE(window.getLength(), 5);
+    QVERIFY(window.find(SequenceNumber(1)));
+    QCOMPARE(window.find(SequenceNumber(1))->packet.get(), packetPointer);
+    QCOMPARE((int)window.find(SequenceNumber(1))->numResends, 0);
+    QVERIFY(window.find(SequenceNumber(2)));
+    QVERIFY(!window.find(SequenceNumber(3)));
+    QVERIFY(!window.find(SequenceNumber(4)));
+    QVERIFY(window.find(SequenceNumber(5)));
+    QVERIFY(!window.find(SequenceNumber(0)));
+    QVERIFY(!window.find(SequenceNumber(6)));
+
+    ++window.find(SequenceNumber(2))->numResends;
+    QCOMPARE((int)window.find(SequenceNumber(2))->numResends, 1);
+}
+
+void SentPacketWindowTests::removeUpToTest() {
+    SentPacketWindow window;
+    for (int i = 1; i <= 10; ++i) {
+        window.add(SequenceNumber(i), Packet::create());
+    }
+
+    // before the window
+    window.removeUpTo(SequenceNumber(0));
+    QCOMPARE(window.getLength(), 10);
+
+    window.removeUpTo(SequenceNumber(4));
+    QCOMPARE(window.getLength(), 6);
+    QVERIFY(!window.find(SequenceNumber(4)));
+    QVERIFY(window.find(SequenceNumber(5)));
+
+    // a late ACK
+    window.removeUpTo(SequenceNumber(2));
+    QCOMPARE(window.getLength(), 6);
+
+    // past the window
+    window.removeUpTo(SequenceNumber(20));
+    QVERIFY(window.isEmpty());
+    QVERIFY(!window.find(SequenceNumber(10)));
+
+    // the window starts over from the next packet added
+    window.add(SequenceNumber(30), Packet::create());
+    QCOMPARE(window.getLength(), 1);
+    QVERIFY(window.find(SequenceNumber(30)));
+
+    window.clear();
+    QVERIFY(window.isEmpty());
+    QVERIFY(!window.find(SequenceNumber(30)));
+}
+
+void SentPacketWindowTests::growthTest() {
+    SentPacketWindow window;
+
+    // ACK part of the window so that it wraps around its buffer before it grows
+    for (int i = 0; i < 50; ++i) {
+        window.add(SequenceNumber(i), Packet::create());
+    }
+    window.removeUpTo(SequenceNumber(39));
+    for (int i = 50; i < 1000; ++i) {
+        window.add(SequenceNumber(i), Packet::create());
+    }
+
+    QCOMPARE(window.getLength(), 960);
+    for (int i = 40; i < 1000; ++i) {
+        QVERIFY(window.find(SequenceNumber(i)));
+    }
+    QVERIFY(!window.find(SequenceNumber(39)));
+}
+
+void SentPacketWindowTests::rolloverTest() {
+    SentPacketWindow window;
+    for (int i = 0; i < 10; ++i) {
+        window.add(SequenceNumber(SequenceNumber::MAX - 5) + i, Packet::create());
+    }
+
+    QCOMPARE(window.getLength(), 10);
+    QVERIFY(window.find(SequenceNumber(SequenceNumber::MAX)));
+    QVERIFY(window.find(SequenceNumber(0)));
+    QVERIFY(window.find(SequenceNumber(3)));
+
+    window.removeUpTo(SequenceNumber(1));
+    QCOMPARE(window.getLength(), 2);
+    QVERIFY(!window.find(SequenceNumber(SequenceNumber::MAX)));
+    QVERIFY(window.find(SequenceNumber(2)));
+}
+
+void SentPacketWindowTests::ackBenchmark() {
+    SentPacketWindow window;
+    SequenceNumber firstSequenceNumber;
+
+    // the same packets go around, only the window is measured and not their allocation
+    std::vector<std::unique_ptr<Packet>> packets;
+    for (int i = 0; i < NUM_IN_FLIGHT; ++i) {
+        packets.push_back(Packet::create());
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < NUM_IN_FLIGHT; ++i) {
+            window.add(firstSequenceNumber + i, std::move(packets[i]));
+        }
+
+        for (int i = 0; i < NUM_IN_FLIGHT; ++i) {
+            auto ack = firstSequenceNumber + i;
+            auto entry = window.find(ack);
+            if (i % RESEND_INTERVAL == 0) {
+                // the receiver lost it, it was looked up to be re-sent
+                ++entry->numResends;
+            }
+            packets[i] = std::move(entry->packet);
+            window.removeUpTo(ack);
+        }
+
+        firstSequenceNumber += NUM_IN_FLIGHT;
+    }
+}
+
+void SentPacketWindowTests::nakResendBenchmark() {
+    SentPacketWindow window;
+    for (int i = 0; i < NUM_IN_FLIGHT; ++i) {
+        window.add(SequenceNumber(i), Packet::create());
+    }
+
+    QBENCHMARK {
+        // every 10th packet NAKed, as SendQueue::fastRetransmit and the timeouts do
+        LossList naks;
+        for (int i = 0; i < NUM_IN_FLIGHT; i += RESEND_INTERVAL) {
+            naks.insert(SequenceNumber(i), SequenceNumber(i));
+        }
+
+        // and looked up to be re-sent, as in SendQueue::maybeResendPacket
+        while (!naks.isEmpty()) {
+            auto entry = window.find(naks.popFirstSequenceNumber());
+            if (entry) {
+                ++entry->numResends;
+            }
+        }
+    }
+}
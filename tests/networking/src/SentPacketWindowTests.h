@@ -0,0 +1,33 @@
+//
+//  SentPacketWindowTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketWindowTests_h
+#define hifi_SentPacketWindowTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SentPacketWindowTests : public QObject {
+    Q_OBJECT
+private slots:
+    void addFindTest();
+    void removeUpToTest();
+    void growthTest();
+    void rolloverTest();
+
+    // ACK processing with 10k packets in flight and every 10th one re-sent
+    void ackBenchmark();
+    // the look up of the NAKed packets to re-send, with 10k packets in flight and every 10th one lost
+    void nakResendBenchmark();
+};
+
+#endif // hifi_SentPacketWindowTests_h
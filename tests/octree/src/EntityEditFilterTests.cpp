@@ -0,0 +1,271 @@
+//
+//  EntityEditFilterTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditFilterTests.h"
+
+#include <random>
+
+#include <EntityEditFilters.h>
+#include <ResourceRequest.h>
+#include <SharedUtil.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(EntityEditFilterTests)
+
+const QString FILTER_URL = "http://localhost/filter";
+const float FILTER_TOLERANCE = 0.0001f;
+
+// hands the filter contents to EntityEditFilters as if they were just downloaded
+class FilterRequest : public ResourceRequest {
+public:
+    FilterRequest(const QByteArray& contents) : ResourceRequest(QUrl(FILTER_URL), IS_NOT_OBSERVABLE) { _data = contents; }
+
+protected:
+    void doSend() override {
+        _result = Success;
+        _state = Finished;
+        emit finished();
+    }
+};
+
+bool EntityEditFilterTests::loadFilter(EntityEditFilters& filters, const QByteArray& contents) {
+    bool wasAdded = false;
+    auto connection = connect(&filters, &EntityEditFilters::filterAdded, this, [&wasAdded](EntityItemID, bool success) {
+        wasAdded = success;
+    });
+
+    FilterRequest request(contents);
+    connect(&request, &ResourceRequest::finished, &filters, [&filters] {
+        filters.scriptRequestFinished(EntityItemID());
+    });
+    request.send();
+
+    disconnect(connection);
+    return wasAdded;
+}
+
+static bool runFilter(EntityEditFilters& filters, EntityItemProperties& properties, EntityTree::FilterType filterType,
+                      const QUuid& id, bool& wasChanged) {
+    glm::vec3 position = properties.getPosition();
+    EntityItemID entityID(id);
+    EntityItemPointer existingEntity;
+    wasChanged = false;
+    return filters.filter(position, properties, properties, wasChanged, filterType, entityID, existingEntity);
+}
+
+void EntityEditFilterTests::clampTest() {
+    EntityEditFilters filters;
+    QVERIFY(loadFilter(filters, R"({
+        "clamp": {
+            "dimensions": { "min": 0.1, "max": 10 },
+            "velocity": { "max": 5 },
+            "lifetime": { "max": 60 }
+        }
+    })"));
+
+    EntityItemProperties properties;
+    properties.setDimensions(glm::vec3(0.01f, 1.0f, 20.0f));
+    properties.setVelocity(glm::vec3(0.0f, 0.0f, 10.0f));
+    properties.setLifetime(ENTITY_ITEM_IMMORTAL_LIFETIME);
+    bool wasChanged;
+    QVERIFY(runFilter(filters, properties, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+    QVERIFY(wasChanged);
+    QCOMPARE_WITH_ABS_ERROR(properties.getDimensions(), glm::vec3(0.1f, 1.0f, 10.0f), FILTER_TOLERANCE);
+    QCOMPARE_WITH_ABS_ERROR(properties.getVelocity(), glm::vec3(0.0f, 0.0f, 5.0f), FILTER_TOLERANCE);
+    QCOMPARE(properties.getLifetime(), 60.0f);
+
+    // edits within the ranges go through untouched
+    EntityItemProperties withinRange;
+    withinRange.setVelocity(glm::vec3(1.0f, 0.0f, 0.0f));
+    QVERIFY(runFilter(filters, withinRange, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+    QVERIFY(!wasChanged);
+    QCOMPARE_WITH_ABS_ERROR(withinRange.getVelocity(), glm::vec3(1.0f, 0.0f, 0.0f), FILTER_TOLERANCE);
+}
+
+void EntityEditFilterTests::rejectPropertiesTest() {
+    EntityEditFilters filters;
+    QVERIFY(loadFilter(filters, R"({ "rejectProperties": [ "locked", "serverScripts" ] })"));
+
+    bool wasChanged;
+    EntityItemProperties locking;
+    locking.setLocked(true);
+    QVERIFY(!runFilter(filters, locking, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+
+    EntityItemProperties moving;
+    moving.setPosition(glm::vec3(1.0f));
+    QVERIFY(runFilter(filters, moving, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+}
+
+void EntityEditFilterTests::rejectFilterTypesTest() {
+    EntityEditFilters filters;
+    QVERIFY(loadFilter(filters, R"({ "wantsToFilterDelete": true, "rejectFilterTypes": [ "delete" ] })"));
+
+    bool wasChanged;
+    EntityItemProperties properties;
+    QVERIFY(!runFilter(filters, properties, EntityTree::FilterType::Delete, QUuid::createUuid(), wasChanged));
+    QVERIFY(runFilter(filters, properties, EntityTree::FilterType::Add, QUuid(), wasChanged));
+}
+
+void EntityEditFilterTests::rejectDeleteTest() {
+    // deletes are not filtered by default, rejecting them is enough to have them filtered
+    EntityEditFilters filters;
+    QVERIFY(loadFilter(filters, R"({ "rejectFilterTypes": [ "delete" ] })"));
+
+    bool wasChanged;
+    EntityItemProperties properties;
+    QVERIFY(!runFilter(filters, properties, EntityTree::FilterType::Delete, QUuid::createUuid(), wasChanged));
+    QVERIFY(runFilter(filters, properties, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+
+    // without it, deletes go through
+    EntityEditFilters defaultFilters;
+    QVERIFY(loadFilter(defaultFilters, R"({ "rejectProperties": [ "locked" ] })"));
+    QVERIFY(runFilter(defaultFilters, properties, EntityTree::FilterType::Delete, QUuid::createUuid(), wasChanged));
+}
+
+void EntityEditFilterTests::boundsTest() {
+    bool wasChanged;
+    {
+        EntityEditFilters filters;
+        QVERIFY(loadFilter(filters, R"({ "bounds": { "min": [ -10, -10, -10 ], "max": [ 10, 10, 10 ] } })"));
+
+        EntityItemProperties inside;
+        inside.setPosition(glm::vec3(5.0f));
+        QVERIFY(runFilter(filters, inside, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+
+        EntityItemProperties outside;
+        outside.setPosition(glm::vec3(20.0f, 0.0f, 0.0f));
+        QVERIFY(!runFilter(filters, outside, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+    }
+    {
+        EntityEditFilters filters;
+        QVERIFY(loadFilter(filters, R"({
+            "bounds": { "min": [ -10, -10, -10 ], "max": [ 10, 10, 10 ] },
+            "outOfBounds": "clamp"
+        })"));
+
+        EntityItemProperties outside;
+        outside.setPosition(glm::vec3(20.0f, 0.0f, -30.0f));
+        QVERIFY(runFilter(filters, outside, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+        QVERIFY(wasChanged);
+        QCOMPARE_WITH_ABS_ERROR(outside.getPosition(), glm::vec3(10.0f, 0.0f, -10.0f), FILTER_TOLERANCE);
+    }
+}
+
+void EntityEditFilterTests::rateLimitTest() {
+    EntityEditFilters filters;
+    QVERIFY(loadFilter(filters, R"({ "maxEditsPerSecond": 2 })"));
+
+    bool wasChanged;
+    QUuid busyEntity = QUuid::createUuid();
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(1.0f));
+    QVERIFY(runFilter(filters, properties, EntityTree::FilterType::Edit, busyEntity, wasChanged));
+    QVERIFY(runFilter(filters, properties, EntityTree::FilterType::Edit, busyEntity, wasChanged));
+    QVERIFY(!runFilter(filters, properties, EntityTree::FilterType::Edit, busyEntity, wasChanged));
+
+    // the limit is per entity
+    QVERIFY(runFilter(filters, properties, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+}
+
+void EntityEditFilterTests::malformedRulesTest() {
+    EntityEditFilters filters;
+    QVERIFY(loadFilter(filters, R"({ "rejectProperties": [ "noSuchProperty" ] })"));
+
+    // like a script without a filter function, malformed rules reject everything
+    bool wasChanged;
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(1.0f));
+    QVERIFY(!runFilter(filters, properties, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+}
+
+// the same clamping as script and as rules
+const char* CLAMP_VELOCITY_SCRIPT = R"(
+    function filter(properties, type) {
+        if (properties.velocity) {
+            var velocity = properties.velocity;
+            var speed = Math.sqrt(velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+            if (speed > 5) {
+                var scale = 5 / speed;
+                properties.velocity = { x: velocity.x * scale, y: velocity.y * scale, z: velocity.z * scale };
+            }
+        }
+        return properties;
+    }
+)";
+const char* CLAMP_VELOCITY_RULES = R"({ "clamp": { "velocity": { "max": 5 } } })";
+
+void EntityEditFilterTests::scriptFallbackTest() {
+    EntityEditFilters scriptFilters;
+    QVERIFY(loadFilter(scriptFilters, CLAMP_VELOCITY_SCRIPT));
+    EntityEditFilters ruleFilters;
+    QVERIFY(loadFilter(ruleFilters, CLAMP_VELOCITY_RULES));
+
+    bool wasChanged;
+    EntityItemProperties scriptProperties;
+    scriptProperties.setVelocity(glm::vec3(0.0f, 8.0f, 6.0f));
+    QVERIFY(runFilter(scriptFilters, scriptProperties, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+    QVERIFY(wasChanged);
+
+    EntityItemProperties ruleProperties;
+    ruleProperties.setVelocity(glm::vec3(0.0f, 8.0f, 6.0f));
+    QVERIFY(runFilter(ruleFilters, ruleProperties, EntityTree::FilterType::Edit, QUuid::createUuid(), wasChanged));
+    QVERIFY(wasChanged);
+
+    QCOMPARE_WITH_ABS_ERROR(ruleProperties.getVelocity(), glm::vec3(0.0f, 4.0f, 3.0f), FILTER_TOLERANCE);
+    QCOMPARE_WITH_ABS_ERROR(scriptProperties.getVelocity(), ruleProperties.getVelocity(), FILTER_TOLERANCE);
+}
+
+#ifdef MANUAL_TEST
+void EntityEditFilterTests::benchmark() {
+    // replay the same stream of physics edits through both kinds of filter
+    const int NUM_EDITS = 20000;
+    const int NUM_ENTITIES = 200;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    std::vector<QUuid> entityIDs;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entityIDs.push_back(QUuid::createUuid());
+    }
+    std::vector<std::pair<QUuid, EntityItemProperties>> edits;
+    for (int i = 0; i < NUM_EDITS; ++i) {
+        EntityItemProperties properties;
+        properties.setPosition(glm::vec3(distribution(generator), distribution(generator), distribution(generator)));
+        properties.setVelocity(glm::vec3(distribution(generator), distribution(generator), distribution(generator)));
+        properties.setRotation(glm::quat());
+        edits.emplace_back(entityIDs[i % NUM_ENTITIES], properties);
+    }
+
+    auto replay = [&](EntityEditFilters& filters) {
+        uint64_t start = usecTimestampNow();
+        int numAccepted = 0;
+        for (auto edit : edits) {
+            bool wasChanged;
+            if (runFilter(filters, edit.second, EntityTree::FilterType::Physics, edit.first, wasChanged)) {
+                ++numAccepted;
+            }
+        }
+        QCOMPARE(numAccepted, NUM_EDITS);
+        return usecTimestampNow() - start;
+    };
+
+    EntityEditFilters scriptFilters;
+    QVERIFY(loadFilter(scriptFilters, CLAMP_VELOCITY_SCRIPT));
+    uint64_t scriptTime = replay(scriptFilters);
+
+    EntityEditFilters ruleFilters;
+    QVERIFY(loadFilter(ruleFilters, CLAMP_VELOCITY_RULES));
+    uint64_t ruleTime = replay(ruleFilters);
+
+    qDebug() << NUM_EDITS << "edits: script filter" << scriptTime << "usecs, filter rules" << ruleTime << "usecs";
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,40 @@
+//
+//  EntityEditFilterTests.h
+//  tests/octree/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditFilterTests_h
+#define hifi_EntityEditFilterTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditFilters;
+
+//#define MANUAL_TEST
+
+class EntityEditFilterTests : public QObject {
+    Q_OBJECT
+private slots:
+    void clampTest();
+    void rejectPropertiesTest();
+    void rejectFilterTypesTest();
+    void rejectDeleteTest();
+    void boundsTest();
+    void rateLimitTest();
+    void malformedRulesTest();
+    void scriptFallbackTest();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+
+private:
+    bool loadFilter(EntityEditFilters& filters, const QByteArray& contents);
+};
+
+#endif // hifi_EntityEditFilterTests_h
@@ -0,0 +1,265 @@
+//
+//  EntityTreeBinaryTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBinaryTests.h"
+
+#include <limits>
+
+#include <QTemporaryDir>
+
+#include <EntityTree.h>
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <OctreeDataUtils.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(EntityTreeBinaryTests)
+
+const int NUM_ENTITIES = 10;
+const float ROTATION_TOLERANCE = 0.0001f;
+
+static EntityTreePointer createTree() {
+    auto tree = EntityTreePointer(new EntityTree(true));
+    tree->setIsClient(false);
+    tree->createRootElement();
+    return tree;
+}
+
+static EntityItemProperties createProperties(int i) {
+    EntityItemProperties properties;
+    properties.setType(i % 2 == 0 ? EntityTypes::Box : EntityTypes::Text);
+    properties.setName(QString("entity %1").arg(i));
+    properties.setPosition(glm::vec3(1.0f + i, 2.0f, -3.0f * i));
+    properties.setDimensions(glm::vec3(0.5f + 0.1f * i));
+    properties.setRotation(glm::angleAxis(0.3f * i, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))));
+    properties.setUserData(QString("{ \"index\": %1 }").arg(i));
+    return properties;
+}
+
+// a tree with a few entities, and their ids
+static EntityTreePointer createPopulatedTree(std::vector<EntityItemID>& entityIDs) {
+    auto tree = createTree();
+    tree->setOctreeVersionInfo(QUuid::createUuid(), 42);
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        EntityItemID entityID(QUuid::createUuid());
+        tree->withWriteLock([&] {
+            QVERIFY(tree->addEntity(entityID, createProperties(i)));
+        });
+        entityIDs.push_back(entityID);
+    }
+    return tree;
+}
+
+static int countEntities(const EntityTreePointer& tree, const std::vector<EntityItemID>& entityIDs) {
+    int numFound = 0;
+    for (const auto& entityID : entityIDs) {
+        if (tree->findEntityByEntityItemID(entityID)) {
+            ++numFound;
+        }
+    }
+    return numFound;
+}
+
+static void compareEntities(const EntityTreePointer& tree, const EntityTreePointer& readTree,
+                            const std::vector<EntityItemID>& entityIDs) {
+    QCOMPARE(readTree->getPersistID(), tree->getPersistID());
+    QCOMPARE(readTree->getPersistDataVersion(), tree->getPersistDataVersion());
+
+    for (const auto& entityID : entityIDs) {
+        auto entity = tree->findEntityByEntityItemID(entityID);
+        auto readEntity = readTree->findEntityByEntityItemID(entityID);
+        QVERIFY(readEntity);
+        QCOMPARE(readEntity->getType(), entity->getType());
+        QCOMPARE(readEntity->getName(), entity->getName());
+        QCOMPARE(readEntity->getUserData(), entity->getUserData());
+
+        // floats are stored as they are
+        QCOMPARE(readEntity->getWorldPosition(), entity->getWorldPosition());
+        QCOMPARE(readEntity->getScaledDimensions(), entity->getScaledDimensions());
+    }
+}
+
+void EntityTreeBinaryTests::initTestCase() {
+    // adding entities looks up the permissions of this node
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityTreeBinaryTests::roundTripTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QByteArray data;
+    QVERIFY(tree->writeToBinary(data, nullptr));
+
+    auto readTree = createTree();
+    QVERIFY(readTree->readFromBinary(reinterpret_cast<const unsigned char*>(data.constData()), data.size()));
+    QCOMPARE(countEntities(readTree, entityIDs), NUM_ENTITIES);
+    compareEntities(tree, readTree, entityIDs);
+}
+
+void EntityTreeBinaryTests::fileRoundTripTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString fileName = directory.filePath("models.bin");
+
+    QVERIFY(tree->writeToFile(fileName.toUtf8().constData(), nullptr, "bin"));
+    QVERIFY(QFileInfo(fileName).exists());
+
+    auto readTree = createTree();
+    QVERIFY(readTree->readFromFile(fileName.toUtf8().constData()));
+    QCOMPARE(countEntities(readTree, entityIDs), NUM_ENTITIES);
+    compareEntities(tree, readTree, entityIDs);
+}
+
+void EntityTreeBinaryTests::headerTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QByteArray data;
+    QVERIFY(tree->writeToBinary(data, nullptr));
+
+    OctreeUtils::BinaryOctreeHeader header;
+    QVERIFY(OctreeUtils::readBinaryOctreeHeader(reinterpret_cast<const unsigned char*>(data.constData()), data.size(),
+                                                header));
+    QCOMPARE(QByteArray(header.magic, sizeof(header.magic)), QByteArray("HFOB"));
+    QCOMPARE(header.formatVersion, OctreeUtils::BINARY_OCTREE_FORMAT_VERSION);
+    QCOMPARE(header.dataPacketVersion, (uint32_t)versionForPacketType(PacketType::EntityData));
+    QCOMPARE(header.numRecords, (uint32_t)NUM_ENTITIES);
+    QCOMPARE(header.getID(), tree->getPersistID());
+    QCOMPARE(header.dataVersion, (int64_t)tree->getPersistDataVersion());
+
+    // the persist thread only reads the header to tell the domain server what it has
+    OctreeUtils::RawOctreeData info;
+    QVERIFY(info.readOctreeDataInfoFromBinary(data.left(sizeof(header))));
+    QCOMPARE(info.id, tree->getPersistID());
+    QCOMPARE(info.dataVersion, (OctreeUtils::Version)tree->getPersistDataVersion());
+    QCOMPARE(info.version, (OctreeUtils::Version)versionForPacketType(PacketType::EntityData));
+
+    // anything else is not a binary octree
+    QByteArray notBinary = data;
+    notBinary[0] = '{';
+    QVERIFY(!OctreeUtils::readBinaryOctreeHeader(reinterpret_cast<const unsigned char*>(notBinary.constData()),
+                                                 notBinary.size(), header));
+    auto readTree = createTree();
+    QVERIFY(!readTree->readFromBinary(reinterpret_cast<const unsigned char*>(notBinary.constData()), notBinary.size()));
+    QCOMPARE(countEntities(readTree, entityIDs), 0);
+
+    // nor is what is too short to hold the header
+    QVERIFY(!readTree->readFromBinary(reinterpret_cast<const unsigned char*>(data.constData()), sizeof(header) - 1));
+    QCOMPARE(countEntities(readTree, entityIDs), 0);
+}
+
+void EntityTreeBinaryTests::versionMismatchTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QByteArray data;
+    QVERIFY(tree->writeToBinary(data, nullptr));
+
+    // a format this version doesn't know
+    {
+        QByteArray newerFormat = data;
+        OctreeUtils::BinaryOctreeHeader header;
+        memcpy(&header, newerFormat.constData(), sizeof(header));
+        header.formatVersion = OctreeUtils::BINARY_OCTREE_FORMAT_VERSION + 1;
+        memcpy(newerFormat.data(), &header, sizeof(header));
+
+        auto readTree = createTree();
+        QVERIFY(!readTree->readFromBinary(reinterpret_cast<const unsigned char*>(newerFormat.constData()),
+                                          newerFormat.size()));
+        QCOMPARE(countEntities(readTree, entityIDs), 0);
+    }
+
+    // entities written by another version of the edit packets, which only the JSON can convert
+    {
+        QByteArray olderEntities = data;
+        OctreeUtils::BinaryOctreeHeader header;
+        memcpy(&header, olderEntities.constData(), sizeof(header));
+        header.dataPacketVersion -= 1;
+        memcpy(olderEntities.data(), &header, sizeof(header));
+
+        auto readTree = createTree();
+        QVERIFY(!readTree->readFromBinary(reinterpret_cast<const unsigned char*>(olderEntities.constData()),
+                                          olderEntities.size()));
+        QCOMPARE(countEntities(readTree, entityIDs), 0);
+    }
+}
+
+void EntityTreeBinaryTests::truncatedTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QByteArray data;
+    QVERIFY(tree->writeToBinary(data, nullptr));
+
+    // cut in the middle of the last record, the records before it are still loaded
+    {
+        auto readTree = createTree();
+        QVERIFY(!readTree->readFromBinary(reinterpret_cast<const unsigned char*>(data.constData()), data.size() - 10));
+        QCOMPARE(countEntities(readTree, entityIDs), NUM_ENTITIES - 1);
+    }
+
+    // a record size that runs past the end of the file
+    {
+        QByteArray corrupt = data;
+        uint32_t recordSize = std::numeric_limits<uint32_t>::max() / 2;
+        memcpy(corrupt.data() + sizeof(OctreeUtils::BinaryOctreeHeader), &recordSize, sizeof(recordSize));
+
+        auto readTree = createTree();
+        QVERIFY(!readTree->readFromBinary(reinterpret_cast<const unsigned char*>(corrupt.constData()), corrupt.size()));
+        QCOMPARE(countEntities(readTree, entityIDs), 0);
+    }
+
+    // fewer records than the header says, the ones there are still loaded
+    {
+        QByteArray missingRecords = data;
+        OctreeUtils::BinaryOctreeHeader header;
+        memcpy(&header, missingRecords.constData(), sizeof(header));
+        header.numRecords += 1;
+        memcpy(missingRecords.data(), &header, sizeof(header));
+
+        auto readTree = createTree();
+        QVERIFY(!readTree->readFromBinary(reinterpret_cast<const unsigned char*>(missingRecords.constData()),
+                                          missingRecords.size()));
+        QCOMPARE(countEntities(readTree, entityIDs), NUM_ENTITIES);
+    }
+}
+
+void EntityTreeBinaryTests::quantizationTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QByteArray data;
+    QVERIFY(tree->writeToBinary(data, nullptr));
+    auto readTree = createTree();
+    QVERIFY(readTree->readFromBinary(reinterpret_cast<const unsigned char*>(data.constData()), data.size()));
+
+    // properties are stored at the precision of the edit packets, rotations are quantized as on the wire
+    for (const auto& entityID : entityIDs) {
+        auto entity = tree->findEntityByEntityItemID(entityID);
+        auto readEntity = readTree->findEntityByEntityItemID(entityID);
+        QVERIFY(readEntity);
+
+        unsigned char packed[sizeof(uint16_t) * 4];
+        packOrientationQuatToBytes(packed, entity->getLocalOrientation());
+        glm::quat quantized;
+        unpackOrientationQuatFromBytes(packed, quantized);
+
+        QCOMPARE_WITH_ABS_ERROR(readEntity->getLocalOrientation(), quantized, ROTATION_TOLERANCE);
+        QCOMPARE_WITH_ABS_ERROR(readEntity->getLocalOrientation(), entity->getLocalOrientation(), ROTATION_TOLERANCE);
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  EntityTreeBinaryTests.h
+//  tests/octree/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBinaryTests_h
+#define hifi_EntityTreeBinaryTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeBinaryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void roundTripTest();
+    void fileRoundTripTest();
+    void headerTest();
+    void versionMismatchTest();
+    void truncatedTest();
+    void quantizationTest();
+};
+
+#endif // hifi_EntityTreeBinaryTests_h
@@ -0,0 +1,122 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <QJsonObject>
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+// enough entities to be parsed on several threads, when there are several cores
+const int NUM_PARALLEL_ENTITIES = 4000;
+// few enough to be parsed on the calling thread only
+const int NUM_SERIAL_ENTITIES = 10;
+
+// Entities file with each entity spread over three lines, the first entity starts on line 4.
+// The entities listed in badEntities are missing a comma, which only the JSON parser notices.
+static QByteArray createEntitiesFile(int numEntities, const QVector<int>& badEntities = QVector<int>()) {
+    QByteArray contents = "{\n    \"DataVersion\": 3,\n    \"Entities\": [\n";
+    for (int i = 0; i < numEntities; ++i) {
+        QByteArray separator = badEntities.contains(i) ? " " : ", ";
+        contents += "        { \"name\": \"entity " + QByteArray::number(i) + "\"" + separator +
+            "\"userData\": \"{ \\\"braces\\\": \\\"}}\\\" }\",\n";
+        contents += "          \"position\": { \"x\": " + QByteArray::number(i) + ", \"y\": 0, \"z\": 0 },\n";
+        contents += "          \"locked\": false }";
+        contents += (i + 1 < numEntities) ? ",\n" : "\n";
+    }
+    contents += "    ],\n    \"Id\": \"{5a2f8ad2-1d52-4b6e-9c48-9a0c5e4b3c11}\",\n    \"Version\": 7\n}\n";
+    return contents;
+}
+
+static int entityLine(int index) {
+    const int FIRST_ENTITY_LINE = 4;
+    const int LINES_PER_ENTITY = 3;
+    return FIRST_ENTITY_LINE + index * LINES_PER_ENTITY;
+}
+
+static void verifyEntities(const QVariantMap& parsed, int numEntities) {
+    QCOMPARE(parsed["DataVersion"].toInt(), 3);
+    QCOMPARE(parsed["Version"].toInt(), 7);
+    QCOMPARE(parsed["Id"].toUuid(), QUuid("{5a2f8ad2-1d52-4b6e-9c48-9a0c5e4b3c11}"));
+
+    auto entities = parsed["Entities"].toList();
+    QCOMPARE(entities.size(), numEntities);
+    for (int i = 0; i < numEntities; ++i) {
+        auto entity = entities[i].toJsonObject();
+        QCOMPARE(entity["name"].toString(), QString("entity %1").arg(i));
+        QCOMPARE(entity["userData"].toString(), QString("{ \"braces\": \"}}\" }"));
+        QCOMPARE(entity["position"].toObject()["x"].toInt(), i);
+    }
+}
+
+void OctreeEntitiesFileParserTests::entityOrderTest() {
+    // the entities are parsed in parallel, but come out in file order
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(createEntitiesFile(NUM_PARALLEL_ENTITIES));
+    QVariantMap parsed;
+    QVERIFY(parser.parseEntities(parsed));
+    QVERIFY(parser.getErrorString().empty());
+    verifyEntities(parsed, NUM_PARALLEL_ENTITIES);
+}
+
+void OctreeEntitiesFileParserTests::errorLineTest() {
+    const int BAD_ENTITY = 3210;
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(createEntitiesFile(NUM_PARALLEL_ENTITIES, { BAD_ENTITY }));
+    QVariantMap parsed;
+    QVERIFY(!parser.parseEntities(parsed));
+
+    // the lines of the entities before it are counted, even though they are skipped over
+    auto error = QString::fromStdString(parser.getErrorString());
+    QVERIFY2(error.startsWith(QString("Error: Line %1,").arg(entityLine(BAD_ENTITY))), qPrintable(error));
+    QVERIFY2(error.endsWith("Ill-formed entity"), qPrintable(error));
+}
+
+void OctreeEntitiesFileParserTests::firstErrorTest() {
+    // whichever thread gets to them first, the error is the first one in the file
+    const QVector<int> BAD_ENTITIES = { NUM_PARALLEL_ENTITIES - 1, 2000, 1234 };
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(createEntitiesFile(NUM_PARALLEL_ENTITIES, BAD_ENTITIES));
+    QVariantMap parsed;
+    QVERIFY(!parser.parseEntities(parsed));
+
+    auto error = QString::fromStdString(parser.getErrorString());
+    QVERIFY2(error.startsWith(QString("Error: Line %1,").arg(entityLine(1234))), qPrintable(error));
+}
+
+void OctreeEntitiesFileParserTests::singleThreadTest() {
+    // too few entities to be worth another thread, they are parsed on the calling one
+    {
+        OctreeEntitiesFileParser parser;
+        parser.setEntitiesString(createEntitiesFile(NUM_SERIAL_ENTITIES));
+        QVariantMap parsed;
+        QVERIFY(parser.parseEntities(parsed));
+        verifyEntities(parsed, NUM_SERIAL_ENTITIES);
+    }
+    {
+        OctreeEntitiesFileParser parser;
+        parser.setEntitiesString(createEntitiesFile(NUM_SERIAL_ENTITIES, { 7 }));
+        QVariantMap parsed;
+        QVERIFY(!parser.parseEntities(parsed));
+        auto error = QString::fromStdString(parser.getErrorString());
+        QVERIFY2(error.startsWith(QString("Error: Line %1,").arg(entityLine(7))), qPrintable(error));
+    }
+    {
+        // a single entity
+        OctreeEntitiesFileParser parser;
+        parser.setEntitiesString(createEntitiesFile(1));
+        QVariantMap parsed;
+        QVERIFY(parser.parseEntities(parsed));
+        verifyEntities(parsed, 1);
+    }
+}
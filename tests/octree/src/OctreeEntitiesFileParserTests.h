@@ -0,0 +1,26 @@
+//
+//  OctreeEntitiesFileParserTests.h
+//  tests/octree/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEntitiesFileParserTests_h
+#define hifi_OctreeEntitiesFileParserTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeEntitiesFileParserTests : public QObject {
+    Q_OBJECT
+private slots:
+    void entityOrderTest();
+    void errorLineTest();
+    void firstErrorTest();
+    void singleThreadTest();
+};
+
+#endif // hifi_OctreeEntitiesFileParserTests_h
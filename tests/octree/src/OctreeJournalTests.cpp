@@ -0,0 +1,277 @@
+//
+//  OctreeJournalTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournalTests.h"
+
+#include <QTemporaryDir>
+
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreeDataUtils.h>
+#include <OctreePersistThread.h>
+
+QTEST_MAIN(OctreeJournalTests)
+
+const int NUM_ENTITIES = 10;
+
+static EntityTreePointer createTree() {
+    auto tree = EntityTreePointer(new EntityTree(true));
+    tree->setIsClient(false);
+    tree->createRootElement();
+    return tree;
+}
+
+static EntityItemProperties createProperties(int i) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setName(QString("entity %1").arg(i));
+    properties.setPosition(glm::vec3(1.0f + i, 2.0f, -3.0f * i));
+    properties.setDimensions(glm::vec3(0.5f));
+    return properties;
+}
+
+static EntityTreePointer createPopulatedTree(std::vector<EntityItemID>& entityIDs) {
+    auto tree = createTree();
+    tree->setOctreeVersionInfo(QUuid::createUuid(), 42);
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        EntityItemID entityID(QUuid::createUuid());
+        tree->withWriteLock([&] {
+            QVERIFY(tree->addEntity(entityID, createProperties(i)));
+        });
+        entityIDs.push_back(entityID);
+    }
+    return tree;
+}
+
+// the tree the persist thread would load before replaying the journal
+static EntityTreePointer loadSnapshot(const QString& fileName) {
+    auto tree = createTree();
+    tree->withWriteLock([&] {
+        QVERIFY(tree->readFromFile(fileName.toLocal8Bit().constData()));
+    });
+    return tree;
+}
+
+static void renameEntity(const EntityTreePointer& tree, const EntityItemID& entityID, const QString& name) {
+    EntityItemProperties properties;
+    properties.setName(name);
+    tree->withWriteLock([&] {
+        QVERIFY(tree->updateEntity(entityID, properties));
+    });
+}
+
+static QString getEntityName(const EntityTreePointer& tree, const EntityItemID& entityID) {
+    auto entity = tree->findEntityByEntityItemID(entityID);
+    return entity ? entity->getName() : QString();
+}
+
+static void writeFile(const QString& fileName, const QByteArray& data) {
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(data), (qint64)data.size());
+}
+
+static QByteArray readFile(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void OctreeJournalTests::initTestCase() {
+    // adding entities looks up the permissions of this node
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void OctreeJournalTests::roundTripTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    OctreePersistThread persister(tree, directory.filePath("models.bin"), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                  false, "bin", true);
+    persister.writeSnapshot();
+    QVERIFY(QFileInfo(persister.getPersistFilename()).exists());
+    QVERIFY(tree->startJournal());
+
+    // an edit, a delete and an add, in separate persists
+    renameEntity(tree, entityIDs[0], "edited");
+    QVERIFY(persister.appendToJournal());
+    tree->withWriteLock([&] {
+        tree->deleteEntity(entityIDs[1], true);
+    });
+    EntityItemID addedID(QUuid::createUuid());
+    tree->withWriteLock([&] {
+        QVERIFY(tree->addEntity(addedID, createProperties(NUM_ENTITIES)));
+    });
+    QVERIFY(persister.appendToJournal());
+    QVERIFY(QFileInfo(persister.getJournalFilename()).exists());
+
+    // nothing changed, nothing is journaled
+    qint64 journalSize = QFileInfo(persister.getJournalFilename()).size();
+    QVERIFY(persister.appendToJournal());
+    QCOMPARE(QFileInfo(persister.getJournalFilename()).size(), journalSize);
+
+    auto readTree = loadSnapshot(persister.getPersistFilename());
+    QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("entity 0"));
+    QVERIFY(readTree->findEntityByEntityItemID(entityIDs[1]));
+    QVERIFY(!readTree->findEntityByEntityItemID(addedID));
+
+    OctreePersistThread replayer(readTree, persister.getPersistFilename(), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                 false, "bin", true);
+    QVERIFY(replayer.replayJournal());
+    QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("edited"));
+    QVERIFY(!readTree->findEntityByEntityItemID(entityIDs[1]));
+    QCOMPARE(getEntityName(readTree, addedID), QString("entity %1").arg(NUM_ENTITIES));
+    for (int i = 2; i < NUM_ENTITIES; ++i) {
+        QCOMPARE(getEntityName(readTree, entityIDs[i]), QString("entity %1").arg(i));
+    }
+}
+
+void OctreeJournalTests::tornBlockTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString fileName = directory.filePath("models.bin");
+    QString journalFileName;
+    {
+        OctreePersistThread persister(tree, fileName, OctreePersistThread::DEFAULT_PERSIST_INTERVAL, false, "bin", true);
+        persister.writeSnapshot();
+        QVERIFY(tree->startJournal());
+
+        renameEntity(tree, entityIDs[0], "first");
+        QVERIFY(persister.appendToJournal());
+        renameEntity(tree, entityIDs[2], "second");
+        QVERIFY(persister.appendToJournal());
+
+        fileName = persister.getPersistFilename();
+        journalFileName = persister.getJournalFilename();
+    }
+    QByteArray journal = readFile(journalFileName);
+    QVERIFY(!journal.isEmpty());
+
+    // the last persist cut short by a crash, and one whose records don't match their checksum
+    QByteArray truncated = journal.left(journal.size() - 5);
+    QByteArray corrupt = journal;
+    corrupt[corrupt.size() - 1] = corrupt[corrupt.size() - 1] ^ 0xff;
+
+    for (const auto& badJournal : { truncated, corrupt }) {
+        writeFile(journalFileName, badJournal);
+
+        // the blocks before the bad one are still replayed
+        auto readTree = loadSnapshot(fileName);
+        OctreePersistThread replayer(readTree, fileName, OctreePersistThread::DEFAULT_PERSIST_INTERVAL, false, "bin", true);
+        QVERIFY(replayer.replayJournal());
+        QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("first"));
+        QCOMPARE(getEntityName(readTree, entityIDs[2]), QString("entity 2"));
+    }
+
+    // a journal cut within its first block has nothing to replay
+    writeFile(journalFileName, journal.left(sizeof(OctreeUtils::OctreeJournalHeader) + 2));
+    auto readTree = loadSnapshot(fileName);
+    OctreePersistThread replayer(readTree, fileName, OctreePersistThread::DEFAULT_PERSIST_INTERVAL, false, "bin", true);
+    QVERIFY(!replayer.replayJournal());
+    QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("entity 0"));
+}
+
+void OctreeJournalTests::snapshotMismatchTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    OctreePersistThread persister(tree, directory.filePath("models.bin"), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                  false, "bin", true);
+    persister.writeSnapshot();
+    QVERIFY(tree->startJournal());
+
+    renameEntity(tree, entityIDs[0], "journaled");
+    QVERIFY(persister.appendToJournal());
+
+    // a newer snapshot written without removing the journal, as when the server stops while compacting
+    renameEntity(tree, entityIDs[0], "snapshot");
+    tree->incrementPersistDataVersion();
+    QVERIFY(tree->writeToFile(persister.getPersistFilename().toLocal8Bit().constData(), nullptr, "bin"));
+    QVERIFY(QFileInfo(persister.getJournalFilename()).exists());
+
+    {
+        auto readTree = loadSnapshot(persister.getPersistFilename());
+        OctreePersistThread replayer(readTree, persister.getPersistFilename(), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                     false, "bin", true);
+        QVERIFY(!replayer.replayJournal());
+        QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("snapshot"));
+    }
+
+    // a snapshot of another tree with the data version of the journal
+    {
+        auto readTree = loadSnapshot(persister.getPersistFilename());
+        readTree->setOctreeVersionInfo(QUuid::createUuid(), tree->getPersistDataVersion() - 1);
+        OctreePersistThread replayer(readTree, persister.getPersistFilename(), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                     false, "bin", true);
+        QVERIFY(!replayer.replayJournal());
+        QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("snapshot"));
+    }
+
+    // anything that isn't a journal
+    writeFile(persister.getJournalFilename(), QByteArray("not a journal"));
+    auto readTree = loadSnapshot(persister.getPersistFilename());
+    OctreePersistThread replayer(readTree, persister.getPersistFilename(), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                 false, "bin", true);
+    QVERIFY(!replayer.replayJournal());
+    QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("snapshot"));
+}
+
+void OctreeJournalTests::compactionTest() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createPopulatedTree(entityIDs);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    OctreePersistThread persister(tree, directory.filePath("models.bin"), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                  false, "bin", true);
+    persister.writeSnapshot();
+    QVERIFY(tree->startJournal());
+
+    renameEntity(tree, entityIDs[0], "journaled");
+    QVERIFY(persister.appendToJournal());
+    QVERIFY(!persister.needsCompaction());
+
+    // the journal is compacted once the snapshot is old enough
+    persister._lastSnapshot -= std::chrono::hours(1);
+    QVERIFY(persister.needsCompaction());
+
+    int dataVersion = tree->getPersistDataVersion();
+    persister.writeSnapshot();
+    QVERIFY(!QFileInfo(persister.getJournalFilename()).exists());
+    QCOMPARE(tree->getPersistDataVersion(), dataVersion + 1);
+    QVERIFY(!persister.needsCompaction());
+
+    {
+        auto readTree = loadSnapshot(persister.getPersistFilename());
+        QCOMPARE(readTree->getPersistDataVersion(), dataVersion + 1);
+        QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("journaled"));
+    }
+
+    // the next journal starts from the new snapshot
+    renameEntity(tree, entityIDs[0], "after compaction");
+    QVERIFY(persister.appendToJournal());
+
+    auto readTree = loadSnapshot(persister.getPersistFilename());
+    OctreePersistThread replayer(readTree, persister.getPersistFilename(), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                 false, "bin", true);
+    QVERIFY(replayer.replayJournal());
+    QCOMPARE(getEntityName(readTree, entityIDs[0]), QString("after compaction"));
+}
@@ -0,0 +1,231 @@
+//
+//  PrioritySortUtilTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtilTests.h"
+
+#include <random>
+#include <set>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <NumericalConstants.h>
+#include <PrioritySortUtil.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(PrioritySortUtilTests)
+
+class SortableThing : public PrioritySortUtil::Sortable {
+public:
+    SortableThing(const glm::vec3& position, float radius, uint64_t timestamp, int id) :
+        _position(position), _radius(radius), _timestamp(timestamp), _id(id) {}
+
+    glm::vec3 getPosition() const override { return _position; }
+    float getRadius() const override { return _radius; }
+    uint64_t getTimestamp() const override { return _timestamp; }
+    int getID() const { return _id; }
+
+private:
+    glm::vec3 _position;
+    float _radius;
+    uint64_t _timestamp;
+    int _id;
+};
+
+static ConicalViewFrustums makeViews() {
+    ViewFrustum viewFrustum;
+    viewFrustum.setPosition(glm::vec3(5.0f, 1.0f, -3.0f));
+    viewFrustum.setOrientation(glm::angleAxis(PI_OVER_TWO, glm::vec3(0.0f, 1.0f, 0.0f)));
+    viewFrustum.setProjection(90.0f, 16.0f / 9.0f, 0.1f, 200.0f);
+    viewFrustum.calculate();
+
+    // the default view looks down +z from the origin
+    return { ConicalViewFrustum(), ConicalViewFrustum(viewFrustum) };
+}
+
+static std::vector<SortableThing> makeThings(int numThings, uint64_t now) {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 2.0f);
+    std::uniform_int_distribution<uint64_t> age(0, 3 * USECS_PER_SECOND);
+
+    std::vector<SortableThing> things;
+    for (int i = 0; i < numThings; ++i) {
+        glm::vec3 thingPosition(position(generator), position(generator), position(generator));
+        things.emplace_back(thingPosition, radius(generator), now - age(generator), i);
+    }
+    return things;
+}
+
+// the per thing priority, as computed before batching
+static float referencePriority(const ConicalViewFrustums& views, const glm::vec3& position, float thingRadius, float age) {
+    float priority = std::numeric_limits<float>::min();
+    for (const auto& view : views) {
+        glm::vec3 offset = position - view.getPosition();
+        float distance = glm::length(offset) + 0.001f;
+        float radius = glm::max(thingRadius, 0.1f);
+        float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+        if (cosineAngle > 0.0f) {
+            cosineAngle = std::sqrt(cosineAngle);
+        }
+        float angularSize = radius / distance;
+        float viewPriority = (PrioritySortUtil::DEFAULT_ANGULAR_COEF * angularSize +
+                              PrioritySortUtil::DEFAULT_CENTER_COEF * cosineAngle) * (age + 1.0f) +
+                             PrioritySortUtil::DEFAULT_AGE_COEF * age;
+        if (distance - radius > view.getRadius() && !view.intersects(offset, distance, radius)) {
+            viewPriority += PrioritySortUtil::OUT_OF_VIEW_PENALTY;
+        }
+        priority = std::max(priority, viewPriority);
+    }
+    return priority;
+}
+
+void PrioritySortUtilTests::computePrioritiesTest() {
+    const float EPSILON = 1.0e-5f;
+    auto views = makeViews();
+
+    // odd sizes exercise the remainder of the batches
+    for (int numThings : { 0, 1, 3, 4, 7, 64, 1001 }) {
+        auto things = makeThings(numThings, 0);
+        PrioritySortUtil::SortableData data;
+        data.resize(numThings);
+        for (int i = 0; i < numThings; ++i) {
+            data.set(i, things[i].getPosition(), things[i].getRadius(), (float)(i % 5));
+        }
+
+        std::vector<float> priorities(numThings);
+        PrioritySortUtil::computePriorities(views, PrioritySortUtil::DEFAULT_ANGULAR_COEF, PrioritySortUtil::DEFAULT_CENTER_COEF,
+                                            PrioritySortUtil::DEFAULT_AGE_COEF, data, priorities.data());
+
+        for (int i = 0; i < numThings; ++i) {
+            float expected = referencePriority(views, things[i].getPosition(), things[i].getRadius(), (float)(i % 5));
+            QVERIFY(fabsf(priorities[i] - expected) <= EPSILON * std::max(1.0f, fabsf(expected)));
+        }
+    }
+}
+
+void PrioritySortUtilTests::sortTest() {
+    const int NUM_THINGS = 500;
+    uint64_t now = usecTimestampNow();
+    auto things = makeThings(NUM_THINGS, now);
+
+    PrioritySortUtil::PriorityQueue<SortableThing> queue(makeViews(), PrioritySortUtil::DEFAULT_ANGULAR_COEF,
+                                                         PrioritySortUtil::DEFAULT_CENTER_COEF, PrioritySortUtil::DEFAULT_AGE_COEF);
+    for (const auto& thing : things) {
+        queue.push(thing);
+    }
+
+    const auto& sorted = queue.getSortedVector();
+    QCOMPARE((int)sorted.size(), NUM_THINGS);
+    for (int i = 1; i < NUM_THINGS; ++i) {
+        QVERIFY(sorted[i - 1].getPriority() >= sorted[i].getPriority());
+    }
+}
+
+void PrioritySortUtilTests::partialSortTest() {
+    const int NUM_THINGS = 500;
+    const int NUM_TO_SORT = 37;
+    uint64_t now = usecTimestampNow();
+    auto things = makeThings(NUM_THINGS, now);
+
+    PrioritySortUtil::PriorityQueue<SortableThing> queue(makeViews(), PrioritySortUtil::DEFAULT_ANGULAR_COEF,
+                                                         PrioritySortUtil::DEFAULT_CENTER_COEF, PrioritySortUtil::DEFAULT_AGE_COEF);
+    for (const auto& thing : things) {
+        queue.push(thing);
+    }
+
+    // the first things are in order, and ahead of all the others
+    const auto& sorted = queue.getSortedVector(NUM_TO_SORT);
+    QCOMPARE((int)sorted.size(), NUM_THINGS);
+    for (int i = 1; i < NUM_TO_SORT; ++i) {
+        QVERIFY(sorted[i - 1].getPriority() >= sorted[i].getPriority());
+    }
+    for (int i = NUM_TO_SORT; i < NUM_THINGS; ++i) {
+        QVERIFY(sorted[NUM_TO_SORT - 1].getPriority() >= sorted[i].getPriority());
+    }
+}
+
+void PrioritySortUtilTests::reuseTest() {
+    const int NUM_THINGS = 200;
+    uint64_t now = usecTimestampNow();
+    auto things = makeThings(NUM_THINGS, now);
+    auto views = makeViews();
+
+    PrioritySortUtil::PriorityQueue<SortableThing> queue;
+    for (int pass = 0; pass < 3; ++pass) {
+        // fewer things on each pass, the stale ones must not come back
+        int numThings = NUM_THINGS >> pass;
+
+        queue.clear();
+        queue.setViews(views);
+        queue.setWeights(PrioritySortUtil::DEFAULT_ANGULAR_COEF, PrioritySortUtil::DEFAULT_CENTER_COEF,
+                         PrioritySortUtil::DEFAULT_AGE_COEF);
+        for (int i = 0; i < numThings; ++i) {
+            queue.push(things[i]);
+        }
+
+        const auto& sorted = queue.getSortedVector();
+        QCOMPARE((int)sorted.size(), numThings);
+        std::set<int> ids;
+        for (int i = 0; i < numThings; ++i) {
+            QVERIFY(i == 0 || sorted[i - 1].getPriority() >= sorted[i].getPriority());
+            QVERIFY(sorted[i].getID() < numThings);
+            ids.insert(sorted[i].getID());
+        }
+        QCOMPARE((int)ids.size(), numThings);
+    }
+}
+
+#ifdef MANUAL_TEST
+void PrioritySortUtilTests::benchmark() {
+    const int NUM_DESTINATIONS = 1000;
+    const int thingCounts[] = { 50, 200, 1000 };
+    uint64_t now = usecTimestampNow();
+    auto views = makeViews();
+
+    for (int numThings : thingCounts) {
+        auto things = makeThings(numThings, now);
+        int numToSort = numThings / 10;
+
+        // a queue per destination, the way the mixers sorted before
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_DESTINATIONS; ++i) {
+            PrioritySortUtil::PriorityQueue<SortableThing> queue(views, PrioritySortUtil::DEFAULT_ANGULAR_COEF,
+                                                                 PrioritySortUtil::DEFAULT_CENTER_COEF,
+                                                                 PrioritySortUtil::DEFAULT_AGE_COEF);
+            queue.reserve(things.size());
+            for (const auto& thing : things) {
+                queue.push(thing);
+            }
+            queue.getSortedVector(numToSort);
+        }
+        uint64_t freshTime = usecTimestampNow() - start;
+
+        PrioritySortUtil::PriorityQueue<SortableThing> queue;
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_DESTINATIONS; ++i) {
+            queue.clear();
+            queue.setViews(views);
+            queue.setWeights(PrioritySortUtil::DEFAULT_ANGULAR_COEF, PrioritySortUtil::DEFAULT_CENTER_COEF,
+                             PrioritySortUtil::DEFAULT_AGE_COEF);
+            for (const auto& thing : things) {
+                queue.push(thing);
+            }
+            queue.getSortedVector(numToSort);
+        }
+        uint64_t reusedTime = usecTimestampNow() - start;
+
+        qDebug() << "things =" << numThings
+                 << "fresh usec/destination =" << (float)freshTime / NUM_DESTINATIONS
+                 << "reused usec/destination =" << (float)reusedTime / NUM_DESTINATIONS;
+    }
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,31 @@
+//
+//  PrioritySortUtilTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PrioritySortUtilTests_h
+#define hifi_PrioritySortUtilTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class PrioritySortUtilTests : public QObject {
+    Q_OBJECT
+private slots:
+    void computePrioritiesTest();
+    void sortTest();
+    void partialSortTest();
+    void reuseTest();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PrioritySortUtilTests_h
@@ -0,0 +1,156 @@
+//
+//  SPSCQueueTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SPSCQueueTests.h"
+
+#include <memory>
+#include <thread>
+
+#include <SPSCQueue.h>
+
+QTEST_MAIN(SPSCQueueTests)
+
+void SPSCQueueTests::capacityTest() {
+    QCOMPARE((int)SPSCQueue<int>(1).capacity(), 1);
+    QCOMPARE((int)SPSCQueue<int>(100).capacity(), 128);
+    QCOMPARE((int)SPSCQueue<int>(256).capacity(), 256);
+}
+
+void SPSCQueueTests::fullQueueTest() {
+    SPSCQueue<std::shared_ptr<int>> queue(4);
+
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(queue.push(std::make_shared<int>(i)));
+    }
+    QCOMPARE((int)queue.size(), 4);
+
+    // a failed push leaves the item to the caller
+    auto item = std::make_shared<int>(4);
+    QVERIFY(!queue.push(std::move(item)));
+    QVERIFY(item);
+    QCOMPARE(*item, 4);
+
+    // items come out in order, and the queue accepts more once they do
+    std::shared_ptr<int> popped;
+    QVERIFY(queue.pop(popped));
+    QCOMPARE(*popped, 0);
+    QVERIFY(queue.push(std::move(item)));
+
+    for (int i = 1; i <= 4; ++i) {
+        QVERIFY(queue.pop(popped));
+        QCOMPARE(*popped, i);
+    }
+    QVERIFY(!queue.pop(popped));
+    QVERIFY(queue.empty());
+}
+
+void SPSCQueueTests::concurrentTest() {
+    const int NUM_ITEMS = 100000;
+    SPSCQueue<int> queue(64);
+
+    // QTest macros are not thread-safe, count the errors and check them on this thread
+    int numOutOfOrder = 0;
+    std::thread consumer([&] {
+        int expected = 0;
+        int item;
+        while (expected < NUM_ITEMS) {
+            if (queue.pop(item)) {
+                if (item != expected) {
+                    ++numOutOfOrder;
+                }
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        while (!queue.push(i)) {
+            std::this_thread::yield();
+        }
+    }
+
+    consumer.join();
+    QCOMPARE(numOutOfOrder, 0);
+    QVERIFY(queue.empty());
+}
+
+void SPSCQueueTests::overflowTest() {
+    OverflowingSPSCQueue<int> queue(2);
+
+    QVERIFY(queue.push(0, true));
+    QVERIFY(queue.push(1, false));
+
+    // the queue is full, droppable items are dropped and the others overflow
+    QVERIFY(!queue.push(2, true));
+    QVERIFY(queue.push(3, false));
+    QVERIFY(queue.push(4, false));
+    QCOMPARE((int)queue.numOverflowing(), 2);
+
+    // nothing goes ahead of the overflow, even once the queue has room
+    int popped;
+    QVERIFY(queue.pop(popped));
+    QCOMPARE(popped, 0);
+    QVERIFY(!queue.push(5, true));
+    QVERIFY(queue.push(6, false));
+
+    int expected[] = { 1, 3, 4, 6 };
+    for (int value : expected) {
+        QVERIFY(queue.pop(popped));
+        QCOMPARE(popped, value);
+    }
+    QVERIFY(!queue.pop(popped));
+    QCOMPARE((int)queue.numOverflowing(), 0);
+
+    // back to the bounded queue once the overflow is drained
+    QVERIFY(queue.push(7, true));
+    QVERIFY(queue.pop(popped));
+    QCOMPARE(popped, 7);
+}
+
+void SPSCQueueTests::concurrentOverflowTest() {
+    const int NUM_ITEMS = 100000;
+    OverflowingSPSCQueue<int> queue(16);
+
+    // odd items can be dropped, even ones must all come out and in order
+    int numOutOfOrder = 0;
+    int numEvenPopped = 0;
+    std::thread consumer([&] {
+        int last = -1;
+        int item;
+        while (numEvenPopped < NUM_ITEMS / 2) {
+            if (queue.pop(item)) {
+                if (item <= last) {
+                    ++numOutOfOrder;
+                }
+                last = item;
+                if (item % 2 == 0) {
+                    ++numEvenPopped;
+                }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int numDropped = 0;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        if (!queue.push(i, i % 2 == 1)) {
+            ++numDropped;
+        }
+    }
+
+    consumer.join();
+    QCOMPARE(numOutOfOrder, 0);
+    QCOMPARE(numEvenPopped, NUM_ITEMS / 2);
+    QVERIFY(numDropped <= NUM_ITEMS / 2);
+}
@@ -0,0 +1,27 @@
+//
+//  SPSCQueueTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SPSCQueueTests_h
+#define hifi_SPSCQueueTests_h
+
+#include <QtTest/QtTest>
+
+class SPSCQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    void capacityTest();
+    void fullQueueTest();
+    void concurrentTest();
+    void overflowTest();
+    void concurrentOverflowTest();
+};
+
+#endif // hifi_SPSCQueueTests_h
@@ -0,0 +1,146 @@
+//
+//  LinkSimulator.cpp
+//  tools/udt-test/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LinkSimulator.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+
+using namespace std::chrono;
+
+static const int BITS_PER_BYTE = 8;
+static const int64_t NSECS_PER_SECOND = 1000000000;
+
+LinkSimulator::LinkSimulator(const HifiSockAddr& target, const Parameters& parameters) :
+    _parameters(parameters),
+    _target(target),
+    _socket(new QUdpSocket(this)),
+    _sendTimer(new QTimer(this))
+{
+    _socket->bind(QHostAddress::LocalHost, 0);
+    _sockAddr = HifiSockAddr(QHostAddress::LocalHost, _socket->localPort());
+
+    _towardsTarget.bandwidth = _parameters.bandwidth;
+
+    _sendTimer->setSingleShot(true);
+    _sendTimer->setTimerType(Qt::PreciseTimer);
+
+    connect(_socket, &QUdpSocket::readyRead, this, &LinkSimulator::readPendingDatagrams);
+    connect(_sendTimer, &QTimer::timeout, this, &LinkSimulator::sendDueDatagrams);
+
+    qDebug() << "Simulating a link to" << _target << "on" << _sockAddr << "-"
+        << _parameters.lossRate * 100.0 << "% loss," << _parameters.latency << "ms latency,"
+        << _parameters.jitter << "ms jitter," << _parameters.bandwidth << "bps bottleneck";
+}
+
+LinkSimulator::~LinkSimulator() {
+    _thread.quit();
+    _thread.wait();
+
+    qDebug() << "Simulated link lost" << _numLostDatagrams << "datagrams and dropped"
+        << _numOverflowedDatagrams << "at its bottleneck";
+}
+
+void LinkSimulator::start() {
+    _thread.setObjectName("Link Simulator");
+    moveToThread(&_thread);
+    _thread.start();
+}
+
+void LinkSimulator::readPendingDatagrams() {
+    while (_socket->hasPendingDatagrams()) {
+        QByteArray datagram(_socket->pendingDatagramSize(), 0);
+        HifiSockAddr senderSockAddr;
+
+        _socket->readDatagram(datagram.data(), datagram.size(),
+                              senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
+
+        if (senderSockAddr == _target) {
+            if (!_source.isNull()) {
+                transmit(_towardsSource, datagram, _source);
+            }
+        } else {
+            if (_source.isNull()) {
+                _source = senderSockAddr;
+            }
+            transmit(_towardsTarget, datagram, _target);
+        }
+    }
+}
+
+void LinkSimulator::transmit(Direction& direction, QByteArray datagram, const HifiSockAddr& destination) {
+    if (_distribution(_generator) < _parameters.lossRate) {
+        ++_numLostDatagrams;
+        return;
+    }
+
+    auto now = Clock::now();
+    auto departureTime = now;
+
+    if (direction.bandwidth > 0) {
+        // the datagram waits for the ones already at the bottleneck to go through
+        auto startTime = std::max(now, direction.bottleneckFreeTime);
+        if (startTime - now > milliseconds(_parameters.maxQueueingDelay)) {
+            ++_numOverflowedDatagrams;
+            return;
+        }
+
+        auto transmissionTime = nanoseconds(datagram.size() * BITS_PER_BYTE * NSECS_PER_SECOND / direction.bandwidth);
+        direction.bottleneckFreeTime = startTime + transmissionTime;
+        departureTime = direction.bottleneckFreeTime;
+    }
+
+    auto dueTime = departureTime + milliseconds(_parameters.latency);
+    if (_parameters.jitter > 0) {
+        dueTime += microseconds((int64_t)(_distribution(_generator) * _parameters.jitter * 1000));
+    }
+
+    if (!direction.datagrams.empty()) {
+        dueTime = std::max(dueTime, direction.datagrams.back().dueTime);
+    }
+
+    direction.datagrams.push_back({ datagram, destination, dueTime });
+
+    scheduleNextSend();
+}
+
+void LinkSimulator::sendDueDatagrams() {
+    auto now = Clock::now();
+
+    for (auto direction : { &_towardsTarget, &_towardsSource }) {
+        while (!direction->datagrams.empty() && direction->datagrams.front().dueTime <= now) {
+            auto& datagram = direction->datagrams.front();
+            _socket->writeDatagram(datagram.data, datagram.destination.getAddress(), datagram.destination.getPort());
+            direction->datagrams.pop_front();
+        }
+    }
+
+    scheduleNextSend();
+}
+
+void LinkSimulator::scheduleNextSend() {
+    Clock::time_point nextDueTime = Clock::time_point::max();
+
+    for (auto direction : { &_towardsTarget, &_towardsSource }) {
+        if (!direction->datagrams.empty()) {
+            nextDueTime = std::min(nextDueTime, direction->datagrams.front().dueTime);
+        }
+    }
+
+    if (nextDueTime == Clock::time_point::max()) {
+        return;
+    }
+
+    // round up, the timer would otherwise fire again and again until the datagram is due
+    auto timeout = duration_cast<microseconds>(nextDueTime - Clock::now()).count();
+    _sendTimer->start(std::max((int)((timeout + 999) / 1000), 0));
+}
@@ -0,0 +1,91 @@
+//
+//  LinkSimulator.h
+//  tools/udt-test/src
+//
+//  Created by agent on 2026/10/16.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LinkSimulator_h
+#define hifi_LinkSimulator_h
+
+#include <chrono>
+#include <deque>
+#include <random>
+
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <HifiSockAddr.h>
+
+// Relays datagrams between a local sender and its target through a simulated link with loss, latency and a
+// bottleneck, so that congestion controls can be compared offline without netem or a real lossy network.
+class LinkSimulator : public QObject {
+    Q_OBJECT
+public:
+    struct Parameters {
+        double lossRate { 0.0 }; // probability for a datagram to be dropped, in each direction
+        int latency { 0 }; // one-way delay, in milliseconds
+        int jitter { 0 }; // maximum random extra one-way delay, in milliseconds
+        int bandwidth { 0 }; // bottleneck towards the target, in bits per second - zero for none
+        int maxQueueingDelay { 100 }; // datagrams that would wait longer at the bottleneck are dropped, in milliseconds
+    };
+
+    LinkSimulator(const HifiSockAddr& target, const Parameters& parameters);
+    ~LinkSimulator();
+
+    // the address to send to instead of the target
+    HifiSockAddr getSockAddr() const { return _sockAddr; }
+
+    // runs the link on its own thread
+    void start();
+
+private slots:
+    void readPendingDatagrams();
+    void sendDueDatagrams();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Datagram {
+        QByteArray data;
+        HifiSockAddr destination;
+        Clock::time_point dueTime;
+    };
+
+    struct Direction {
+        std::deque<Datagram> datagrams; // in due time order, the link does not re-order
+        Clock::time_point bottleneckFreeTime; // when the bottleneck is done with the queued datagrams
+        int bandwidth { 0 };
+    };
+
+    void transmit(Direction& direction, QByteArray datagram, const HifiSockAddr& destination);
+    void scheduleNextSend();
+
+    Parameters _parameters;
+    HifiSockAddr _target;
+    HifiSockAddr _source; // the sender, learnt from its first datagram
+    HifiSockAddr _sockAddr;
+
+    QUdpSocket* _socket { nullptr };
+    QTimer* _sendTimer { nullptr };
+    QThread _thread;
+
+    Direction _towardsTarget;
+    Direction _towardsSource;
+
+    std::mt19937 _generator { std::random_device()() };
+    std::uniform_real_distribution<double> _distribution { 0.0, 1.0 };
+
+    int _numLostDatagrams { 0 };
+    int _numOverflowedDatagrams { 0 };
+};
+
+#endif // hifi_LinkSimulator_h
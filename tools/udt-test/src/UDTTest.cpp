@@ -13,9 +13,11 @@
 
 #include <QtCore/QDebug>
 
+#include <udt/BBRCC.h>
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
+#include <udt/TCPVegasCC.h>
 
 #include <LogHandler.h>
 
@@ -55,6 +57,24 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control for the connection, vegas or bbr (default is vegas)", "name"
+};
+const QCommandLineOption SIMULATED_LOSS {
+    "simulated-loss", "percentage of packets lost on a simulated link to the target", "percent"
+};
+const QCommandLineOption SIMULATED_LATENCY {
+    "simulated-latency", "one-way latency of a simulated link to the target", "milliseconds"
+};
+const QCommandLineOption SIMULATED_JITTER {
+    "simulated-jitter", "maximum random extra one-way latency of a simulated link to the target", "milliseconds"
+};
+const QCommandLineOption SIMULATED_BANDWIDTH {
+    "simulated-bandwidth", "bottleneck bandwidth of a simulated link to the target", "megabits per second"
+};
+const QCommandLineOption SIMULATED_QUEUE {
+    "simulated-queue", "maximum queueing delay at the bottleneck of a simulated link (default is 100ms)", "milliseconds"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -166,6 +186,45 @@ UDTTest::UDTTest(int& argc, char** argv) :
     
     // seed the generator with a value that the receiver will also use when verifying the ordered message
     _generator.seed(messageSeed);
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        QString congestionControl = _argumentParser.value(CONGESTION_CONTROL).toLower();
+
+        if (congestionControl == "bbr") {
+            _socket.setCongestionControlFactory(
+                std::unique_ptr<udt::CongestionControlVirtualFactory>(new udt::CongestionControlFactory<udt::BBRCC>()));
+        } else if (congestionControl == "vegas") {
+            _socket.setCongestionControlFactory(
+                std::unique_ptr<udt::CongestionControlVirtualFactory>(new udt::CongestionControlFactory<udt::TCPVegasCC>()));
+        } else {
+            qCritical() << "Unknown congestion control" << congestionControl << "- use vegas or bbr.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    }
+
+    bool shouldSimulateLink = _argumentParser.isSet(SIMULATED_LOSS) || _argumentParser.isSet(SIMULATED_LATENCY)
+        || _argumentParser.isSet(SIMULATED_JITTER) || _argumentParser.isSet(SIMULATED_BANDWIDTH);
+
+    if (shouldSimulateLink && !_target.isNull()) {
+        static const double BITS_PER_MEGABIT = 1000000.0;
+
+        LinkSimulator::Parameters parameters;
+        parameters.lossRate = _argumentParser.value(SIMULATED_LOSS).toDouble() / 100.0;
+        parameters.latency = _argumentParser.value(SIMULATED_LATENCY).toInt();
+        parameters.jitter = _argumentParser.value(SIMULATED_JITTER).toInt();
+        parameters.bandwidth = (int)(_argumentParser.value(SIMULATED_BANDWIDTH).toDouble() * BITS_PER_MEGABIT);
+
+        if (_argumentParser.isSet(SIMULATED_QUEUE)) {
+            parameters.maxQueueingDelay = _argumentParser.value(SIMULATED_QUEUE).toInt();
+        }
+
+        // send through the simulated link rather than straight to the target
+        _linkSimulator.reset(new LinkSimulator(_target, parameters));
+        _linkSimulator->start();
+        _target = _linkSimulator->getSockAddr();
+    } else if (shouldSimulateLink) {
+        qWarning() << "A simulated link needs a target - the simulated-* options will be ignored";
+    }
     
     if (!_target.isNull()) {
         sendInitialPackets();
@@ -224,7 +283,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONGESTION_CONTROL,
+        SIMULATED_LOSS, SIMULATED_LATENCY, SIMULATED_JITTER, SIMULATED_BANDWIDTH, SIMULATED_QUEUE
     });
     
     if (!_argumentParser.parse(arguments())) {
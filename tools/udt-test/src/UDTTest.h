@@ -25,6 +25,8 @@
 
 #include <ReceivedMessage.h>
 
+#include "LinkSimulator.h"
+
 struct Message {
     udt::MessageNumber messageNumber;
     QByteArray data;
@@ -50,6 +52,7 @@ private:
     udt::Socket _socket;
     
     HifiSockAddr _target; // the target for sent packets
+    std::unique_ptr<LinkSimulator> _linkSimulator; // relays the sent packets through a simulated link, if any
     
     int _minPacketSize { udt::MAX_PACKET_SIZE };
     int _maxPacketSize { udt::MAX_PACKET_SIZE };